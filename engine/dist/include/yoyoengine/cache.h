@@ -60,6 +60,8 @@
 #include <jansson.h>
 #include "uthash/uthash.h"
 
+#include <yoyoengine/glyph_atlas.h>
+
 /**
  * @brief Pre-caches a scene.
  * 
@@ -107,6 +109,13 @@ YE_API void ye_clear_color_cache();
  */
 YE_API int ye_get_cache_texture_count();
 
+/**
+ * @brief Get the number of texture atlas pages in cache.
+ * 
+ * @return The count of atlas pages.
+ */
+YE_API int ye_get_cache_atlas_page_count();
+
 /**
  * @brief Get the number of fonts in cache.
  * 
@@ -121,6 +130,18 @@ YE_API int ye_get_cache_font_count();
  */
 YE_API int ye_get_cache_color_count();
 
+/**
+ * @brief Get the number of text layouts in cache (including ones nothing holds right now).
+ * 
+ * @return The count of cached text layouts.
+ */
+YE_API int ye_get_cache_text_count();
+
+/**
+ * @brief Clears the text layout cache. Layouts still held by renderers stay alive until they are released.
+ */
+YE_API void ye_clear_text_cache();
+
 /**
  * @brief Initializes the caches.
  * 
@@ -140,16 +161,36 @@ YE_API void ye_shutdown_cache();
  */
 struct ye_texture_node {
     SDL_Texture *texture; /**< The cached texture. */
-    char *path; /**< The path to the texture. */
+    const char *path; /**< The path to the texture (interned). */
     UT_hash_handle hh; /**< The hash handle. */
 };
 
+/**
+ * @brief Largest image (in either dimension) that will be packed into a texture atlas page. Bigger images get their own texture.
+ */
+#define YE_ATLAS_MAX_SPRITE 256
+
+/**
+ * @brief Width and height of a texture atlas page.
+ */
+#define YE_ATLAS_PAGE_SIZE 2048
+
+/**
+ * @brief Where an image lives on the GPU: a texture (possibly a shared atlas page) and the part of it holding the image.
+ */
+struct ye_image_region {
+    SDL_Texture *texture;   /**< The texture holding the image, shared with other images if it is an atlas page. */
+    SDL_FRect uv;           /**< Normalized sub-rectangle of texture holding the image ({0,0,1,1} for a standalone texture). */
+    int w;                  /**< Width of the image in pixels. */
+    int h;                  /**< Height of the image in pixels. */
+};
+
 /**
  * @brief A node for a cached font.
  */
 struct ye_font_node {
     TTF_Font *font;     /**< The cached font. */
-    char *name;         /**< The name of the font. */
+    const char *name;   /**< The name of the font (interned). */
     int size;           /**< The current size of the font. */
     UT_hash_handle hh;  /**< The hash handle. */
 };
@@ -159,7 +200,7 @@ struct ye_font_node {
  */
 struct ye_color_node {
     SDL_Color color; /**< The cached color. */
-    char *name; /**< The name of the color. */
+    const char *name; /**< The name of the color (interned). */
     UT_hash_handle hh; /**< The hash handle. */
 };
 
@@ -183,6 +224,20 @@ struct ye_color_node {
  */
 YE_API SDL_Texture * ye_image(const char *path);
 
+/**
+ * @brief Returns where a cached image lives, packing it into a shared atlas page if it is small enough.
+ * 
+ * Small images (icons, tiles, ui sprites) are packed lazily into YE_ATLAS_PAGE_SIZE pages, so sprites drawn
+ * from many different files can still be batched into one draw call. Images larger than YE_ATLAS_MAX_SPRITE
+ * get a standalone texture (the same one ye_image would return) with a full uv.
+ * 
+ * @param path The path to the image.
+ * @return The region holding the image. Valid until the texture cache is cleared.
+ * 
+ * @note The renderer uses this for image, animation and tilemap renderers. Use ye_image if you need a texture that holds only your image.
+ */
+YE_API struct ye_image_region ye_image_atlased(const char *path);
+
 /**
  * @brief Returns the pointer to a cached font based on name and size, returning a fallback default font if not found.
  * @param name The name of the font.
@@ -197,6 +252,20 @@ YE_API TTF_Font * ye_font(const char *name, int size);
  */
 YE_API SDL_Color * ye_color(const char *name);
 
+/**
+ * @brief Returns a laid out string, shared with everything else showing the same text with the same font, size, outline and wrap.
+ * 
+ * Layouts nothing holds anymore are kept around for reuse, the least recently used of them are dropped once the
+ * cache grows past its limit. Colors are not part of the layout (glyphs are tinted when painted).
+ * 
+ * @param text The UTF-8 text.
+ * @param font The font, at the size to lay out at.
+ * @param outline If >0, the width of the outline laid out behind the text.
+ * @param wrap_width If >0, the width (in pixels) to wrap lines at.
+ * @return The layout, release it with ye_text_layout_release when done. NULL on failure.
+ */
+YE_API struct ye_text_layout * ye_text(const char *text, TTF_Font *font, int outline, int wrap_width);
+
 /** @} */ // end of CacheAPI
 
 /**
@@ -268,4 +337,61 @@ YE_API void ye_destroy_color(const char *name);
 
 /** @} */ // end of CacheLowLevel
 
+/**
+ * @defgroup TextureState Texture State
+ * @brief Remembers the scale and blend mode of engine created textures, so SDL is only told when they actually change.
+ * 
+ * Every texture the engine creates (cached images, atlas pages, text) is tracked here with the scale mode
+ * matching YE_STATE.engine.sdl_quality_hint. Changing the hint through ye_set_quality_hint re-applies it to
+ * every tracked texture in one pass, so the renderer never has to set it per frame.
+ * 
+ * @note If you destroy a tracked texture yourself, call ye_untrack_texture_state first.
+ * @{
+ */
+
+/**
+ * @brief The SDL scale mode matching YE_STATE.engine.sdl_quality_hint.
+ */
+YE_API SDL_ScaleMode ye_quality_scale_mode();
+
+/**
+ * @brief Start tracking a texture, applying the given blend mode and the current quality scale mode to it. NULL is ignored.
+ * @param texture The texture to track.
+ * @param blend The blend mode the texture should use.
+ */
+YE_API void ye_track_texture_state(SDL_Texture *texture, SDL_BlendMode blend);
+
+/**
+ * @brief Stop tracking a texture. Must be called before a tracked texture is destroyed.
+ * @param texture The texture to forget.
+ */
+YE_API void ye_untrack_texture_state(SDL_Texture *texture);
+
+/**
+ * @brief Set the scale mode of a texture, skipping the SDL call if a tracked texture already has it.
+ * @param texture The texture.
+ * @param mode The scale mode.
+ */
+YE_API void ye_texture_set_scale_mode(SDL_Texture *texture, SDL_ScaleMode mode);
+
+/**
+ * @brief Set the blend mode of a texture, skipping the SDL call if a tracked texture already has it.
+ * @param texture The texture.
+ * @param mode The blend mode.
+ */
+YE_API void ye_texture_set_blend_mode(SDL_Texture *texture, SDL_BlendMode mode);
+
+/**
+ * @brief Change YE_STATE.engine.sdl_quality_hint and re-apply the matching scale mode to every tracked texture.
+ * @param hint 0 (nearest), 1 (linear), 2 (best, currently linear).
+ */
+YE_API void ye_set_quality_hint(int hint);
+
+/**
+ * @brief Returns the number of textures whose state is being tracked.
+ */
+YE_API int ye_get_tracked_texture_count();
+
+/** @} */ // end of TextureState
+
 #endif
\ No newline at end of file
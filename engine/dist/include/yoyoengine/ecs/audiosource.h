@@ -26,7 +26,7 @@ struct ye_component_audiosource {
 
     bool simulated;         // whether or not the audio source is simulated (if it is, it will be affected by the audio listener)
 
-    char *handle;           // the resource handle of the audio source
+    const char *handle;     // the resource handle of the audio source (interned)
     float volume;           // the volume of the audio source (scaled against the engine volume as a ceiling)
     
     // controls the position - the only thing you can set in this is width which updates height as well
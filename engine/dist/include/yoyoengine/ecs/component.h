@@ -0,0 +1,125 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+/**
+ * @file component.h
+ * @brief Custom (game defined) component types
+ *
+ * Game code can register its own component types at runtime. Each type keeps
+ * all of its components packed in one dense array, with an O(1) lookup from
+ * entity to component. Custom types get a signature bit like the builtin ones,
+ * so they work with ye_query_begin and the system scheduler masks.
+ *
+ * Ex:
+ * struct health { int hp; int max_hp; };
+ * int HEALTH = ye_register_component_type("health", sizeof(struct health), NULL, NULL);
+ *
+ * struct health *h = ye_add_component(entity, HEALTH);
+ * h->hp = h->max_hp = 100;
+ *
+ * struct ye_query q = ye_query_begin(YE_SIG_TRANSFORM | YE_COMPONENT_BIT(HEALTH));
+ *
+ * @warning Components move when another component of the same type is removed,
+ * don't hold on to pointers across adds/removes of that type (hold the entity instead).
+ */
+
+#ifndef YE_COMPONENT_H
+#define YE_COMPONENT_H
+
+#include <yoyoengine/export.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <yoyoengine/ecs/ecs.h>
+
+/**
+ * @brief Total component types (builtin + custom), limited by the bits in ye_entity::signature.
+ */
+#define YE_MAX_COMPONENT_TYPES 64
+
+/**
+ * @brief Register a custom component type.
+ *
+ * Registering a name that already exists with the same size returns the existing type.
+ *
+ * @param name Unique name of the component type.
+ * @param size sizeof the component struct.
+ * @param ctor Called after a (zeroed) component is added, can be NULL.
+ * @param dtor Called before a component is removed, can be NULL.
+ * @return int The type id (>= YE_COMPONENT_COUNT), or -1 on failure.
+ */
+YE_API int ye_register_component_type(const char *name, size_t size, void (*ctor)(struct ye_entity *entity, void *component), void (*dtor)(struct ye_entity *entity, void *component));
+
+/**
+ * @brief Look up a custom component type by name.
+ *
+ * @return int The type id, or -1 if no type has that name.
+ */
+YE_API int ye_get_component_type(const char *name);
+
+/**
+ * @brief Get the name a custom component type was registered with.
+ */
+YE_API const char * ye_get_component_type_name(int type);
+
+/**
+ * @brief Add a custom component to an entity.
+ *
+ * @param entity The entity to add the component to.
+ * @param type The type id from ye_register_component_type.
+ * @return void* The new zeroed (then constructed) component, or NULL on failure.
+ */
+YE_API void * ye_add_component(struct ye_entity *entity, int type);
+
+/**
+ * @brief Remove a custom component from an entity.
+ */
+YE_API void ye_remove_component(struct ye_entity *entity, int type);
+
+/**
+ * @brief Get an entity's custom component.
+ *
+ * @return void* The component, or NULL if the entity doesn't have one.
+ */
+YE_API void * ye_get_component(struct ye_entity *entity, int type);
+
+/**
+ * @brief Returns true if the entity has a component of this type (builtin or custom).
+ */
+YE_API bool ye_has_component(struct ye_entity *entity, int type);
+
+/**
+ * @brief Get the dense array of every component of a type, parallel to ye_get_component_entities.
+ *
+ * @param type The type id.
+ * @param count Out: number of components.
+ * @return void* The first component, step by ye_get_component_stride(type) bytes.
+ */
+YE_API void * ye_get_component_array(int type, int *count);
+
+/**
+ * @brief Get the byte distance between components in ye_get_component_array.
+ */
+YE_API size_t ye_get_component_stride(int type);
+
+/**
+ * @brief Get the entities owning each component of a type, parallel to ye_get_component_array.
+ */
+YE_API struct ye_entity ** ye_get_component_entities(int type, int *count);
+
+/**
+ * @brief Remove every custom component from an entity. Called when an entity is destroyed.
+ */
+YE_API void ye_remove_custom_components(struct ye_entity *entity);
+
+/**
+ * @brief Free every custom component type. Called by the engine on shutdown.
+ */
+YE_API void ye_shutdown_component_types(void);
+
+#endif // YE_COMPONENT_H
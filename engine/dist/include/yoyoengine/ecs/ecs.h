@@ -16,84 +16,131 @@
 #include <yoyoengine/export.h>
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include <yoyoengine/types.h>
 
+/**
+ * @brief A collection of enums that define the different types of components.
+ */
+enum ye_component_type {
+    YE_COMPONENT_TRANSFORM,
+    YE_COMPONENT_RENDERER,
+    YE_COMPONENT_RIGIDBODY,
+    YE_COMPONENT_AUDIOSOURCE,
+    YE_COMPONENT_CAMERA,
+    YE_COMPONENT_TAG,
+    YE_COMPONENT_BUTTON,
+
+    YE_COMPONENT_COUNT  // not a component, number of builtin component types
+};
+
+/**
+ * @brief The signature bit for a component type (see ye_entity::signature). OR these together to build a query mask.
+ */
+#define YE_COMPONENT_BIT(type) ((uint64_t)1 << (type))
+
+#define YE_SIG_TRANSFORM    YE_COMPONENT_BIT(YE_COMPONENT_TRANSFORM)
+#define YE_SIG_RENDERER     YE_COMPONENT_BIT(YE_COMPONENT_RENDERER)
+#define YE_SIG_RIGIDBODY    YE_COMPONENT_BIT(YE_COMPONENT_RIGIDBODY)
+#define YE_SIG_AUDIOSOURCE  YE_COMPONENT_BIT(YE_COMPONENT_AUDIOSOURCE)
+#define YE_SIG_CAMERA       YE_COMPONENT_BIT(YE_COMPONENT_CAMERA)
+#define YE_SIG_TAG          YE_COMPONENT_BIT(YE_COMPONENT_TAG)
+#define YE_SIG_BUTTON       YE_COMPONENT_BIT(YE_COMPONENT_BUTTON)
+
 /*
     =============================================================
-                        ENTITY LISTS
+                        ENTITY SETS
     =============================================================
 */
 
-// lists the ECS acts upon
-YE_API extern struct ye_entity_node *entity_list_head;
-YE_API extern struct ye_entity_node *transform_list_head;
-YE_API extern struct ye_entity_node *renderer_list_head;
-YE_API extern struct ye_entity_node *camera_list_head;
-YE_API extern struct ye_entity_node *tag_list_head;
-YE_API extern struct ye_entity_node *audiosource_list_head;
-YE_API extern struct ye_entity_node *button_list_head;
-YE_API extern struct ye_entity_node *rigidbody_list_head;
-
 /**
- * @brief Linked list structure for storing entities
+ * @brief Packed (sparse set) storage of entities.
+ * 
+ * Every component type owns one of these, plus one holding every entity.
+ * The dense arrays are what systems iterate, so there are no nodes to chase.
+ * Each entity remembers its index into every set it lives in, making add and
+ * remove O(1). Removal swaps the last entity into the hole, so sets are unordered
+ * (the renderer set included, draw order lives in the render queue).
+ * 
+ * @note The arrays are reallocated as they grow, do not hold onto pointers into them.
  */
-struct ye_entity_node {
-    struct ye_entity *entity;
-    struct ye_entity_node *next;
+struct ye_entity_set {
+    struct ye_entity **entities;    ///< dense array of entities in the set
+    void **components;              ///< dense array of the matching component for each entity (NULL for the entity set)
+    int count;                      ///< number of entities in the set
+    int capacity;                   ///< allocated length of the dense arrays
+    int slot;                       ///< which index in ye_entity::_set_index this set uses
 };
 
+// sets the ECS acts upon
+YE_API extern struct ye_entity_set entity_set;
+YE_API extern struct ye_entity_set component_sets[YE_COMPONENT_COUNT];
+
+/**
+ * @brief Invalidate every cached query. Call after changing an entity's signature outside the entity sets (custom components do this for you).
+ */
+YE_API void ye_ecs_structure_changed(void);
+
 /**
- * @brief Get the head of the entity list
+ * @brief Get the set containing every entity
  * 
- * @return struct ye_entity_node* 
+ * @return struct ye_entity_set* 
  */
-YE_API struct ye_entity_node * ye_get_entity_list_head();
+YE_API struct ye_entity_set * ye_get_entity_set(void);
 
 /**
- * @brief Add an entity to a list
+ * @brief Get the set of entities that have a given component
  * 
- * @param list The list to add the entity to
+ * @param type The component type
+ * @return struct ye_entity_set* 
+ */
+YE_API struct ye_entity_set * ye_get_component_set(enum ye_component_type type);
+
+/**
+ * @brief Add an entity to a set
+ * 
+ * @param set The set to add the entity to
  * @param entity The entity to add
+ * @param component The component stored alongside the entity (can be NULL)
  */
-YE_API void ye_entity_list_add(struct ye_entity_node **list, struct ye_entity *entity);
+YE_API void ye_entity_set_add(struct ye_entity_set *set, struct ye_entity *entity, void *component);
 
 /**
- * @brief Add an entity to a list sorted by its Z transform value (used for rendering order)
+ * @brief Add an entity to the renderer set. Paint order is kept by the render queue (see ye_set_renderer_z), which is re-sorted before the next paint.
  * 
- * @param list The list to add the entity to
  * @param entity The entity to add
  */
-YE_API void ye_entity_list_add_sorted_renderer_z(struct ye_entity_node **list, struct ye_entity *entity);
+YE_API void ye_entity_set_add_sorted_renderer_z(struct ye_entity *entity);
 
 /**
- * @brief Re-sort the list of renderer entities by their Z value
+ * @brief Re-sort the renderers by their Z value. The sort is deferred to the next paint, so calling this is cheap.
  */
 YE_API void ye_sort_renderer_entity_list_by_z(void);
 
 /**
- * @brief Remove an entity from a list
+ * @brief Remove an entity from a set
  * 
- * @param list The list to remove the entity from
+ * @param set The set to remove the entity from
  * @param entity The entity to remove
  * 
  * @note THIS DOES NOT FREE THE ACTUAL ENTITY ITSELF
- * 
- * This is temporarialy ok because we dont delete any at runtime but TODO
- * we need a method of this that does call the destructor for the entity
- * probably ye_entity_list_remove_free?
- * Not sure how to differentiate when this needs called though... just for actual list of entities?
+ * @note Swaps the last entity into the hole, so do not remove while iterating forwards.
  */
-YE_API void ye_entity_list_remove(struct ye_entity_node **list, struct ye_entity *entity);
+YE_API void ye_entity_set_remove(struct ye_entity_set *set, struct ye_entity *entity);
 
 /**
  * @brief Entity structure. An entity is a collection of components that make up a game object.
  */
+struct ye_text_layout; // see glyph_atlas.h
+
 struct ye_entity {
     bool active;        // controls whether system will act upon this entity and its components
 
-    int id;             // unique id for this entity
-    char *name;         // name that can also be used to access the entity
+    int id;             // id of this entity (its slot in the entity table, recycled after destroy)
+    uint32_t _generation; // generation of the slot when this entity was created, see ye_entity_handle
+    const char *name;   // name that can also be used to access the entity, interned (change it with ye_rename_entity)
+    struct ye_text_layout *_name_label; // editor name label (display_names), laid out when first shown and dropped on rename
 
     struct ye_component_transform *transform;       // transform component
     struct ye_component_renderer *renderer;         // renderer component
@@ -102,14 +149,119 @@ struct ye_entity {
     struct ye_component_tag *tag;                   // tag component
     struct ye_component_audiosource *audiosource;   // audiosource component
     struct ye_component_rigidbody *rigidbody;       // rigidbody component
+
+    uint64_t signature;                             // bitmask of the components this entity has (YE_COMPONENT_BIT)
+    int _set_index[YE_COMPONENT_COUNT + 1];         // index into each ye_entity_set this entity is in (-1 if not)
 };
 
+/*
+    =============================================================
+                            QUERIES
+    =============================================================
+*/
+
+struct ye_query_cache; // internal
+
+/**
+ * @brief An iterator over every entity that has (at least) a set of components.
+ * 
+ * Ex:
+ * struct ye_query q = ye_query_begin(YE_SIG_TRANSFORM | YE_SIG_RIGIDBODY);
+ * struct ye_entity *ent;
+ * while((ent = ye_query_next(&q)) != NULL) { ... }
+ * 
+ * The list of matches for each mask is cached, and only rebuilt after a component
+ * is added or removed somewhere. Do not add/remove components or destroy entities
+ * while iterating, use the deferred versions (ye_destroy_entity_deferred, etc) instead.
+ * If the ECS changes mid iteration, ye_query_next stops early and logs a warning.
+ */
+struct ye_query {
+    uint64_t mask;              ///< components every visited entity has
+    struct ye_query_cache *_cache;
+    int _index;
+    unsigned int _version;
+};
+
+/**
+ * @brief Start iterating every entity whose signature contains mask
+ * 
+ * @param mask OR'd YE_COMPONENT_BIT / YE_SIG_* values. 0 matches every entity.
+ * @return struct ye_query 
+ */
+YE_API struct ye_query ye_query_begin(uint64_t mask);
+
+/**
+ * @brief Get the next entity matching a query
+ * 
+ * @param query The query from ye_query_begin
+ * @return struct ye_entity* The next entity, NULL when done
+ */
+YE_API struct ye_entity * ye_query_next(struct ye_query *query);
+
+/**
+ * @brief Get how many entities a query will visit
+ * 
+ * @param query The query from ye_query_begin
+ * @return int 
+ */
+YE_API int ye_query_count(struct ye_query *query);
+
+/**
+ * @brief Returns true if an entity has every component in mask
+ * 
+ * @param entity The entity to check
+ * @param mask OR'd YE_COMPONENT_BIT / YE_SIG_* values
+ */
+YE_API bool ye_entity_has_components(struct ye_entity *entity, uint64_t mask);
+
 /*
     =============================================================
                         ENTITY MANIPULATION
     =============================================================
 */
 
+/**
+ * @brief A weak reference to an entity which can be safely held across frames.
+ * 
+ * Entity ids are slots in a table that get reused after an entity is destroyed,
+ * so a handle also records the generation of the slot. Once the entity is destroyed
+ * the generation moves on and the handle stops resolving, instead of dangling like
+ * a raw struct ye_entity pointer would.
+ */
+struct ye_entity_handle {
+    int id;                 ///< slot of the entity
+    uint32_t generation;    ///< generation of the slot when the handle was made
+};
+
+/**
+ * @brief A handle that never resolves to an entity
+ */
+#define YE_ENTITY_HANDLE_NULL ((struct ye_entity_handle){-1, 0})
+
+/**
+ * @brief Get a handle to an entity
+ * 
+ * @param entity The entity
+ * @return struct ye_entity_handle The handle, or YE_ENTITY_HANDLE_NULL if entity is NULL
+ */
+YE_API struct ye_entity_handle ye_get_entity_handle(struct ye_entity *entity);
+
+/**
+ * @brief Resolve a handle back into an entity
+ * 
+ * @param handle The handle
+ * @return struct ye_entity* The entity, or NULL if it has been destroyed
+ */
+YE_API struct ye_entity * ye_get_entity_from_handle(struct ye_entity_handle handle);
+
+/**
+ * @brief Check if a handle still refers to a living entity
+ * 
+ * @param handle The handle
+ * @return true if the entity still exists
+ */
+YE_API bool ye_entity_handle_valid(struct ye_entity_handle handle);
+
 /**
  * @brief Create a new entity and return a pointer to it
  * 
@@ -149,13 +301,48 @@ YE_API struct ye_entity * ye_duplicate_entity(struct ye_entity *entity);
 YE_API void ye_destroy_entity(struct ye_entity * entity);
 
 /**
- * @brief Find entity by name, returns pointer to first entity of specified name, NULL if not found
+ * @brief Queue an entity to be destroyed when the frame's deferred commands are flushed.
+ * 
+ * Safe to call from callbacks (collisions, timers, ye_for_matching_tag, etc) while
+ * the engine is iterating entities. Queuing the same entity twice is harmless.
+ * 
+ * @param entity The entity to destroy
+ */
+YE_API void ye_destroy_entity_deferred(struct ye_entity * entity);
+
+/**
+ * @brief Queue a component to be removed from an entity when the frame's deferred commands are flushed.
+ * 
+ * @param entity The entity to remove the component from
+ * @param type The type of component to remove (builtin, or a custom type from ye_register_component_type)
+ */
+YE_API void ye_remove_component_deferred(struct ye_entity * entity, enum ye_component_type type);
+
+/**
+ * @brief Apply every queued deferred command, in the order they were queued.
+ * 
+ * The engine calls this once per frame in ye_process_frame, after physics and before rendering.
+ * Commands queued while flushing run in the same flush.
+ */
+YE_API void ye_flush_deferred_commands(void);
+
+/**
+ * @brief Find entity by name, returns pointer to the newest entity of specified name, NULL if not found
  * 
  * @param name The name of the entity to find
  * @return struct ye_entity* 
  */
 YE_API struct ye_entity * ye_get_entity_by_name(const char *name);
 
+/**
+ * @brief Same as ye_get_entity_by_name, but does not log an error if nothing is found.
+ * Use this when probing for an entity that might not exist.
+ * 
+ * @param name The name of the entity to find
+ * @return struct ye_entity* 
+ */
+YE_API struct ye_entity * ye_try_get_entity_by_name(const char *name);
+
 /**
  * @brief Find an entity by tag (if there are more than one entity with this tag, it will return the first one, and NOT by distance)
  * 
@@ -165,7 +352,9 @@ YE_API struct ye_entity * ye_get_entity_by_name(const char *name);
 YE_API struct ye_entity * ye_get_entity_by_tag(const char *tag);
 
 /**
- * @brief Find an entity by id, returns pointer to first entity of specified id, NULL if not found
+ * @brief Find an entity by id, returns pointer to the entity currently holding the id, NULL if not found
+ * 
+ * @note Ids are recycled, hold a ye_entity_handle if you need to know the entity is still the same one.
  * 
  * @param id The id of the entity to find
  * @return struct ye_entity* 
@@ -23,6 +23,7 @@
 #include <yoyoengine/utils.h>
 
 #include <yoyoengine/types.h>
+#include <yoyoengine/glyph_atlas.h>
 
 /**
  * @enum ye_component_renderer_type
@@ -35,7 +36,42 @@ enum ye_component_renderer_type {
     YE_RENDERER_TYPE_TEXT_OUTLINED,
     YE_RENDERER_TYPE_IMAGE,
     YE_RENDERER_TYPE_ANIMATION,
-    YE_RENDERER_TYPE_TILEMAP_TILE
+    YE_RENDERER_TYPE_TILEMAP_TILE,
+    YE_RENDERER_TYPE_TILEMAP_LAYER
+};
+
+/**
+ * @brief The read only data parsed from an animation meta file, shared by every animation renderer using it.
+ */
+struct ye_animation_clip {
+    const char *meta_file;  ///< meta file this clip was parsed from (interned)
+    const char *src;        ///< handle of the frame map image (interned)
+    int frame_width;        ///< width of each frame
+    int frame_height;       ///< height of each frame
+    size_t frame_count;     ///< number of frames in animation
+    int frame_delay;        ///< default delay between frames in ms
+    int *frame_ends;        ///< if the meta file has "frame_delays", when each frame ends in ms into a loop. NULL if every frame lasts frame_delay
+    int duration;           ///< length of one loop in ms
+    int loops;              ///< default number of loops, -1 for infinite
+    int refcount;           ///< number of holders (renderers, prefabs)
+};
+
+/**
+ * @brief Everything a renderer's world space verticies are computed from. Renderer internal, used to skip
+ * recomputing the verticies of entities that haven't moved.
+ */
+struct ye_renderer_world_key {
+    bool has_transform;
+    float world_x, world_y, world_rotation; ///< of the transform
+    struct ye_rectf rect;
+    float rotation;
+    SDL_Point center;
+    int alignment;
+    bool preserve_original_size;
+    bool relative;
+    SDL_Texture *texture;
+    float uv_w, uv_h;
+    int frame_w, frame_h;   ///< animation frame, tile src, tilemap layer or laid out text size, 0 for other renderers
 };
 
 /**
@@ -44,7 +80,7 @@ enum ye_component_renderer_type {
 struct ye_component_renderer {
     bool active;    ///< controls whether system will act upon this component
 
-    SDL_Texture *texture;   ///< texture to render. For tilemaps this will be the full image even if only a portion is rendered
+    SDL_Texture *texture;   ///< texture to render. For tilemaps this will be the full image even if only a portion is rendered. Images, animations and tiles may share an atlas page (see _uv), text holds the first glyph page it uses
 
     enum ye_component_renderer_type type;   ///< denotes which renderer is needed for this entity
 
@@ -70,6 +106,7 @@ struct ye_component_renderer {
         struct ye_component_renderer_image *image;
         struct ye_component_renderer_animation *animation;
         struct ye_component_renderer_tilemap_tile *tile;
+        struct ye_component_renderer_tilemap_layer *tilemap_layer;
     } renderer_impl;
 
     bool lock_aspect_ratio; ///< locks the rect aspect ratio
@@ -78,19 +115,39 @@ struct ye_component_renderer {
         Renderer v2 cache
     */
     SDL_Vertex _world_verts[4]; ///< verticies for the renderer
-    SDL_Vertex _cam_verts[4];   ///< verticies for the renderer
+    SDL_Vertex _cam_verts[4];   ///< camera space verticies, only kept current while wireframes or editor overlays paint
     struct ye_point_rectf _local_rect;   ///< local rect of the renderer
     struct ye_point_rectf _world_rect;   ///< world rect of the renderer
     int _indicies[6];           ///< indicies for the renderer
     struct ye_point_rectf _paintbounds_full_verts; ///< local verticies for the paintbounds
+    struct ye_point_rectf _paintbounds_world_verts; ///< world verticies for the paintbounds
     struct ye_pointf _world_center; ///< world center of the renderer
+    struct ye_renderer_world_key _world_key;    ///< what the world space cache above was computed from
+    bool _world_valid;                          ///< whether _world_key means anything yet
+    SDL_FRect _uv;              ///< normalized part of texture holding our image, set when texture is an atlas page ({0,0,1,1} otherwise)
+
+    /*
+        Spatial grid bookkeeping (see renderer.c)
+    */
+    int _grid_x0, _grid_y0, _grid_x1, _grid_y1; ///< range of grid cells this renderer is bucketed in
+    bool _grid_placed;          ///< whether the renderer is in the grid at all
+    bool _grid_oversized;       ///< too big for cells, lives in the oversized list instead
+    int _grid_dirty_index;      ///< index in the grid's dirty list, -1 if clean
+    unsigned int _grid_stamp;   ///< last query that visited this renderer
+
+    /*
+        Render queue bookkeeping (see renderer.c)
+    */
+    int _queue_index;               ///< position in the sorted render queue
+    unsigned int _queue_seq;        ///< order this renderer was added in, breaks ties so equal keys keep insertion order
+    int _queue_z;                   ///< z this renderer was sorted with
 };
 
 /**
  * @brief A structure to represent an image renderer.
  */
 struct ye_component_renderer_image {
-    char *src;  ///< path to image
+    const char *src;    ///< path to image (interned, NULL for preloaded textures)
 };
 
 /**
@@ -98,12 +155,14 @@ struct ye_component_renderer_image {
  */
 struct ye_component_renderer_text {
     char *text;         ///< text to render
-    char *font_name;    ///< name of font to use
+    const char *font_name;  ///< name of font to use (interned)
     int font_size;      ///< size of font to use
-    char *color_name;   ///< name of the color to use
+    const char *color_name; ///< name of the color to use (interned)
     TTF_Font *font;     ///< font to use
     SDL_Color *color;   ///< color of text
     int wrap_width;     ///< if >0 then wrap text to this width (in pixels
+
+    struct ye_text_layout *layout;  ///< the text laid out into glyph quads, shared with copies of this renderer
 };
 
 /**
@@ -112,43 +171,83 @@ struct ye_component_renderer_text {
 struct ye_component_renderer_text_outlined {
     char *text;                 ///< text to render
     int outline_size;           ///< size of text outline
-    char *font_name;            ///< name of font to use
-    int font_size;              ///< size of font to use
-    char *color_name;           ///< name of the color to use
-    char *outline_color_name;   ///< name of the color to use for the outline
+    const char *font_name;          ///< name of font to use (interned)
+    int font_size;                  ///< size of font to use
+    const char *color_name;         ///< name of the color to use (interned)
+    const char *outline_color_name; ///< name of the color to use for the outline (interned)
     TTF_Font *font;             ///< font to use
     SDL_Color *color;           ///< color of text
     SDL_Color *outline_color;   ///< color of text outline
     int wrap_width;             ///< if >0 then wrap text to this width (in pixels)
+
+    struct ye_text_layout *layout;  ///< the text laid out into glyph quads, shared with copies of this renderer
 };
 
 /**
  * @brief A structure to represent an animation renderer.
  */
 struct ye_component_renderer_animation {
-    char *animation_handle;     ///< resource for animation map image
-    char *meta_file;            ///< meta file for animation details
+    const char *animation_handle;   ///< resource for animation map image (interned)
+    const char *meta_file;          ///< meta file for animation details (interned)
+    struct ye_animation_clip *clip; ///< shared parsed meta file, can be NULL (ex: restored from a snapshot)
 
     size_t frame_count;         ///< number of frames in animation
 
-    int frame_delay;            ///< delay between frames in ms
+    int frame_delay;            ///< delay between frames in ms (scales the clip's per frame delays if it has them)
     int loops;                  ///< number of loops, -1 for infinite
-    bool paused;                ///< whether or not the animation is paused
+    bool paused;                ///< whether or not the animation is paused, set once it finishes its loops
 
     int frame_width;            ///< width of each frame
     int frame_height;           ///< height of each frame
 
     // meta for engine:
-    int last_updated;           ///< SDL_GetTicks() last frame advance
-    int current_frame_index;    ///< current frame index
+    Uint64 start_time;          ///< SDL_GetTicks() when the animation started, frames are computed from it (set it to now to replay a finished animation)
+    int current_frame_index;    ///< current frame index, kept current while the animation is on screen
+    Uint64 _evaluated_frame;    ///< run of ye_system_animation current_frame_index was last computed on
 };
 
 /**
  * @brief A structure to represent a tilemap tile
  */
 struct ye_component_renderer_tilemap_tile {
-    char *handle;   ///< handle to tilemap source image (from loose or pack)
+    const char *handle; ///< handle to tilemap source image (from loose or pack, interned)
     SDL_Rect src;   ///< source rect of tile
+
+    float _texture_w, _texture_h;   ///< size of the renderer texture when it was set, so uvs don't query it every frame
+};
+
+/**
+ * @brief Pixel size a tilemap layer chunk aims for along each axis. Chunks hold whole tiles, so the real size
+ * is rounded down to a multiple of the tile size (and is at least one tile).
+ */
+#define YE_TILEMAP_CHUNK_PIXELS 512
+
+/**
+ * @brief A block of a tilemap layer, baked into its own texture.
+ */
+struct ye_tilemap_chunk {
+    SDL_Texture *texture;   ///< baked tiles (render target), NULL until first painted or while the chunk is empty
+    bool dirty;             ///< tiles changed since the last bake
+    bool empty;             ///< no tiles in the chunk as of the last bake
+};
+
+/**
+ * @brief A whole grid of tiles from one tileset.
+ * 
+ * The grid is split into chunks which are baked into textures the first time they are on screen,
+ * and re-baked only after one of their tiles changes. Each visible chunk is painted as one quad, so
+ * a 256x256 map costs a few dozen quads instead of 65k tile entities.
+ */
+struct ye_component_renderer_tilemap_layer {
+    const char *tileset;    ///< handle to the tileset image (from loose or pack, interned)
+    int tile_w, tile_h;     ///< size of one tile in the tileset
+    int tileset_cols;       ///< tiles per row of the tileset, tile index i is at column i % tileset_cols, row i / tileset_cols
+    int cols, rows;         ///< size of the layer in tiles
+    int *tiles;             ///< cols*rows tileset indices (row major), -1 for no tile
+
+    int chunk_tiles_x, chunk_tiles_y;   ///< tiles per chunk along each axis
+    int chunk_cols, chunk_rows;         ///< chunks along each axis
+    struct ye_tilemap_chunk *chunks;    ///< chunk_cols*chunk_rows chunks (row major)
 };
 
 /**
@@ -157,15 +256,58 @@ struct ye_component_renderer_tilemap_tile {
  */
 YE_API void ye_update_renderer_component(struct ye_entity *entity);
 
+/**
+ * @brief Change the z (layer) of an entity's renderer.
+ * 
+ * Renderers are painted in (z, texture, creation order), the render queue is re-sorted before the next paint.
+ * Writing renderer->z directly works too, it is picked up once the entity is on screen.
+ * 
+ * @param entity The entity whose renderer to move.
+ * @param z The new z.
+ */
+YE_API void ye_set_renderer_z(struct ye_entity *entity, int z);
+
+/**
+ * @brief Mark the render queue as needing a re-sort before the next paint. The ECS calls this when renderers come and go.
+ */
+YE_API void ye_render_queue_dirty(void);
+
+/**
+ * @brief Tell the renderer an entity's bounds changed, so it is re-bucketed in the culling grid.
+ * 
+ * Transform changes and the renderer constructors/ye_update_renderer_component do this for you. Call it
+ * after writing rect, rotation, center or alignment of a renderer directly, otherwise an off-screen
+ * entity moved into view this way won't be drawn until its transform changes.
+ * 
+ * @param entity The entity whose renderer bounds changed.
+ */
+YE_API void ye_renderer_bounds_changed(struct ye_entity *entity);
+
+/**
+ * @brief Puts every animation renderer that was on screen last frame on the frame matching the current time.
+ * 
+ * Ran once per frame by the engine's "animation" system, before rendering. Frames are computed from each
+ * animation's start_time rather than ticked, so animations that are off screen are skipped and still show
+ * the right frame as soon as they are painted again. Paused animations keep their place.
+ */
+YE_API void ye_system_animation(void);
+
 YE_API void ye_draw_subsecting_lines(SDL_Renderer * renderer, SDL_Rect cam, int line_spacing, int thickness, SDL_Color color);
 
+/**
+ * @brief Allocates a zeroed renderer impl struct (ex: struct ye_component_renderer_image) for the given type.
+ * @param type The type of the renderer component.
+ * @return void* The impl struct, to be passed to ye_add_renderer_component.
+ */
+YE_API void * ye_alloc_renderer_impl(enum ye_component_renderer_type type);
+
 /**
  * @brief Adds a renderer component to an entity.
  * @note Do not use this directly unless you know what you're doing.
  * @param entity The entity to add the renderer component to.
  * @param type The type of the renderer component.
  * @param z The z-index of the renderer component.
- * @param data A void pointer to a struct of matching type.
+ * @param data A void pointer to a struct of matching type, allocated with ye_alloc_renderer_impl.
  */
 YE_API void ye_add_renderer_component(struct ye_entity *entity, enum ye_component_renderer_type type, int z, void *data);
 
@@ -228,6 +370,85 @@ YE_API void ye_add_animation_renderer_component(struct ye_entity *entity, int z,
  */
 YE_API void ye_add_tilemap_renderer_component(struct ye_entity *entity, int z, const char * handle, SDL_Rect src);
 
+/**
+ * @brief Adds a tilemap layer renderer component to an entity. Every tile starts empty.
+ * 
+ * The renderer rect defaults to the full size of the layer (cols*tile_w by rows*tile_h).
+ * 
+ * @param entity The entity to add the tilemap layer renderer component to.
+ * @param z The z-index of the tilemap layer.
+ * @param tileset The handle to the tileset image (from loose or pack).
+ * @param tile_w The width of one tile in the tileset.
+ * @param tile_h The height of one tile in the tileset.
+ * @param cols The width of the layer in tiles.
+ * @param rows The height of the layer in tiles.
+ */
+YE_API void ye_add_tilemap_layer_renderer_component(struct ye_entity *entity, int z, const char *tileset, int tile_w, int tile_h, int cols, int rows);
+
+/**
+ * @brief Set one tile of a tilemap layer. Only the chunk holding it is re-baked.
+ * 
+ * @param entity The entity with the tilemap layer renderer.
+ * @param col The column of the tile.
+ * @param row The row of the tile.
+ * @param tile The tileset index to place, -1 to clear the tile.
+ */
+YE_API void ye_tilemap_layer_set_tile(struct ye_entity *entity, int col, int row, int tile);
+
+/**
+ * @brief Get one tile of a tilemap layer.
+ * 
+ * @param entity The entity with the tilemap layer renderer.
+ * @param col The column of the tile.
+ * @param row The row of the tile.
+ * @return int The tileset index at that spot, -1 if empty or out of bounds.
+ */
+YE_API int ye_tilemap_layer_get_tile(struct ye_entity *entity, int col, int row);
+
+/**
+ * @brief Replace every tile of a tilemap layer.
+ * 
+ * @param entity The entity with the tilemap layer renderer.
+ * @param tiles cols*rows tileset indices (row major), -1 for no tile.
+ */
+YE_API void ye_tilemap_layer_set_tiles(struct ye_entity *entity, const int *tiles);
+
+/**
+ * @brief Get the shared clip for an animation meta file, parsing it only if nothing holds it yet.
+ * @param meta_file The animation meta file.
+ * @return struct ye_animation_clip* The clip (release it with ye_animation_clip_release), NULL on failure.
+ */
+YE_API struct ye_animation_clip * ye_animation_clip_acquire(const char *meta_file);
+
+/**
+ * @brief Release a clip from ye_animation_clip_acquire, freeing it when nothing holds it anymore.
+ */
+YE_API void ye_animation_clip_release(struct ye_animation_clip *clip);
+
+/**
+ * @brief Adds a copy of a renderer component to an entity.
+ *
+ * Read only data (animation clips, laid out text) is shared with the source
+ * instead of being loaded again, everything else is copied. Animations restart
+ * from their first frame.
+ *
+ * @param entity The entity to add the renderer component to.
+ * @param renderer The renderer to copy (attached to an entity or from ye_copy_renderer_component).
+ */
+YE_API void ye_add_renderer_component_copy(struct ye_entity *entity, const struct ye_component_renderer *renderer);
+
+/**
+ * @brief Makes a renderer component copy not attached to any entity (ex: to keep in a prefab).
+ * @param renderer The renderer to copy.
+ * @return struct ye_component_renderer* The copy, free it with ye_free_renderer_component.
+ */
+YE_API struct ye_component_renderer * ye_copy_renderer_component(const struct ye_component_renderer *renderer);
+
+/**
+ * @brief Frees a renderer component from ye_copy_renderer_component.
+ */
+YE_API void ye_free_renderer_component(struct ye_component_renderer *renderer);
+
 /**
  * @brief Removes a renderer component from an entity.
  * @param entity The entity to remove the renderer component from.
@@ -266,6 +487,11 @@ YE_API void ye_remove_renderer_component(struct ye_entity *entity);
  */
 YE_API void ye_system_renderer(SDL_Renderer *renderer);
 
+/**
+ * @brief Frees memory held by the renderer (sprite batch, etc). Called by the engine on shutdown.
+ */
+YE_API void ye_shutdown_renderer(void);
+
 /**
  * @brief yoyoengine renderer v2
  * @param renderer The SDL renderer to use.
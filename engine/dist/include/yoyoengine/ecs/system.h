@@ -0,0 +1,145 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+/**
+ * @file system.h
+ * @brief ECS system scheduler.
+ *
+ * Systems (engine and game defined) are registered with the component types
+ * they read and write (YE_SIG_* masks from ecs.h). The scheduler orders them
+ * into levels where no two systems in a level conflict (rebuilt whenever a
+ * system is registered, removed or toggled), and each frame runs every level
+ * across a pool of worker threads.
+ *
+ * Two systems conflict if either writes a component the other reads or writes,
+ * or if either is YE_SYSTEM_EXCLUSIVE. Conflicting systems always run in
+ * stage order, then registration order.
+ *
+ * @warning Systems on worker threads may only touch the component data they
+ * declared. Creating/destroying entities, adding/removing components, logging,
+ * and the deferred command buffer are NOT thread safe, do that from a
+ * YE_SYSTEM_MAIN_THREAD system. The same goes for anything that writes
+ * renderer state behind your back (ye_renderer_bounds_changed, ye_set_renderer_z):
+ * declare YE_SIG_RENDERER in writes and use YE_SYSTEM_MAIN_THREAD.
+ *
+ * @note The position getters (ye_get_position, ye_get_position2,
+ * ye_get_offset_matrix) only refresh the transform world cache outside of
+ * parallel levels (see ye_read_transform), so they are safe to call from any
+ * system that declares YE_SIG_TRANSFORM in its reads.
+ */
+
+#ifndef YE_SYSTEM_H
+#define YE_SYSTEM_H
+
+#include <yoyoengine/export.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Always run this system on the main thread (anything touching SDL, Lua, Nuklear, etc).
+ */
+#define YE_SYSTEM_MAIN_THREAD   (1 << 0)
+
+/**
+ * @brief This system conflicts with every other system, nothing runs alongside it.
+ */
+#define YE_SYSTEM_EXCLUSIVE     (1 << 1)
+
+/**
+ * @brief Coarse ordering of systems within a frame. Systems only ever run
+ * out of this order when they don't conflict.
+ */
+enum ye_system_stage {
+    YE_SYSTEM_STAGE_INPUT,          ///< engine input handling
+    YE_SYSTEM_STAGE_UPDATE,         ///< game logic (default for game systems)
+    YE_SYSTEM_STAGE_PHYSICS,        ///< physics step
+    YE_SYSTEM_STAGE_LATE_UPDATE,    ///< game logic that wants post-physics state
+    YE_SYSTEM_STAGE_RENDER,         ///< deferred command flush, then rendering
+    YE_SYSTEM_STAGE_POST_RENDER,    ///< audio and anything else after paint
+};
+
+#define YE_SYSTEM_NAME_MAX 32
+
+/**
+ * @brief A registered system.
+ */
+struct ye_system {
+    char name[YE_SYSTEM_NAME_MAX];              ///< shown in the debug overlay
+    void (*callback)(struct ye_system *system); ///< ran once per frame
+    void *data;                                 ///< custom data for the callback
+
+    enum ye_system_stage stage;
+    uint64_t reads;                             ///< component signature bits this system reads
+    uint64_t writes;                            ///< component signature bits this system writes
+    int flags;                                  ///< YE_SYSTEM_* flags
+
+    bool enabled;                               ///< disabled systems are skipped
+
+    float time_ms;                              ///< time spent in the callback last frame
+    bool ran_on_worker;                         ///< whether it ran on a worker thread last frame
+
+    int _level;                                 ///< dependency level in the current schedule
+};
+
+/**
+ * @brief Register a system with the scheduler.
+ *
+ * @param name Name of the system (truncated to YE_SYSTEM_NAME_MAX).
+ * @param callback The function to run every frame, recieves the system (for system->data).
+ * @param stage Which part of the frame this system belongs to.
+ * @param reads Signature mask of the components this system reads.
+ * @param writes Signature mask of the components this system writes.
+ * @param flags YE_SYSTEM_* flags.
+ * @return struct ye_system* The system (owned by the scheduler), or NULL on failure.
+ */
+YE_API struct ye_system * ye_register_system(const char *name, void (*callback)(struct ye_system *system), enum ye_system_stage stage, uint64_t reads, uint64_t writes, int flags);
+
+/**
+ * @brief Unregister (and free) a system.
+ *
+ * @param system The system returned by ye_register_system.
+ */
+YE_API void ye_unregister_system(struct ye_system *system);
+
+/**
+ * @brief Enable or disable a system without unregistering it.
+ */
+YE_API void ye_set_system_enabled(struct ye_system *system, bool enabled);
+
+/**
+ * @brief Get every registered system, in schedule order.
+ *
+ * @param count Out: number of systems.
+ * @return struct ye_system** Array of systems, valid until the next (un)register.
+ */
+YE_API struct ye_system ** ye_get_systems(int *count);
+
+/**
+ * @brief Run every enabled system for this frame. Called by ye_process_frame.
+ */
+YE_API void ye_run_systems(void);
+
+/**
+ * @brief Whether systems are running concurrently right now (a level spread over the worker threads).
+ *
+ * While this is true nothing shared between systems (caches, the culling grid) may be written,
+ * only the component data a system declared.
+ */
+YE_API bool ye_systems_in_parallel(void);
+
+/**
+ * @brief Start the worker pool. Called by the engine on init.
+ */
+YE_API void ye_init_systems(void);
+
+/**
+ * @brief Stop the worker pool and unregister every system. Called by the engine on shutdown.
+ */
+YE_API void ye_shutdown_systems(void);
+
+#endif // YE_SYSTEM_H
@@ -21,15 +21,44 @@
 #define YE_TAG_MAX_NUMBER 10
 #define YE_TAG_MAX_LENGTH 20
 
+/**
+ * @brief Tag id of an empty tag slot. Real tag ids start at 1.
+ */
+#define YE_TAG_NONE 0
+
 /**
  * @brief The tag component
+ * 
+ * Tags are interned, each slot holds the id of a tag string (see ye_tag_intern and ye_tag_name).
  */
 struct ye_component_tag {
     bool active;    // controls whether system will act upon this component
 
-    char tags[YE_TAG_MAX_NUMBER][YE_TAG_MAX_LENGTH]; // array of tags
+    int tags[YE_TAG_MAX_NUMBER];    // interned tag ids, YE_TAG_NONE for an empty slot
+    int _index[YE_TAG_MAX_NUMBER];  // position of this entity in each tag's entity index
 };
 
+/**
+ * @brief Get the id of a tag string, interning it if it has never been seen before
+ * 
+ * @param tag The tag string
+ * @return int The tag id, YE_TAG_NONE if the tag is empty or invalid
+ */
+YE_API int ye_tag_intern(const char *tag);
+
+/**
+ * @brief Get the string of an interned tag id
+ * 
+ * @param id The tag id
+ * @return const char* The tag string, NULL if the id is not a known tag
+ */
+YE_API const char * ye_tag_name(int id);
+
+/**
+ * @brief Free every interned tag. Called by the engine on shutdown, after the ECS is gone.
+ */
+YE_API void ye_shutdown_tags();
+
 /**
  * @brief Add a tag component to an entity
  * 
@@ -72,7 +101,21 @@ YE_API void ye_remove_tag_component(struct ye_entity *entity);
 YE_API bool ye_entity_has_tag(struct ye_entity *entity, const char *tag);
 
 /**
- * @brief Iterates over every tagged entity, passing each one that matches a tag to a specified callback
+ * @brief Returns true if an entity has a specified (interned) tag id
+ * 
+ * @param entity The entity to check
+ * @param tag_id The tag id to check for
+ * @return true 
+ * @return false 
+ */
+YE_API bool ye_entity_has_tag_id(struct ye_entity *entity, int tag_id);
+
+/**
+ * @brief Passes every entity that has a tag to a specified callback
+ * 
+ * Only the entities with the tag are visited. The matches are collected before any callback
+ * runs, so it is safe to destroy entities or add/remove tags from inside the callback.
+ * Entities destroyed or untagged by an earlier callback are skipped.
  * 
  * @param tag The tag to match entities against
  * @param callback The non null callback with a struct ye_entity * parameter
@@ -27,11 +27,35 @@
 struct ye_component_transform {
     // bool active;    // controls whether system will act upon this component
 
-    float x;        // the transform x position
-    float y;        // the transform y position
+    float x;        // the transform x position (relative to the parent, if any)
+    float y;        // the transform y position (relative to the parent, if any)
 
     // physics2
-    float rotation; // clockwise rotation in degrees
+    float rotation; // clockwise rotation in degrees (relative to the parent, if any)
+
+    /*
+        Hierarchy, change with ye_set_transform_parent
+    */
+    struct ye_entity *parent;       // entity this transform is relative to, or NULL
+    struct ye_entity *first_child;  // first entity parented to this one
+    struct ye_entity *next_sibling; // next entity sharing our parent
+
+    /*
+        World space cache, kept up to date by ye_update_transform / ye_system_transform.
+        Read these (not x/y/rotation) when you need where the entity actually is.
+    */
+    float world_x;
+    float world_y;
+    float world_rotation;
+    mat3_t world_matrix;    // rotation by world_rotation around (world_x, world_y)
+    unsigned int version;   // bumped every time the world cache changes
+
+    // what the cache was built from, lets us notice direct writes to x/y/rotation
+    float _cached_x;
+    float _cached_y;
+    float _cached_rotation;
+    unsigned int _parent_version;
+    bool _cache_valid;
 };
 
 /**
@@ -50,4 +74,45 @@ YE_API void ye_add_transform_component(struct ye_entity *entity, int x, int y);
  */
 YE_API void ye_remove_transform_component(struct ye_entity *entity);
 
+/**
+ * @brief Parents one entity's transform to another. The child's x/y/rotation
+ * become relative to the parent (they are kept as is, not converted).
+ *
+ * @note Rigidbody entities can't be children, physics writes their transform in world space.
+ *
+ * @param child The entity to parent (must have a transform)
+ * @param parent The new parent (must have a transform), or NULL to unparent
+ */
+YE_API void ye_set_transform_parent(struct ye_entity *child, struct ye_entity *parent);
+
+/**
+ * @brief Brings the cached world values of an entity's transform (and its parents) up to date.
+ *
+ * Only recomputes if the local values or a parent changed since the last update,
+ * so this is cheap to call before reading world_x/world_y/world_rotation/world_matrix.
+ *
+ * @param entity The entity whose transform to update
+ * @return struct ye_component_transform* The transform, or NULL if the entity has none
+ */
+YE_API struct ye_component_transform * ye_update_transform(struct ye_entity *entity);
+
+/**
+ * @brief Get the world values of an entity's transform from any system.
+ *
+ * Outside of parallel levels this is ye_update_transform. While systems run in parallel (see
+ * ye_systems_in_parallel) nothing is written: a current cache is returned as is, and a stale one
+ * is worked out into out.
+ *
+ * @param entity The entity whose transform to read
+ * @param out Scratch space for the world values if the cache can't be used
+ * @return const struct ye_component_transform* The transform or out, NULL if the entity has none
+ */
+YE_API const struct ye_component_transform * ye_read_transform(struct ye_entity *entity, struct ye_component_transform *out);
+
+/**
+ * @brief Updates the world cache of every transform. Runs once per frame
+ * between physics and rendering (see the "transform" system).
+ */
+YE_API void ye_system_transform(void);
+
 #endif
\ No newline at end of file
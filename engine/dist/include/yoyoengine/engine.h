@@ -223,8 +223,10 @@ struct ye_runtime_data {
     int warning_count;          // same but for warnings
 
     struct {
-        int num_render_calls;   // number of RenderGeometry calls made this frame
+        int num_render_calls;   // number of RenderGeometry calls (sprite batches) made this frame
         int num_verticies;      // number of verticies sent to RenderGeometry this frame
+        int num_visited;        // number of renderers the spatial grid handed back as near the camera
+        int num_culled;         // number of renderers not painted because they were off screen
     } render_v2;
 
     /*
@@ -0,0 +1,106 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+/**
+ * @file glyph_atlas.h
+ * @brief Glyphs rasterized once into shared atlas pages, and text laid out as quads of them.
+ *
+ * Each glyph is rasterized (in white, tinted when painted) the first time it is asked for at a given
+ * font, size and outline, then packed into a shared page texture. Laying out text only looks glyphs up
+ * and writes quads, so changing a string (ex: a score counter) costs no surface or texture work, and
+ * text from any number of renderers can be batched together.
+ */
+
+#ifndef YE_GLYPH_ATLAS_H
+#define YE_GLYPH_ATLAS_H
+
+#include <yoyoengine/export.h>
+
+#include <stdbool.h>
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+
+/**
+ * @brief Width and height of a glyph atlas page. Glyphs too big for a page get a page of their own.
+ */
+#define YE_GLYPH_PAGE_SIZE 1024
+
+/**
+ * @brief A rasterized glyph.
+ */
+struct ye_glyph {
+    SDL_Texture *texture;   ///< atlas page holding the glyph, NULL if it has no pixels (ex: space)
+    SDL_FRect uv;           ///< normalized part of texture holding the glyph
+    int w, h;               ///< size of the glyph bitmap, which starts at the pen position and the top of the line
+    int advance;            ///< how far the pen moves after this glyph
+};
+
+/**
+ * @brief One glyph of laid out text.
+ */
+struct ye_text_quad {
+    SDL_Texture *texture;   ///< atlas page to draw from
+    SDL_FRect rect;         ///< where the glyph goes, relative to the top left of the text
+    SDL_FRect uv;           ///< normalized part of texture to draw
+    bool outline;           ///< part of the outline (tinted with the outline color) rather than the fill
+};
+
+/**
+ * @brief A string laid out into glyph quads. Outline quads come before fill quads so the fill paints on top.
+ */
+struct ye_text_layout {
+    struct ye_text_quad *quads;
+    int quad_count;
+    float w, h;         ///< size of the laid out text (what it would be as one rasterized surface)
+    int refcount;       ///< number of holders, freed when the last one releases it
+};
+
+/**
+ * @brief Get a glyph, rasterizing and packing it if this font, size and outline has not needed it before.
+ *
+ * @param font The font, at the size the glyph is wanted at.
+ * @param outline The outline width, 0 for the regular glyph.
+ * @param codepoint The unicode codepoint.
+ * @return const struct ye_glyph* The glyph, NULL if it could not be rasterized.
+ */
+YE_API const struct ye_glyph * ye_glyph(TTF_Font *font, int outline, Uint32 codepoint);
+
+/**
+ * @brief Lay out a string into glyph quads.
+ *
+ * @param text The UTF-8 text. Newlines always start a new line.
+ * @param font The font, at the size to lay out at.
+ * @param outline If >0, outline quads of this width are laid out behind the text.
+ * @param wrap_width If >0, lines are wrapped between words to fit this width (in pixels).
+ * @return struct ye_text_layout* The layout (refcount 1, release with ye_text_layout_release), NULL on failure.
+ */
+YE_API struct ye_text_layout * ye_text_layout_create(const char *text, TTF_Font *font, int outline, int wrap_width);
+
+/**
+ * @brief Release a layout, freeing it when nothing holds it anymore.
+ */
+YE_API void ye_text_layout_release(struct ye_text_layout *layout);
+
+/**
+ * @brief Forget every glyph of a font, must be called before the font is closed.
+ *
+ * The pixels stay in their pages until shutdown, laid out text still holding them keeps painting.
+ */
+YE_API void ye_glyph_atlas_forget_font(TTF_Font *font);
+
+/**
+ * @brief Returns the number of glyph atlas pages.
+ */
+YE_API int ye_get_glyph_atlas_page_count();
+
+/**
+ * @brief Frees every glyph and page. Called by the engine on shutdown.
+ */
+YE_API void ye_shutdown_glyph_atlas();
+
+#endif
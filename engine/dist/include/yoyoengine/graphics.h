@@ -132,6 +132,13 @@ YE_API void changeResolution(int width, int height);
  */
 YE_API void ye_recompute_boxing();
 
+/**
+ * @brief Forget the viewport, scale and logical presentation ye_render_all last set, so they are all sent to SDL again next frame.
+ * 
+ * ye_render_all skips these calls when nothing changed. Call this if you change any of them on the renderer yourself.
+ */
+YE_API void ye_invalidate_render_state();
+
 /**
  * @brief Initializes the graphics.
  */
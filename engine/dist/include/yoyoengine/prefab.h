@@ -0,0 +1,107 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+/**
+ * @file prefab.h
+ * @brief Prefabs, templates for spawning many copies of an entity cheaply.
+ *
+ * A prefab is built once (from a json file or an existing entity) and can then
+ * be instantiated any number of times. Instances share the prefab's read only
+ * data (parsed animation clips, laid out text, cached images) and only copy
+ * their mutable state, so spawning 1000 enemies parses their animation once
+ * instead of 1000 times.
+ *
+ * Ex:
+ * struct ye_prefab *enemy = ye_prefab_load("prefabs/enemy.yoyo");
+ * struct ye_entity *enemies[100];
+ * ye_prefab_instantiate_n(enemy, 100, enemies);
+ * ...
+ * ye_prefab_free(enemy);
+ *
+ * @note Instances are independent once created: editing an instance (ex:
+ * changing its text) gives it its own copy, and freeing the prefab does not
+ * affect its instances.
+ * @note Custom components (see component.h) are copied as raw bytes, any pointers
+ * inside them end up shared between the prefab's instances.
+ */
+
+#ifndef YE_PREFAB_H
+#define YE_PREFAB_H
+
+#include <yoyoengine/export.h>
+
+#include <stdbool.h>
+
+#include <yoyoengine/ecs/ecs.h>
+#include <yoyoengine/ecs/tag.h>
+#include <yoyoengine/ecs/component.h>
+#include <yoyoengine/ecs/camera.h>
+#include <yoyoengine/ecs/button.h>
+#include <yoyoengine/ecs/renderer.h>
+#include <yoyoengine/ecs/rigidbody.h>
+#include <yoyoengine/ecs/audiosource.h>
+
+/**
+ * @brief A captured entity that can be instantiated many times. Components the source did not have are NULL.
+ */
+struct ye_prefab {
+    const char *name;   ///< name given to instances (interned)
+    bool active;    ///< active state given to instances
+
+    bool has_transform;             ///< whether instances get a transform
+    float x, y, rotation;           ///< local transform of instances (they are not parented)
+
+    struct ye_component_renderer *renderer;         ///< detached renderer copy (see ye_copy_renderer_component)
+    struct ye_component_camera *camera;
+    struct ye_component_button *button;
+    struct ye_component_rigidbody *rigidbody;       ///< collider and body settings, copied into every instance
+    struct ye_component_tag *tag;
+    struct ye_component_audiosource *audiosource;
+
+    void *custom[YE_MAX_COMPONENT_TYPES - YE_COMPONENT_COUNT]; ///< raw bytes of each custom component, indexed by type - YE_COMPONENT_COUNT (NULL if absent)
+};
+
+/**
+ * @brief Capture an entity into a new prefab. The entity is left untouched.
+ *
+ * @param entity The entity to capture.
+ * @return struct ye_prefab* The prefab (free with ye_prefab_free), NULL on failure.
+ */
+YE_API struct ye_prefab * ye_prefab_capture(struct ye_entity *entity);
+
+/**
+ * @brief Load a prefab from a json file holding one entity, in the same format as an entry of a scene's "entities" array.
+ *
+ * @param path The resource path of the prefab file.
+ * @return struct ye_prefab* The prefab (free with ye_prefab_free), NULL on failure.
+ */
+YE_API struct ye_prefab * ye_prefab_load(const char *path);
+
+/**
+ * @brief Create one entity from a prefab.
+ *
+ * @param prefab The prefab to instantiate.
+ * @return struct ye_entity* The new entity, NULL on failure.
+ */
+YE_API struct ye_entity * ye_prefab_instantiate(struct ye_prefab *prefab);
+
+/**
+ * @brief Create many entities from a prefab.
+ *
+ * @param prefab The prefab to instantiate.
+ * @param count How many entities to create.
+ * @param out Optional, receives the created entities (must hold count entries).
+ * @return int The number of entities created.
+ */
+YE_API int ye_prefab_instantiate_n(struct ye_prefab *prefab, int count, struct ye_entity **out);
+
+/**
+ * @brief Free a prefab. Entities instantiated from it are not affected.
+ */
+YE_API void ye_prefab_free(struct ye_prefab *prefab);
+
+#endif // YE_PREFAB_H
@@ -19,6 +19,8 @@
 
 #include <jansson.h>
 
+#include <yoyoengine/ecs/ecs.h>
+
 /**
  * @brief Initializes the scene manager
  */
@@ -65,6 +67,14 @@ YE_API void ye_shutdown_scene_manager();
  */
 YE_API void ye_raw_scene_load(json_t *SCENE);
 
+/**
+ * @brief Creates one entity (and its components) from its json object in a scene file
+ * 
+ * @param entity The json object of the entity, in the same format as the scene "entities" array
+ * @return struct ye_entity* The created entity, NULL if the json was NULL
+ */
+YE_API struct ye_entity * ye_construct_entity(json_t *entity);
+
 /**
  * @brief Defer loading a scene til next frame
  * 
@@ -0,0 +1,86 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+/**
+ * @file snapshot.h
+ * @brief Binary snapshots of the whole ECS, for quicksaves, rollback and test fixtures.
+ *
+ * A snapshot stores every entity with its components, active flags, hierarchy,
+ * animation state and rigidbody velocities. Assets (images, fonts, colors,
+ * animations, audio) are stored by their resource handle, never by content.
+ *
+ * Restoring is incremental: entities that still exist (same handle) are
+ * patched in place without touching their assets, and only entities that
+ * were destroyed since the capture are rebuilt. Anything created since the
+ * capture is destroyed.
+ *
+ * @note Snapshots are in native byte order, they are meant for the machine
+ * that made them (not as a save file format to ship between platforms).
+ * @note Preloaded image renderers (no src handle) can be patched in place but not rebuilt.
+ * @note Custom components are matched by type name and copied as raw bytes, so any
+ * pointers inside them are restored as-is. Types not registered at restore time are skipped.
+ * @warning Restoring creates and destroys entities immediately, don't restore
+ * while iterating entities (restore between frames, or from an event callback).
+ */
+
+#ifndef YE_SNAPSHOT_H
+#define YE_SNAPSHOT_H
+
+#include <yoyoengine/export.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief A captured ECS state. Zero initialize before first use.
+ */
+struct ye_snapshot {
+    unsigned char *data;    ///< serialized bytes
+    size_t size;            ///< bytes used
+    size_t capacity;        ///< bytes allocated
+};
+
+/**
+ * @brief Capture the entire ECS into a snapshot (reusing its memory if it has any).
+ *
+ * @param snapshot The snapshot to write into.
+ * @return true on success.
+ */
+YE_API bool ye_snapshot_capture(struct ye_snapshot *snapshot);
+
+/**
+ * @brief Restore the ECS to the state held in a snapshot.
+ *
+ * @param snapshot The snapshot to restore.
+ * @return true on success, false if the snapshot is invalid (the ECS is untouched in that case).
+ */
+YE_API bool ye_snapshot_restore(const struct ye_snapshot *snapshot);
+
+/**
+ * @brief Free the memory held by a snapshot.
+ */
+YE_API void ye_snapshot_free(struct ye_snapshot *snapshot);
+
+/**
+ * @brief Write a snapshot to disk.
+ *
+ * @param snapshot The snapshot to write.
+ * @param path Full path of the file to write.
+ * @return true on success.
+ */
+YE_API bool ye_snapshot_write(const struct ye_snapshot *snapshot, const char *path);
+
+/**
+ * @brief Read a snapshot from disk (written by ye_snapshot_write).
+ *
+ * @param snapshot The snapshot to read into.
+ * @param path Full path of the file to read.
+ * @return true on success.
+ */
+YE_API bool ye_snapshot_read(struct ye_snapshot *snapshot, const char *path);
+
+#endif // YE_SNAPSHOT_H
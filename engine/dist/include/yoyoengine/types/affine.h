@@ -0,0 +1,77 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+/*
+    2D affine transforms (a 2x3 matrix).
+
+    Everything the renderer does to a vertex (align, rotate, place in the
+    world, move into the camera) is affine, so a whole chain of mat3_t's
+    can be composed once into a ye_affine and then applied with 4 multiplies
+    and 4 adds per vertex instead of a full 3x3 product per matrix.
+
+    x' = a * x + c * y + tx
+    y' = b * x + d * y + ty
+
+    ye_affine_transform_verts uses SSE on x86, NEON on ARM, and plain C
+    everywhere else.
+
+    Usage:
+
+    struct ye_affine m = ye_affine_mul(ye_affine_from_mat3(world), ye_affine_from_mat3(rotation));
+    ye_affine_transform_verts(&m, verts, 4);
+*/
+
+#ifndef YE_AFFINE_H
+#define YE_AFFINE_H
+
+#include <SDL.h>
+#include <Lilith.h>
+
+#include <yoyoengine/export.h>
+
+/**
+ * @brief A 2D affine transform.
+ */
+struct ye_affine {
+    float a, b;     ///< where the x axis goes
+    float c, d;     ///< where the y axis goes
+    float tx, ty;   ///< translation
+};
+
+/**
+ * @brief The identity transform.
+ */
+YE_API struct ye_affine ye_affine_identity(void);
+
+/**
+ * @brief Convert an (affine) mat3_t into a ye_affine.
+ *
+ * @param m The matrix, its projective row is ignored.
+ * @return struct ye_affine The same transform.
+ */
+YE_API struct ye_affine ye_affine_from_mat3(mat3_t m);
+
+/**
+ * @brief Compose two transforms, the result applies r first and then l (like the matrix product l * r).
+ */
+YE_API struct ye_affine ye_affine_mul(struct ye_affine l, struct ye_affine r);
+
+/**
+ * @brief Transform a single point in place.
+ */
+YE_API void ye_affine_apply(const struct ye_affine *m, float *x, float *y);
+
+/**
+ * @brief Transform the positions of many verticies in place. Colors and texture coordinates are left untouched.
+ *
+ * @param m The transform.
+ * @param verts The verticies.
+ * @param count How many verticies.
+ */
+YE_API void ye_affine_transform_verts(const struct ye_affine *m, SDL_Vertex *verts, int count);
+
+#endif // YE_AFFINE_H
@@ -0,0 +1,84 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+/*
+    A global string interning table.
+
+    Interning a string returns its "atom": the one shared copy of that string.
+    Equal strings always intern to the same pointer, so atoms can be compared
+    with == instead of strcmp, and a thousand components using the same
+    handle share a single allocation.
+
+    Atoms are refcounted, every ye_intern must be paired with a ye_intern_release.
+
+    NOTE: Not thread safe, intern from the main thread.
+
+    Usage:
+
+    const char *a = ye_intern("fonts/default.ttf");
+    const char *b = ye_intern("fonts/default.ttf");
+    // a == b
+
+    ye_intern_release(a);
+    ye_intern_release(b);
+*/
+
+#ifndef YE_INTERN_H
+#define YE_INTERN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <yoyoengine/export.h>
+
+/**
+ * @brief Get the atom for a string, taking a reference to it.
+ *
+ * @param str The string to intern (NULL interns to NULL).
+ * @return const char* The atom, never free it (use ye_intern_release).
+ */
+YE_API const char * ye_intern(const char *str);
+
+/**
+ * @brief Take another reference to an atom (cheaper than ye_intern when you already have one).
+ *
+ * @param atom An atom from ye_intern (NULL is ignored).
+ * @return const char* The same atom.
+ */
+YE_API const char * ye_intern_retain(const char *atom);
+
+/**
+ * @brief Release a reference to an atom, freeing it once nothing holds it.
+ *
+ * @param atom An atom from ye_intern (NULL is ignored).
+ */
+YE_API void ye_intern_release(const char *atom);
+
+/**
+ * @brief Get the atom for a string without taking a reference.
+ *
+ * Useful for comparing against atoms: if the string was never interned, no atom can equal it.
+ *
+ * @param str The string to look up.
+ * @return const char* The atom, or NULL if nothing holds this string.
+ */
+YE_API const char * ye_intern_find(const char *str);
+
+/**
+ * @brief Get the number of live atoms and the bytes they use.
+ *
+ * @param bytes Out (optional): bytes used by atom strings.
+ * @return size_t The number of live atoms.
+ */
+YE_API size_t ye_intern_stats(size_t *bytes);
+
+/**
+ * @brief Free the interning table. Logs any atoms still referenced.
+ */
+YE_API void ye_shutdown_intern(void);
+
+#endif // YE_INTERN_H
@@ -0,0 +1,98 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+/*
+    A fixed-size object pool, in C!
+
+    Objects are carved out of large slabs and recycled through a free-list,
+    so allocating and freeing is a couple of pointer swaps instead of a trip
+    to malloc. Unlike ye_vector, objects NEVER move once allocated.
+
+    NOTE: Not thread safe.
+
+    Usage:
+
+    // Define a pool of 256 objects per slab (no init needed)
+    static struct ye_pool bullet_pool = YE_POOL_INIT("bullet", struct bullet, 256);
+
+    // Allocate (zeroed) and free
+    struct bullet *b = ye_pool_alloc(&bullet_pool);
+    ye_pool_free(&bullet_pool, b);
+
+    // Release all memory (everything must have been freed)
+    ye_pool_destroy(&bullet_pool);
+*/
+
+#ifndef YE_POOL_H
+#define YE_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h> // size_t
+
+#include <yoyoengine/export.h>
+
+/**
+ * @brief A fixed-size object pool.
+ */
+struct ye_pool {
+    const char  *name;          ///< name shown in stats
+    size_t      element_size;   ///< size of one object
+    size_t      slab_capacity;  ///< objects per slab
+
+    void        *_slabs;        ///< list of allocated slabs
+    void        *_free_list;    ///< list of free objects
+
+    size_t      in_use;         ///< objects currently allocated
+    size_t      capacity;       ///< objects available across every slab
+    size_t      peak;           ///< highest in_use seen
+
+    bool        _registered;    ///< whether this pool is in the global pool list
+    struct ye_pool *_next;      ///< next pool in the global pool list
+};
+
+/**
+ * @brief Static initializer for a pool of objects of a given type.
+ */
+#define YE_POOL_INIT(name, type, per_slab) \
+    { (name), sizeof(type), (per_slab), NULL, NULL, 0, 0, 0, false, NULL }
+
+/**
+ * @brief Allocate a zeroed object from a pool.
+ *
+ * @param pool The pool to allocate from.
+ * @return void* The object, or NULL if memory could not be allocated.
+ */
+YE_API void * ye_pool_alloc(struct ye_pool *pool);
+
+/**
+ * @brief Return an object to the pool it was allocated from.
+ *
+ * @param pool The pool the object came from.
+ * @param ptr The object (NULL is ignored).
+ */
+YE_API void ye_pool_free(struct ye_pool *pool, void *ptr);
+
+/**
+ * @brief Free every slab owned by a pool. Any objects still in use become invalid.
+ *
+ * @param pool The pool to destroy.
+ */
+YE_API void ye_pool_destroy(struct ye_pool *pool);
+
+/**
+ * @brief Get the first pool that has allocated memory, iterate with pool->_next.
+ *
+ * @return struct ye_pool* The first pool, or NULL if none.
+ */
+YE_API struct ye_pool * ye_get_pools(void);
+
+/**
+ * @brief Destroy every pool that has allocated memory. Called by the engine on shutdown.
+ */
+YE_API void ye_shutdown_pools(void);
+
+#endif // YE_POOL_H
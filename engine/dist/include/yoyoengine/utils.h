@@ -80,19 +80,6 @@ YE_API SDL_Rect ye_convert_rectf_rect(struct ye_rectf rect);
  */
 YE_API struct ye_rectf ye_convert_rect_rectf(SDL_Rect rect);
 
-/**
- * @brief A collection of enums that define the different types of components.
- */
-enum ye_component_type {
-    YE_COMPONENT_TRANSFORM,
-    YE_COMPONENT_RENDERER,
-    YE_COMPONENT_RIGIDBODY,
-    YE_COMPONENT_AUDIOSOURCE,
-    YE_COMPONENT_CAMERA,
-    YE_COMPONENT_TAG,
-    YE_COMPONENT_BUTTON
-};
-
 /**
  * @brief Returns the angle between two points.
  * 
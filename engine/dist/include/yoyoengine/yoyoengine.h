@@ -57,11 +57,15 @@
 #include "ecs/rigidbody.h"
 #include "ecs/transform.h"
 #include "ecs/tag.h"
+#include "ecs/system.h"
+#include "ecs/component.h"
 
 #include "utils.h"
 #include "timer.h"
 #include "audio.h"
 #include "logging.h"        // logging
 #include "scene.h"          // scene manager
+#include "snapshot.h"       // binary ECS snapshots
+#include "prefab.h"         // prefab instancing
 
 #endif // YE_ENGINE_MAIN_H
\ No newline at end of file
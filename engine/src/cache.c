@@ -6,7 +6,9 @@
 */
 
 #include <string.h>
+#include <stdlib.h>
 
+#include <SDL_image.h>
 #include <jansson.h>
 
 #include <yoyoengine/yep.h>
@@ -14,6 +16,9 @@
 #include <yoyoengine/cache.h>
 #include <yoyoengine/engine.h>
 #include <yoyoengine/logging.h>
+#include <yoyoengine/glyph_atlas.h>
+#include <yoyoengine/filesystem.h>
+#include <yoyoengine/types/intern.h>
 #include <yoyoengine/ecs/renderer.h>
 
 /*
@@ -23,6 +28,84 @@ struct ye_texture_node * cached_textures_head;
 struct ye_font_node * cached_fonts_head;
 struct ye_color_node * cached_colors_head;
 
+/*
+    Text renderers ask for the same font/color over and over with their
+    interned names, so remember the last hit and check it by pointer first.
+*/
+static struct ye_font_node *last_font = NULL;
+static struct ye_color_node *last_color = NULL;
+
+/*
+    Texture atlas
+
+    Small images are packed into shared pages with a shelf packer: images are
+    placed left to right along the current shelf, and when one doesn't fit a
+    new shelf is opened above it (and a new page once the page is full).
+    Packing is lazy, an image only gets a spot the first time something asks
+    for it through ye_image_atlased.
+
+    Every image gets a 1px border copied from its own edge pixels, so linear
+    filtering at the edge of a sprite never picks up its neighbours.
+*/
+#define YE_ATLAS_PADDING 1
+
+struct ye_atlas_page {
+    SDL_Texture *texture;
+    int shelf_x;    // where the next image goes on the current shelf
+    int shelf_y;    // bottom of the current shelf
+    int shelf_h;    // height of the tallest image on the current shelf
+    struct ye_atlas_page *next;
+};
+
+struct ye_atlas_node {
+    struct ye_image_region region;
+    const char *path;   // interned
+    UT_hash_handle hh;
+};
+
+static struct ye_atlas_page *atlas_pages = NULL;
+static struct ye_atlas_node *atlas_head = NULL;
+
+// scale / blend mode last given to each texture we created, see ye_track_texture_state
+struct ye_texture_state {
+    SDL_Texture *texture;
+    SDL_ScaleMode scale;
+    SDL_BlendMode blend;
+    UT_hash_handle hh;
+};
+
+static struct ye_texture_state *texture_states = NULL;
+
+/*
+    Text layout cache
+
+    Everything showing the same string with the same font, size, outline and
+    wrap shares one layout (fifty "Buy" buttons hold one). Colors are not part
+    of the key, glyphs are tinted when painted.
+
+    The cache keeps its own reference to every layout, so one nothing else
+    holds anymore sticks around for reuse until it is the least recently used
+    of more than YE_TEXT_CACHE_MAX entries. uthash keeps insertion order, so
+    moving an entry to the back on every hit keeps the front least recent.
+*/
+#define YE_TEXT_CACHE_MAX 256
+
+struct ye_text_key {
+    const char *text;   // interned
+    TTF_Font *font;
+    float size;         // fonts are shared between sizes, see ye_font
+    int outline;
+    int wrap_width;
+};
+
+struct ye_text_node {
+    struct ye_text_key key;
+    struct ye_text_layout *layout;
+    UT_hash_handle hh;
+};
+
+static struct ye_text_node *cached_text_head = NULL;
+
 /*
     TODO: properly error check and validate every field
 */
@@ -82,7 +165,13 @@ void ye_pre_cache_scene(json_t *scene){
                 if(!ye_json_string(impl,"src",&src)){
                     continue;
                 }
-                ye_image(src);
+                ye_image_atlased(src);
+                break;
+            case YE_RENDERER_TYPE_TILEMAP_LAYER:
+                if(!ye_json_string(impl,"tileset",&src)){
+                    continue;
+                }
+                ye_image(src); // layers sample their tileset whole, not from an atlas
                 break;
             case YE_RENDERER_TYPE_ANIMATION:
                 // we are just gonna let the animation add cache this. so we dont have to extract more nested keys from the anim meta
@@ -205,15 +294,55 @@ void ye_init_cache(){
     cached_colors_head = NULL;
 }
 
+static void _ye_atlas_clear(){
+    struct ye_atlas_node *atlas_node, *atlas_tmp;
+    HASH_ITER(hh, atlas_head, atlas_node, atlas_tmp) {
+        HASH_DEL(atlas_head, atlas_node);
+        ye_intern_release(atlas_node->path);
+        free(atlas_node);
+    }
+
+    // standalone textures belong to the texture cache, only pages are ours
+    struct ye_atlas_page *page = atlas_pages;
+    while(page != NULL){
+        struct ye_atlas_page *next = page->next;
+        ye_untrack_texture_state(page->texture);
+        SDL_DestroyTexture(page->texture);
+        free(page);
+        page = next;
+    }
+    atlas_pages = NULL;
+}
+
+static void _ye_text_node_free(struct ye_text_node *node){
+    HASH_DEL(cached_text_head, node);
+    ye_text_layout_release(node->layout); // renderers still holding it keep it alive
+    ye_intern_release(node->key.text);
+    free(node);
+}
+
+// layouts of a font that is about to be closed can never be hit again
+static void _ye_text_cache_forget_font(TTF_Font *font){
+    struct ye_text_node *node, *tmp;
+    HASH_ITER(hh, cached_text_head, node, tmp) {
+        if(node->key.font == font)
+            _ye_text_node_free(node);
+    }
+}
+
 void ye_clear_texture_cache(){
     // free cached textures
     struct ye_texture_node *texture_node, *texture_tmp;
     HASH_ITER(hh, cached_textures_head, texture_node, texture_tmp) {
         HASH_DEL(cached_textures_head, texture_node);
+        ye_untrack_texture_state(texture_node->texture);
         SDL_DestroyTexture(texture_node->texture);
-        free(texture_node->path);
+        ye_intern_release(texture_node->path);
         free(texture_node);
     }
+
+    // atlas regions point into the textures above
+    _ye_atlas_clear();
 }
 
 void ye_clear_font_cache(){
@@ -225,12 +354,22 @@ void ye_clear_font_cache(){
         // make sure we dont clear the engine font if we had a failure loading this font from disk
         if(font_node->font != NULL && font_node->font != YE_STATE.engine.pEngineFont){
             // printf("Closing font: %s\n",font_node->name);
+            _ye_text_cache_forget_font(font_node->font);
+            ye_glyph_atlas_forget_font(font_node->font);
             TTF_CloseFont(font_node->font);
         }
         
-        free(font_node->name);
+        ye_intern_release(font_node->name);
         free(font_node);
     }
+    last_font = NULL;
+}
+
+void ye_clear_text_cache(){
+    struct ye_text_node *node, *tmp;
+    HASH_ITER(hh, cached_text_head, node, tmp) {
+        _ye_text_node_free(node);
+    }
 }
 
 void ye_clear_color_cache(){
@@ -238,9 +377,10 @@ void ye_clear_color_cache(){
     struct ye_color_node *color_node, *color_tmp;
     HASH_ITER(hh, cached_colors_head, color_node, color_tmp) {
         HASH_DEL(cached_colors_head, color_node);
-        free(color_node->name);
+        ye_intern_release(color_node->name);
         free(color_node);
     }
+    last_color = NULL;
 }
 
 void ye_shutdown_cache(){
@@ -253,6 +393,16 @@ void ye_shutdown_cache(){
     // free cached colors
     ye_clear_color_cache();
 
+    // free cached text layouts
+    ye_clear_text_cache();
+
+    // anything still tracked is owned elsewhere (text), just forget it
+    struct ye_texture_state *state, *state_tmp;
+    HASH_ITER(hh, texture_states, state, state_tmp) {
+        HASH_DEL(texture_states, state);
+        free(state);
+    }
+
     ye_logf(info,"%s","Shut down cache.\n");
 }
 
@@ -275,22 +425,182 @@ SDL_Texture * ye_image(const char *path){
     return ye_cache_texture(path);
 }
 
+// find room for a w*h image (padding included) on some page, opening a new page if none has any
+static struct ye_atlas_page * _ye_atlas_alloc(int w, int h, int *x, int *y){
+    if(w > YE_ATLAS_PAGE_SIZE || h > YE_ATLAS_PAGE_SIZE)
+        return NULL;
+
+    struct ye_atlas_page *page = atlas_pages;
+    for(; page != NULL; page = page->next){
+        // the current shelf is always the top one, so it can grow taller while the page has room
+        if(page->shelf_x + w <= YE_ATLAS_PAGE_SIZE && page->shelf_y + h <= YE_ATLAS_PAGE_SIZE)
+            break;
+
+        // open a new shelf above the current one
+        int next_y = page->shelf_y + page->shelf_h;
+        if(next_y + h <= YE_ATLAS_PAGE_SIZE){
+            page->shelf_x = 0;
+            page->shelf_y = next_y;
+            page->shelf_h = 0;
+            break;
+        }
+    }
+
+    if(page == NULL){
+        page = calloc(1, sizeof(struct ye_atlas_page));
+        if(page == NULL)
+            return NULL;
+
+        page->texture = SDL_CreateTexture(YE_STATE.runtime.renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, YE_ATLAS_PAGE_SIZE, YE_ATLAS_PAGE_SIZE);
+        if(page->texture == NULL){
+            ye_logf(error,"Failed to create texture atlas page: %s\n",SDL_GetError());
+            free(page);
+            return NULL;
+        }
+        ye_track_texture_state(page->texture, SDL_BLENDMODE_BLEND);
+
+        page->next = atlas_pages;
+        atlas_pages = page;
+    }
+
+    *x = page->shelf_x;
+    *y = page->shelf_y;
+    page->shelf_x += w;
+    if(h > page->shelf_h)
+        page->shelf_h = h;
+
+    return page;
+}
+
+// copy a surface into the atlas, extruding its edge pixels into the padding
+static bool _ye_atlas_pack(SDL_Surface *surface, struct ye_image_region *region){
+    int w = surface->w;
+    int h = surface->h;
+    int pw = w + YE_ATLAS_PADDING * 2;
+    int ph = h + YE_ATLAS_PADDING * 2;
+
+    int x, y;
+    struct ye_atlas_page *page = _ye_atlas_alloc(pw, ph, &x, &y);
+    if(page == NULL)
+        return false;
+
+    SDL_Surface *rgba = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+    Uint32 *pixels = malloc(sizeof(Uint32) * pw * ph);
+    if(rgba == NULL || pixels == NULL){
+        // the spot we took is wasted until the cache is cleared, not worth undoing
+        SDL_DestroySurface(rgba);
+        free(pixels);
+        return false;
+    }
+
+    SDL_LockSurface(rgba);
+    for(int row = 0; row < h; row++){
+        const Uint32 *src = (const Uint32 *)((const Uint8 *)rgba->pixels + row * rgba->pitch);
+        Uint32 *dst = &pixels[(row + YE_ATLAS_PADDING) * pw];
+        memcpy(&dst[YE_ATLAS_PADDING], src, sizeof(Uint32) * w);
+        for(int p = 0; p < YE_ATLAS_PADDING; p++){
+            dst[p] = src[0];
+            dst[pw - 1 - p] = src[w - 1];
+        }
+    }
+    SDL_UnlockSurface(rgba);
+    SDL_DestroySurface(rgba);
+
+    for(int p = 0; p < YE_ATLAS_PADDING; p++){
+        memcpy(&pixels[p * pw], &pixels[YE_ATLAS_PADDING * pw], sizeof(Uint32) * pw);
+        memcpy(&pixels[(ph - 1 - p) * pw], &pixels[(ph - 1 - YE_ATLAS_PADDING) * pw], sizeof(Uint32) * pw);
+    }
+
+    SDL_Rect dst_rect = {x, y, pw, ph};
+    bool ok = SDL_UpdateTexture(page->texture, &dst_rect, pixels, pw * (int)sizeof(Uint32));
+    free(pixels);
+    if(!ok){
+        ye_logf(error,"Failed to upload image to texture atlas: %s\n",SDL_GetError());
+        return false;
+    }
+
+    region->texture = page->texture;
+    region->uv = (SDL_FRect){
+        (float)(x + YE_ATLAS_PADDING) / YE_ATLAS_PAGE_SIZE,
+        (float)(y + YE_ATLAS_PADDING) / YE_ATLAS_PAGE_SIZE,
+        (float)w / YE_ATLAS_PAGE_SIZE,
+        (float)h / YE_ATLAS_PAGE_SIZE
+    };
+    region->w = w;
+    region->h = h;
+    return true;
+}
+
+struct ye_image_region ye_image_atlased(const char *path){
+    struct ye_atlas_node *node = NULL;
+    HASH_FIND_STR(atlas_head, path, node);
+    if(node != NULL)
+        return node->region;
+
+    struct ye_image_region region = {0};
+
+    // we need the pixels to pack, so load the surface ourselves
+    SDL_Surface *sur = NULL;
+    if(!YE_STATE.editor.editor_mode)
+        sur = yep_resource_image(path);
+    if(sur == NULL && ye_file_exists(ye_path_resources(path)))
+        sur = IMG_Load(ye_path_resources(path));
+
+    bool packed = false;
+    if(sur != NULL && sur->w <= YE_ATLAS_MAX_SPRITE && sur->h <= YE_ATLAS_MAX_SPRITE)
+        packed = _ye_atlas_pack(sur, &region);
+
+    if(!packed){
+        // too big, failed to pack, or missing: standalone texture from the texture cache
+        struct ye_texture_node *texture_node = NULL;
+        HASH_FIND_STR(cached_textures_head, path, texture_node);
+        if(texture_node != NULL){
+            region.texture = texture_node->texture;
+        }
+        else if(sur != NULL){
+            region.texture = SDL_CreateTextureFromSurface(YE_STATE.runtime.renderer, sur);
+            ye_track_texture_state(region.texture, SDL_BLENDMODE_BLEND);
+            ye_cache_texture_manual(region.texture, path);
+        }
+        else{
+            region.texture = ye_image(path); // logs and hands back the missing texture
+        }
+
+        float w = 0, h = 0;
+        SDL_GetTextureSize(region.texture, &w, &h);
+        region.uv = (SDL_FRect){0, 0, 1, 1};
+        region.w = (int)w;
+        region.h = (int)h;
+    }
+
+    SDL_DestroySurface(sur);
+
+    node = malloc(sizeof(struct ye_atlas_node));
+    node->region = region;
+    node->path = ye_intern(path);
+    HASH_ADD_KEYPTR(hh, atlas_head, node->path, strlen(node->path), node);
+
+    return region;
+}
+
 TTF_Font * ye_font(const char *name, int size){
     // check cache for font named by name and size
-    struct ye_font_node *node;
-    for(node = cached_fonts_head; node != NULL; node = node->hh.next) {
-        if(strcmp(node->name, name) == 0) {
-            // ye_logf(debug,"CACHE HIT: %s\n",name);
-
-            // we found it, so resize if necessary
-            if(node->size != size){
-                // its good to resize here even if its larger, because huge fonts take much longer to render
-                TTF_SetFontSize(node->font,size);
-                node->size = size;
-            }
+    struct ye_font_node *node = last_font;
+    if(node == NULL || node->name != name)
+        HASH_FIND_STR(cached_fonts_head, name, node);
 
-            return node->font;
+    if(node != NULL){
+        // ye_logf(debug,"CACHE HIT: %s\n",name);
+        last_font = node;
+
+        // we found it, so resize if necessary
+        if(node->size != size){
+            // its good to resize here even if its larger, because huge fonts take much longer to render
+            TTF_SetFontSize(node->font,size);
+            node->size = size;
         }
+
+        return node->font;
     }
 
     ye_logf(error,"Font cache miss: %s. Returning default.\n",name);
@@ -299,18 +609,75 @@ TTF_Font * ye_font(const char *name, int size){
 
 SDL_Color * ye_color(const char *name){
     // check cache for color named by name
-    struct ye_color_node *node;
-    for(node = cached_colors_head; node != NULL; node = node->hh.next) {
-        if(strcmp(node->name, name) == 0) {
-            // ye_logf(debug,"CACHE HIT: %s\n",name);
-            return &node->color;
-        }
+    struct ye_color_node *node = last_color;
+    if(node == NULL || node->name != name)
+        HASH_FIND_STR(cached_colors_head, name, node);
+
+    if(node != NULL){
+        // ye_logf(debug,"CACHE HIT: %s\n",name);
+        last_color = node;
+        return &node->color;
     }
 
     ye_logf(error,"Color cache miss: %s. Returning default.\n",name);
     return YE_STATE.engine.pEngineFontColor;
 }
 
+struct ye_text_layout * ye_text(const char *text, TTF_Font *font, int outline, int wrap_width){
+    if(text == NULL || font == NULL){
+        ye_logf(error,"%s","Cannot get text layout without text and a font.\n");
+        return NULL;
+    }
+
+    struct ye_text_key key;
+    memset(&key, 0, sizeof(key)); // the key is hashed bytewise, padding included
+    key.font = font;
+    key.size = TTF_GetFontSize(font);
+    key.outline = outline;
+    key.wrap_width = wrap_width;
+
+    // text that was never interned can't have been laid out yet
+    key.text = ye_intern_find(text);
+    if(key.text != NULL){
+        struct ye_text_node *node = NULL;
+        HASH_FIND(hh, cached_text_head, &key, sizeof(struct ye_text_key), node);
+        if(node != NULL){
+            // move to the back, the front is always the least recently used
+            HASH_DEL(cached_text_head, node);
+            HASH_ADD(hh, cached_text_head, key, sizeof(struct ye_text_key), node);
+
+            node->layout->refcount++;
+            return node->layout;
+        }
+    }
+
+    struct ye_text_layout *layout = ye_text_layout_create(text, font, outline, wrap_width);
+    if(layout == NULL)
+        return NULL; // reason was already logged
+
+    struct ye_text_node *node = malloc(sizeof(struct ye_text_node));
+    if(node == NULL){
+        ye_logf(error,"%s","Failed to allocate text cache node.\n");
+        return layout; // still usable, just not shared
+    }
+    key.text = ye_intern(text);
+    node->key = key;
+    node->layout = layout;
+    layout->refcount++; // one for the caller, one for the cache
+    HASH_ADD(hh, cached_text_head, key, sizeof(struct ye_text_key), node);
+
+    // drop least recently used layouts nothing else holds until we are back under the limit
+    struct ye_text_node *old, *tmp;
+    HASH_ITER(hh, cached_text_head, old, tmp) {
+        if(HASH_COUNT(cached_text_head) <= YE_TEXT_CACHE_MAX)
+            break;
+        if(old->layout->refcount == 1)
+            _ye_text_node_free(old);
+    }
+
+    return layout;
+}
+
 /*
     EXTENDED API:
     This is used by the primary API but can also be used directly by the developer.
@@ -320,8 +687,7 @@ void ye_cache_texture_manual(SDL_Texture *texture, const char *key){
     // cache the texture
     struct ye_texture_node *new_node = malloc(sizeof(struct ye_texture_node));
     new_node->texture = texture;
-    new_node->path = malloc(strlen(key) + 1);
-    strcpy(new_node->path, key);
+    new_node->path = ye_intern(key);
     HASH_ADD_KEYPTR(hh, cached_textures_head, new_node->path, strlen(new_node->path), new_node);
 }
 
@@ -339,7 +705,7 @@ SDL_Texture * ye_cache_texture(const char *path){
     }
     else{
         texture = SDL_CreateTextureFromSurface(YE_STATE.runtime.renderer, sur);
-        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        ye_track_texture_state(texture, SDL_BLENDMODE_BLEND);
         SDL_DestroySurface(sur);
     }
 
@@ -359,8 +725,7 @@ TTF_Font * ye_cache_font_manual(const char *name, TTF_Font *font){
     // cache the font
     struct ye_font_node *new_node = malloc(sizeof(struct ye_font_node));
     new_node->font = font;
-    new_node->name = malloc(strlen(name) + 1);
-    strcpy(new_node->name, name);
+    new_node->name = ye_intern(name);
     new_node->size = 1; // we load the fonts at size 1 for now
     HASH_ADD_KEYPTR(hh, cached_fonts_head, new_node->name, strlen(new_node->name), new_node);
     // ye_logf(debug,"Cached font: %s\n",name);
@@ -382,8 +747,7 @@ TTF_Font * ye_cache_font(const char *name, /*int size,*/ const char *path){
     // cache the font
     struct ye_font_node *new_node = malloc(sizeof(struct ye_font_node));
     new_node->font = font;
-    new_node->name = malloc(strlen(name) + 1);
-    strcpy(new_node->name, name);
+    new_node->name = ye_intern(name);
     new_node->size = 1; // we load the fonts at size 1 for now
     HASH_ADD_KEYPTR(hh, cached_fonts_head, new_node->name, strlen(new_node->name), new_node);
     // ye_logf(debug,"Cached font: %s\n",name);
@@ -394,8 +758,7 @@ SDL_Color * ye_cache_color(const char *name, SDL_Color color){
     // cache the color
     struct ye_color_node *new_node = malloc(sizeof(struct ye_color_node));
     new_node->color = color;
-    new_node->name = malloc(strlen(name) + 1);
-    strcpy(new_node->name, name);
+    new_node->name = ye_intern(name);
     HASH_ADD_KEYPTR(hh, cached_colors_head, new_node->name, strlen(new_node->name), new_node);
     // ye_logf(debug,"Cached color: %s\n",name);
     return &new_node->color;
@@ -406,6 +769,13 @@ int ye_get_cache_texture_count(){
     return (int)count;
 }
 
+int ye_get_cache_atlas_page_count(){
+    int count = 0;
+    for(struct ye_atlas_page *page = atlas_pages; page != NULL; page = page->next)
+        count++;
+    return count;
+}
+
 int ye_get_cache_font_count(){
     unsigned int count = HASH_COUNT(cached_fonts_head);
     return (int)count;
@@ -416,12 +786,27 @@ int ye_get_cache_color_count(){
     return (int)count;
 }
 
+int ye_get_cache_text_count(){
+    unsigned int count = HASH_COUNT(cached_text_head);
+    return (int)count;
+}
+
 void ye_destroy_texture(const char *path){
     if(path == NULL){
         ye_logf(warning,"%s","Attempted to destroy texture with NULL path.\n");
         return;
     }
 
+    // an atlased texture may have no node of its own, so forget its region either way
+    // (the page space stays used until the atlas is cleared)
+    struct ye_atlas_node *atlas_node = NULL;
+    HASH_FIND_STR(atlas_head, path, atlas_node);
+    if(atlas_node != NULL){
+        HASH_DEL(atlas_head, atlas_node);
+        ye_intern_release(atlas_node->path);
+        free(atlas_node);
+    }
+
     struct ye_texture_node *node = NULL;
     HASH_FIND_STR(cached_textures_head, path, node);
     
@@ -431,16 +816,17 @@ void ye_destroy_texture(const char *path){
         
         // Destroy the SDL texture
         if(node->texture != NULL){
+            ye_untrack_texture_state(node->texture);
             SDL_DestroyTexture(node->texture);
         }
-        
-        // Free the path string and node
-        free(node->path);
+
+        // Release the path string and free the node
+        ye_intern_release(node->path);
         free(node);
         
         // ye_logf(debug,"Destroyed cached texture: %s\n",path);
     }
-    else{
+    else if(atlas_node == NULL){
         ye_logf(warning,"Attempted to destroy non-cached texture: %s\n",path);
     }
 }
@@ -460,11 +846,15 @@ void ye_destroy_font(const char *name){
         
         // Close the TTF font (but not if it's the engine fallback font)
         if(node->font != NULL && node->font != YE_STATE.engine.pEngineFont){
+            _ye_text_cache_forget_font(node->font);
+            ye_glyph_atlas_forget_font(node->font);
             TTF_CloseFont(node->font);
         }
         
-        // Free the name string and node
-        free(node->name);
+        // Release the name string and free the node
+        if(last_font == node)
+            last_font = NULL;
+        ye_intern_release(node->name);
         free(node);
         
         // ye_logf(debug,"Destroyed cached font: %s\n",name);
@@ -487,8 +877,10 @@ void ye_destroy_color(const char *name){
         // Remove from hash table
         HASH_DEL(cached_colors_head, node);
         
-        // Free the name string and node
-        free(node->name);
+        // Release the name string and free the node
+        if(last_color == node)
+            last_color = NULL;
+        ye_intern_release(node->name);
         free(node);
         
         // ye_logf(debug,"Destroyed cached color: %s\n",name);
@@ -496,4 +888,102 @@ void ye_destroy_color(const char *name){
     else{
         ye_logf(warning,"Attempted to destroy non-cached color: %s\n",name);
     }
-}
\ No newline at end of file
+}
+
+/*
+    Texture state
+
+    SDL3 dropped the global scale quality hint, so the scale mode has to live
+    on each texture. Rather than setting it on every texture every frame, we
+    remember what each texture we created was last given and only call into
+    SDL when something actually changes.
+*/
+
+SDL_ScaleMode ye_quality_scale_mode(){
+    // 2 (best) used to mean anisotropic, SDL3 has nothing better than linear
+    if(YE_STATE.engine.sdl_quality_hint == 0)
+        return SDL_SCALEMODE_NEAREST;
+    return SDL_SCALEMODE_LINEAR;
+}
+
+void ye_track_texture_state(SDL_Texture *texture, SDL_BlendMode blend){
+    if(texture == NULL)
+        return;
+
+    struct ye_texture_state *state = NULL;
+    HASH_FIND_PTR(texture_states, &texture, state);
+    if(state == NULL){
+        state = malloc(sizeof(struct ye_texture_state));
+        if(state == NULL){
+            // untracked textures still work, they just never skip a call
+            SDL_SetTextureBlendMode(texture, blend);
+            SDL_SetTextureScaleMode(texture, ye_quality_scale_mode());
+            return;
+        }
+        state->texture = texture;
+        HASH_ADD_PTR(texture_states, texture, state);
+    }
+
+    state->blend = blend;
+    state->scale = ye_quality_scale_mode();
+    SDL_SetTextureBlendMode(texture, state->blend);
+    SDL_SetTextureScaleMode(texture, state->scale);
+}
+
+void ye_untrack_texture_state(SDL_Texture *texture){
+    if(texture == NULL)
+        return;
+
+    struct ye_texture_state *state = NULL;
+    HASH_FIND_PTR(texture_states, &texture, state);
+    if(state != NULL){
+        HASH_DEL(texture_states, state);
+        free(state);
+    }
+}
+
+void ye_texture_set_scale_mode(SDL_Texture *texture, SDL_ScaleMode mode){
+    if(texture == NULL)
+        return;
+
+    struct ye_texture_state *state = NULL;
+    HASH_FIND_PTR(texture_states, &texture, state);
+    if(state != NULL){
+        if(state->scale == mode)
+            return;
+        state->scale = mode;
+    }
+    SDL_SetTextureScaleMode(texture, mode);
+}
+
+void ye_texture_set_blend_mode(SDL_Texture *texture, SDL_BlendMode mode){
+    if(texture == NULL)
+        return;
+
+    struct ye_texture_state *state = NULL;
+    HASH_FIND_PTR(texture_states, &texture, state);
+    if(state != NULL){
+        if(state->blend == mode)
+            return;
+        state->blend = mode;
+    }
+    SDL_SetTextureBlendMode(texture, mode);
+}
+
+void ye_set_quality_hint(int hint){
+    YE_STATE.engine.sdl_quality_hint = hint;
+
+    SDL_ScaleMode mode = ye_quality_scale_mode();
+    struct ye_texture_state *state, *tmp;
+    HASH_ITER(hh, texture_states, state, tmp) {
+        if(state->scale != mode){
+            state->scale = mode;
+            SDL_SetTextureScaleMode(state->texture, mode);
+        }
+    }
+}
+
+int ye_get_tracked_texture_count(){
+    unsigned int count = HASH_COUNT(texture_states);
+    return (int)count;
+}
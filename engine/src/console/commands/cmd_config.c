@@ -14,6 +14,7 @@
 
 #include <string.h>
 
+#include <yoyoengine/cache.h>
 #include <yoyoengine/engine.h>
 #include <yoyoengine/logging.h>
 #include <yoyoengine/commands.h>
@@ -142,8 +143,10 @@ void ye_cmd_config(int argc, const char **argv) {
         else if(strcmp(argv[1], "framecap") == 0)
             _config_set_int("framecap", &YE_STATE.engine.framecap, atoi(argv[2]));
         
-        else if(strcmp(argv[1], "sdl_quality_hint") == 0)
+        else if(strcmp(argv[1], "sdl_quality_hint") == 0){
             _config_set_int("sdl_quality_hint", &YE_STATE.engine.sdl_quality_hint, atoi(argv[2]));
+            ye_set_quality_hint(YE_STATE.engine.sdl_quality_hint); // re-apply to every loaded texture
+        }
         
         else if(strcmp(argv[1], "stretch_resolution") == 0)
             _config_set_bool("stretch_resolution", &YE_STATE.engine.stretch_resolution, atoi(argv[2]));
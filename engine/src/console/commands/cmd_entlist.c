@@ -75,28 +75,30 @@ void ye_cmd_entlist(int argc, const char **argv) {
 
     int entity_count = 0;
     int matching_entity_count = 0;
-    struct ye_entity_node *current = entity_list_head;
-    while(current != NULL) {
+    struct ye_entity_set *set = ye_get_entity_set();
+    for(int i = 0; i < set->count; i++) {
+        struct ye_entity *entity = set->entities[i];
+
         // Add logic to count entities and match based on component flags and tag filter
         entity_count++;
         bool matches = true;
 
         if(!include_all) {
-            if(include_transform && !current->entity->transform)
+            if(include_transform && !entity->transform)
                 matches = false;
-            if(include_renderer && !current->entity->renderer)
+            if(include_renderer && !entity->renderer)
                 matches = false;
-            if(include_camera && !current->entity->camera)
+            if(include_camera && !entity->camera)
                 matches = false;
-            if(include_button && !current->entity->button)
+            if(include_button && !entity->button)
                 matches = false;
-            if(include_rigidbody && !current->entity->rigidbody)
+            if(include_rigidbody && !entity->rigidbody)
                 matches = false;
-            if(include_tag && !current->entity->tag)
+            if(include_tag && !entity->tag)
                 matches = false;
-            if(include_audiosource && !current->entity->audiosource)
+            if(include_audiosource && !entity->audiosource)
                 matches = false;
-            if(include_tag_filter && !ye_entity_has_tag(current->entity, tag_filter))
+            if(include_tag_filter && !ye_entity_has_tag(entity, tag_filter))
                 matches = false;
         }
 
@@ -106,24 +108,22 @@ void ye_cmd_entlist(int argc, const char **argv) {
         */
         if(matches){
             matching_entity_count++;
-            ye_logf(_YE_RESERVED_LL_SYSTEM, "Entity: \"%s\" [ID: %d]\n", current->entity->name, current->entity->id);
-            if(current->entity->transform)
+            ye_logf(_YE_RESERVED_LL_SYSTEM, "Entity: \"%s\" [ID: %d]\n", entity->name, entity->id);
+            if(entity->transform)
                 ye_logf(_YE_RESERVED_LL_SYSTEM, "    [Transform]\n");
-            if(current->entity->renderer)
+            if(entity->renderer)
                 ye_logf(_YE_RESERVED_LL_SYSTEM, "    [Renderer]\n");
-            if(current->entity->camera)
+            if(entity->camera)
                 ye_logf(_YE_RESERVED_LL_SYSTEM, "    [Camera]\n");
-            if(current->entity->button)
+            if(entity->button)
                 ye_logf(_YE_RESERVED_LL_SYSTEM, "    [Button]\n");
-            if(current->entity->rigidbody)
+            if(entity->rigidbody)
                 ye_logf(_YE_RESERVED_LL_SYSTEM, "    [Rigidbody]\n");
-            if(current->entity->tag)
+            if(entity->tag)
                 ye_logf(_YE_RESERVED_LL_SYSTEM, "    [Tag]\n");
-            if(current->entity->audiosource)
+            if(entity->audiosource)
                 ye_logf(_YE_RESERVED_LL_SYSTEM, "    [Audiosource]\n");
         }
-
-        current = current->next;
     }
 
     // print total entity count
@@ -11,8 +11,12 @@
 
 #include <yoyoengine/audio.h>
 #include <yoyoengine/engine.h>
+#include <yoyoengine/types/pool.h>
+#include <yoyoengine/types/intern.h>
 #include <yoyoengine/ecs/audiosource.h>
 
+static struct ye_pool audiosource_pool = YE_POOL_INIT("audiosource", struct ye_component_audiosource, 64);
+
 /*
     Per-track stopped callback for audiosource components.
     Fires when a track finishes all its loops.
@@ -33,10 +37,10 @@ void ye_add_audiosource_component(struct ye_entity *entity, const char *handle,
     /*
         Add an audiosource component to the entity
     */
-    struct ye_component_audiosource *newsrc = malloc(sizeof(struct ye_component_audiosource));
+    struct ye_component_audiosource *newsrc = ye_pool_alloc(&audiosource_pool);
 
-    // alloc the handle
-    newsrc->handle = strdup(handle);
+    // intern the handle
+    newsrc->handle = ye_intern(handle);
 
     // assign fields
     newsrc->volume = volume;
@@ -50,8 +54,8 @@ void ye_add_audiosource_component(struct ye_entity *entity, const char *handle,
     // add the component to the entity
     entity->audiosource = newsrc;
 
-    // add the entity to the audiosource list
-    ye_entity_list_add(&audiosource_list_head, entity);
+    // add the entity to the audiosource set
+    ye_entity_set_add(ye_get_component_set(YE_COMPONENT_AUDIOSOURCE), entity, newsrc);
 
     if(play_on_awake && !YE_STATE.editor.editor_mode){
         // play the sound
@@ -89,11 +93,11 @@ void ye_remove_audiosource_component(struct ye_entity *entity){
         _ye_audio_decrement_busy();
     }
 
-    free(src->handle);
-    free(src);
+    ye_intern_release(src->handle);
+    ye_pool_free(&audiosource_pool, src);
     entity->audiosource = NULL;
 
-    ye_entity_list_remove(&audiosource_list_head, entity);
+    ye_entity_set_remove(ye_get_component_set(YE_COMPONENT_AUDIOSOURCE), entity);
 }
 
 void ye_play_audiosource(struct ye_entity *entity){
@@ -139,13 +143,13 @@ void ye_system_audiosource(){
         The component has a range, which the outside of is considered to be 0 volume and the center of is considered to be 128 volume.
         We will also scale this against the "volume" set for the component so in reality the center is the max we want it to be.
     */
-    struct ye_entity_node *node;
-    for(node = audiosource_list_head; node != NULL; node = node->next){
+    struct ye_entity_set *set = ye_get_component_set(YE_COMPONENT_AUDIOSOURCE);
+    for(int i = 0; i < set->count; i++){
         // get the entity
-        struct ye_entity *entity = node->entity;
+        struct ye_entity *entity = set->entities[i];
 
         // get the audiosource component
-        struct ye_component_audiosource *src = entity->audiosource;
+        struct ye_component_audiosource *src = set->components[i];
 
         if(!entity || !entity->active || !src || !src->active){
             continue;
@@ -10,6 +10,9 @@
 #include <yoyoengine/utils.h>
 #include <yoyoengine/ecs/ecs.h>
 #include <yoyoengine/ecs/button.h>
+#include <yoyoengine/types/pool.h>
+
+static struct ye_pool button_pool = YE_POOL_INIT("button", struct ye_component_button, 64);
 
 /*
     Old SCDG impl is practically useless, but in repo history can still be found before this commit.
@@ -17,7 +20,7 @@
 */
 
 void ye_add_button_component(struct ye_entity *entity, struct ye_rectf rect){
-    struct ye_component_button *button = malloc(sizeof(struct ye_component_button));
+    struct ye_component_button *button = ye_pool_alloc(&button_pool);
     button->active = true;
     button->relative = false;
     button->rect = rect;
@@ -29,13 +32,13 @@ void ye_add_button_component(struct ye_entity *entity, struct ye_rectf rect){
     button->_was_pressed = false;
 
     entity->button = button;
-    ye_entity_list_add(&button_list_head, entity);
+    ye_entity_set_add(ye_get_component_set(YE_COMPONENT_BUTTON), entity, button);
 }
 
 void ye_remove_button_component(struct ye_entity *entity){
-    free(entity->button);
+    ye_pool_free(&button_pool, entity->button);
     entity->button = NULL;
-    ye_entity_list_remove(&button_list_head, entity);
+    ye_entity_set_remove(ye_get_component_set(YE_COMPONENT_BUTTON), entity);
 }
 
 void ye_system_button(SDL_Event event){
@@ -47,15 +50,14 @@ void ye_system_button(SDL_Event event){
     float mouseX, mouseY; SDL_GetMouseState(&mouseX, &mouseY);
     ye_get_mouse_world_position(&mouseX, &mouseY);
 
-    // iterate over button list
-    struct ye_entity_node *itr = button_list_head;
-    while(itr != NULL){
-        struct ye_entity *entity = itr->entity;
-        struct ye_component_button *button = entity->button;
+    // iterate over button set
+    struct ye_entity_set *set = ye_get_component_set(YE_COMPONENT_BUTTON);
+    for(int i = 0; i < set->count; i++){
+        struct ye_entity *entity = set->entities[i];
+        struct ye_component_button *button = set->components[i];
 
         // if inactive, skip it
         if(!button->active || !entity->active) {
-            itr = itr->next;
             continue;
         }
 
@@ -86,8 +88,6 @@ void ye_system_button(SDL_Event event){
             button->is_clicked = false;
             button->_was_pressed = false;
         }
-
-        itr = itr->next;
     }
 }
 
@@ -9,14 +9,17 @@
 #include <string.h>
 
 #include <yoyoengine/engine.h>
+#include <yoyoengine/types/pool.h>
 #include <yoyoengine/ecs/camera.h>
 
+static struct ye_pool camera_pool = YE_POOL_INIT("camera", struct ye_component_camera, 16);
+
 void ye_set_camera(struct ye_entity *entity){
     YE_STATE.engine.target_camera = entity;
 }
 
 void ye_add_camera_component(struct ye_entity *entity, int z, struct ye_rectf view_field){
-    entity->camera = malloc(sizeof(struct ye_component_camera));
+    entity->camera = ye_pool_alloc(&camera_pool);
     memset(entity->camera, 0, sizeof(struct ye_component_camera));
     entity->camera->active = true;
     entity->camera->view_field = view_field; // x and y are used as an offset from the transform on the camera
@@ -26,14 +29,14 @@ void ye_add_camera_component(struct ye_entity *entity, int z, struct ye_rectf vi
     // log that we added a transform and to what ID
     // ye_logf(debug, "Added camera to entity %d\n", entity->id);
 
-    // add this entity to the camera component list
-    ye_entity_list_add(&camera_list_head, entity);
+    // add this entity to the camera component set
+    ye_entity_set_add(ye_get_component_set(YE_COMPONENT_CAMERA), entity, entity->camera);
 }
 
 void ye_remove_camera_component(struct ye_entity *entity){
-    free(entity->camera);
+    ye_pool_free(&camera_pool, entity->camera);
     entity->camera = NULL;
 
-    // remove the entity from the camera component list
-    ye_entity_list_remove(&camera_list_head, entity);
+    // remove the entity from the camera component set
+    ye_entity_set_remove(ye_get_component_set(YE_COMPONENT_CAMERA), entity);
 }
\ No newline at end of file
@@ -0,0 +1,261 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <string.h>
+#include <stdlib.h>
+
+#include <yoyoengine/logging.h>
+#include <yoyoengine/ecs/ecs.h>
+#include <yoyoengine/ecs/component.h>
+
+/*
+    Storage for one custom component type.
+
+    Components are packed in data (count of them, stride bytes apart) with a
+    parallel array of their owners. sparse maps an entity id (slot) to the
+    component's index in data, or -1.
+*/
+struct ye_component_storage {
+    char *name;
+    size_t size;
+    size_t stride;
+
+    void (*ctor)(struct ye_entity *entity, void *component);
+    void (*dtor)(struct ye_entity *entity, void *component);
+
+    unsigned char *data;
+    struct ye_entity **entities;
+    int count;
+    int capacity;
+
+    int *sparse;
+    int sparse_capacity;
+};
+
+// indexed by type id, builtin ids are unused
+static struct ye_component_storage *component_types[YE_MAX_COMPONENT_TYPES];
+static int next_component_type = YE_COMPONENT_COUNT;
+
+static struct ye_component_storage * _ye_component_storage(int type){
+    if(type < YE_COMPONENT_COUNT || type >= next_component_type)
+        return NULL;
+    return component_types[type];
+}
+
+int ye_register_component_type(const char *name, size_t size, void (*ctor)(struct ye_entity *entity, void *component), void (*dtor)(struct ye_entity *entity, void *component)){
+    if(name == NULL || size == 0){
+        ye_logf(error, "Could not register component type, name is NULL or size is 0.\n");
+        return -1;
+    }
+
+    int existing = ye_get_component_type(name);
+    if(existing != -1){
+        if(component_types[existing]->size != size){
+            ye_logf(error, "Component type \"%s\" is already registered with a different size.\n", name);
+            return -1;
+        }
+        return existing;
+    }
+
+    if(next_component_type >= YE_MAX_COMPONENT_TYPES){
+        ye_logf(error, "Could not register component type \"%s\", the limit of %d component types was reached.\n", name, YE_MAX_COMPONENT_TYPES);
+        return -1;
+    }
+
+    struct ye_component_storage *storage = calloc(1, sizeof(struct ye_component_storage));
+    if(storage == NULL){
+        ye_logf(error, "Failed to allocate component type \"%s\".\n", name);
+        return -1;
+    }
+
+    // keep every component in the dense array aligned for anything
+    size_t align = sizeof(void *) > sizeof(double) ? sizeof(void *) : sizeof(double);
+
+    storage->name = strdup(name);
+    storage->size = size;
+    storage->stride = (size + align - 1) & ~(align - 1);
+    storage->ctor = ctor;
+    storage->dtor = dtor;
+
+    int type = next_component_type++;
+    component_types[type] = storage;
+
+    ye_logf(debug, "Registered component type \"%s\" (%d).\n", name, type);
+    return type;
+}
+
+int ye_get_component_type(const char *name){
+    if(name == NULL)
+        return -1;
+
+    for(int i = YE_COMPONENT_COUNT; i < next_component_type; i++){
+        if(strcmp(component_types[i]->name, name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+const char * ye_get_component_type_name(int type){
+    struct ye_component_storage *storage = _ye_component_storage(type);
+    return storage ? storage->name : NULL;
+}
+
+static bool _ye_component_reserve(struct ye_component_storage *storage, int entity_id){
+    if(storage->count >= storage->capacity){
+        int capacity = storage->capacity > 0 ? storage->capacity * 2 : 64;
+
+        unsigned char *data = realloc(storage->data, storage->stride * capacity);
+        if(data == NULL)
+            return false;
+        storage->data = data;
+
+        struct ye_entity **entities = realloc(storage->entities, sizeof(struct ye_entity *) * capacity);
+        if(entities == NULL)
+            return false;
+        storage->entities = entities;
+
+        storage->capacity = capacity;
+    }
+
+    if(entity_id >= storage->sparse_capacity){
+        int capacity = storage->sparse_capacity > 0 ? storage->sparse_capacity : 64;
+        while(entity_id >= capacity)
+            capacity *= 2;
+
+        int *sparse = realloc(storage->sparse, sizeof(int) * capacity);
+        if(sparse == NULL)
+            return false;
+        for(int i = storage->sparse_capacity; i < capacity; i++)
+            sparse[i] = -1;
+
+        storage->sparse = sparse;
+        storage->sparse_capacity = capacity;
+    }
+
+    return true;
+}
+
+void * ye_add_component(struct ye_entity *entity, int type){
+    struct ye_component_storage *storage = _ye_component_storage(type);
+    if(entity == NULL || storage == NULL){
+        ye_logf(error, "Could not add component of type %d, entity is NULL or the type is not a registered custom type.\n", type);
+        return NULL;
+    }
+
+    if(entity->signature & YE_COMPONENT_BIT(type)){
+        ye_logf(error, "Entity \"%s\" already has a \"%s\" component.\n", entity->name, storage->name);
+        return NULL;
+    }
+
+    if(!_ye_component_reserve(storage, entity->id)){
+        ye_logf(error, "Failed to grow storage for component \"%s\".\n", storage->name);
+        return NULL;
+    }
+
+    int index = storage->count++;
+    void *component = storage->data + storage->stride * index;
+    memset(component, 0, storage->stride);
+    storage->entities[index] = entity;
+    storage->sparse[entity->id] = index;
+
+    entity->signature |= YE_COMPONENT_BIT(type);
+    ye_ecs_structure_changed();
+
+    if(storage->ctor)
+        storage->ctor(entity, component);
+
+    return component;
+}
+
+void ye_remove_component(struct ye_entity *entity, int type){
+    struct ye_component_storage *storage = _ye_component_storage(type);
+    if(entity == NULL || storage == NULL || !(entity->signature & YE_COMPONENT_BIT(type))){
+        ye_logf(error, "Could not remove component of type %d, the entity does not have one.\n", type);
+        return;
+    }
+
+    int index = storage->sparse[entity->id];
+    void *component = storage->data + storage->stride * index;
+
+    if(storage->dtor)
+        storage->dtor(entity, component);
+
+    // swap the last component into the hole to stay dense
+    int last = --storage->count;
+    if(index != last){
+        memcpy(component, storage->data + storage->stride * last, storage->stride);
+        storage->entities[index] = storage->entities[last];
+        storage->sparse[storage->entities[index]->id] = index;
+    }
+    storage->sparse[entity->id] = -1;
+
+    entity->signature &= ~YE_COMPONENT_BIT(type);
+    ye_ecs_structure_changed();
+}
+
+void * ye_get_component(struct ye_entity *entity, int type){
+    if(entity == NULL || type < YE_COMPONENT_COUNT || type >= YE_MAX_COMPONENT_TYPES || !(entity->signature & YE_COMPONENT_BIT(type)))
+        return NULL;
+
+    struct ye_component_storage *storage = component_types[type];
+    return storage->data + storage->stride * storage->sparse[entity->id];
+}
+
+bool ye_has_component(struct ye_entity *entity, int type){
+    if(entity == NULL || type < 0 || type >= YE_MAX_COMPONENT_TYPES)
+        return false;
+    return (entity->signature & YE_COMPONENT_BIT(type)) != 0;
+}
+
+void * ye_get_component_array(int type, int *count){
+    struct ye_component_storage *storage = _ye_component_storage(type);
+    if(count)
+        *count = storage ? storage->count : 0;
+    return storage ? storage->data : NULL;
+}
+
+size_t ye_get_component_stride(int type){
+    struct ye_component_storage *storage = _ye_component_storage(type);
+    return storage ? storage->stride : 0;
+}
+
+struct ye_entity ** ye_get_component_entities(int type, int *count){
+    struct ye_component_storage *storage = _ye_component_storage(type);
+    if(count)
+        *count = storage ? storage->count : 0;
+    return storage ? storage->entities : NULL;
+}
+
+void ye_remove_custom_components(struct ye_entity *entity){
+    if(entity == NULL)
+        return;
+
+    // nothing past the builtin bits, nothing to do
+    if((entity->signature >> YE_COMPONENT_COUNT) == 0)
+        return;
+
+    for(int type = YE_COMPONENT_COUNT; type < next_component_type; type++){
+        if(entity->signature & YE_COMPONENT_BIT(type))
+            ye_remove_component(entity, type);
+    }
+}
+
+void ye_shutdown_component_types(void){
+    for(int type = YE_COMPONENT_COUNT; type < next_component_type; type++){
+        struct ye_component_storage *storage = component_types[type];
+        if(storage->count > 0)
+            ye_logf(warning, "Component type \"%s\" shut down with %d components still in use.\n", storage->name, storage->count);
+
+        free(storage->data);
+        free(storage->entities);
+        free(storage->sparse);
+        free(storage->name);
+        free(storage);
+        component_types[type] = NULL;
+    }
+    next_component_type = YE_COMPONENT_COUNT;
+}
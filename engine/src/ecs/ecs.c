@@ -11,13 +11,19 @@
 
 #include <SDL.h>
 
+#include <uthash/uthash.h>
+
 #include <yoyoengine/types.h>
+#include <yoyoengine/types/pool.h>
+#include <yoyoengine/types/intern.h>
 
 #include <yoyoengine/yep.h>
 #include <yoyoengine/cache.h>
 #include <yoyoengine/engine.h>
+#include <yoyoengine/glyph_atlas.h>
 #include <yoyoengine/ecs/ecs.h>
 #include <yoyoengine/ecs/tag.h>
+#include <yoyoengine/ecs/component.h>
 #include <yoyoengine/ecs/camera.h>
 #include <yoyoengine/ecs/button.h>
 #include <yoyoengine/ecs/renderer.h>
@@ -25,144 +31,464 @@
 #include <yoyoengine/ecs/transform.h>
 #include <yoyoengine/ecs/audiosource.h>
 
-// entity id counter (used to assign unique ids to entities)
-int eid = 0;
+//////////////////////// ENTITY SLOTS //////////////////////////
 
-//////////////////////// LINKED LIST //////////////////////////
+/*
+    Entity ids index into this table. Destroying an entity bumps the slot
+    generation and pushes the slot onto a free list, so ids get recycled
+    and handles to the old entity stop resolving.
+*/
+struct ye_entity_slot {
+    struct ye_entity *entity;   // NULL if the slot is free
+    uint32_t generation;
+    int next_free;              // next free slot, -1 terminates
+};
+
+static struct ye_entity_slot *entity_slots = NULL;
+static int entity_slot_count = 0;
+static int entity_slot_capacity = 0;
+static int entity_slot_free_head = -1;
+
+static int _ye_entity_slot_acquire(struct ye_entity *entity){
+    int id;
+    if(entity_slot_free_head != -1){
+        id = entity_slot_free_head;
+        entity_slot_free_head = entity_slots[id].next_free;
+    }
+    else{
+        if(entity_slot_count >= entity_slot_capacity){
+            int capacity = entity_slot_capacity > 0 ? entity_slot_capacity * 2 : 64;
+            struct ye_entity_slot *slots = realloc(entity_slots, sizeof(struct ye_entity_slot) * capacity);
+            if(slots == NULL){
+                ye_logf(error, "Failed to grow entity slot table to %d entries.\n", capacity);
+                entity->id = -1;
+                entity->_generation = 0;
+                return -1;
+            }
+            entity_slots = slots;
+            entity_slot_capacity = capacity;
+        }
+        id = entity_slot_count++;
+        entity_slots[id].generation = 0;
+    }
 
-struct ye_entity_node *ye_entity_list_create() {
-    return NULL; // Initialize an empty list
-}
+    entity_slots[id].entity = entity;
+    entity_slots[id].next_free = -1;
 
-void ye_entity_list_add(struct ye_entity_node **list, struct ye_entity *entity) {
-    struct ye_entity_node *newNode = malloc(sizeof(struct ye_entity_node));
-    newNode->entity = entity;
-    newNode->next = *list;
-    *list = newNode;
+    entity->id = id;
+    entity->_generation = entity_slots[id].generation;
+    return id;
 }
 
-void ye_entity_list_add_sorted_renderer_z(struct ye_entity_node **list, struct ye_entity *entity){
-    if(entity == NULL || entity->renderer == NULL){
-        ye_logf(warning, "Error adding to render list sorted Z, something was null.\n");
+static void _ye_entity_slot_release(struct ye_entity *entity){
+    int id = entity->id;
+    if(id < 0 || id >= entity_slot_count || entity_slots[id].entity != entity)
         return;
+
+    entity_slots[id].entity = NULL;
+    entity_slots[id].generation++;
+    entity_slots[id].next_free = entity_slot_free_head;
+    entity_slot_free_head = id;
+}
+
+/*
+    Rebuild the free list in ascending order once every entity is gone,
+    so a fresh scene hands out ids from 0 again. Generations are kept, which
+    means handles from before the purge still won't resolve.
+*/
+static void _ye_entity_slots_reset(void){
+    entity_slot_free_head = -1;
+    for(int i = entity_slot_count - 1; i >= 0; i--){
+        entity_slots[i].entity = NULL;
+        entity_slots[i].next_free = entity_slot_free_head;
+        entity_slot_free_head = i;
     }
-    
-    struct ye_entity_node *newNode = malloc(sizeof(struct ye_entity_node));
-    newNode->entity = entity;
-    newNode->next = NULL;
+}
+
+struct ye_entity_handle ye_get_entity_handle(struct ye_entity *entity){
+    if(entity == NULL)
+        return YE_ENTITY_HANDLE_NULL;
+    return (struct ye_entity_handle){entity->id, entity->_generation};
+}
+
+struct ye_entity * ye_get_entity_from_handle(struct ye_entity_handle handle){
+    if(handle.id < 0 || handle.id >= entity_slot_count)
+        return NULL;
+
+    struct ye_entity_slot *slot = &entity_slots[handle.id];
+    if(slot->entity == NULL || slot->generation != handle.generation)
+        return NULL;
 
-    // if the list is empty, add to head
-    if(*list == NULL){
-        *list = newNode;
+    return slot->entity;
+}
+
+bool ye_entity_handle_valid(struct ye_entity_handle handle){
+    return ye_get_entity_from_handle(handle) != NULL;
+}
+
+//////////////////////// ENTITY SETS //////////////////////////
+
+struct ye_entity_set entity_set = { .slot = YE_COMPONENT_COUNT };
+struct ye_entity_set component_sets[YE_COMPONENT_COUNT];
+
+// bumped whenever any set membership changes, used to invalidate cached queries
+static unsigned int ecs_structure_version = 0;
+
+void ye_ecs_structure_changed(void){
+    ecs_structure_version++;
+}
+
+struct ye_entity_set * ye_get_entity_set(void){
+    return &entity_set;
+}
+
+struct ye_entity_set * ye_get_component_set(enum ye_component_type type){
+    if(type < 0 || type >= YE_COMPONENT_COUNT){
+        ye_logf(error, "Requested component set for invalid component type %d\n", type);
+        return NULL;
+    }
+    return &component_sets[type];
+}
+
+static bool _ye_entity_set_reserve(struct ye_entity_set *set, int count){
+    if(count <= set->capacity)
+        return true;
+
+    int capacity = set->capacity > 0 ? set->capacity : 64;
+    while(capacity < count)
+        capacity *= 2;
+
+    struct ye_entity **entities = realloc(set->entities, sizeof(struct ye_entity *) * capacity);
+    if(entities == NULL){
+        ye_logf(error, "Failed to grow entity set to %d entries.\n", capacity);
+        return false;
+    }
+    set->entities = entities;
+
+    void **components = realloc(set->components, sizeof(void *) * capacity);
+    if(components == NULL){
+        ye_logf(error, "Failed to grow entity set to %d entries.\n", capacity);
+        return false;
+    }
+    set->components = components;
+
+    set->capacity = capacity;
+    return true;
+}
+
+static void _ye_entity_set_free(struct ye_entity_set *set){
+    free(set->entities);
+    free(set->components);
+    set->entities = NULL;
+    set->components = NULL;
+    set->count = 0;
+    set->capacity = 0;
+}
+
+void ye_entity_set_add(struct ye_entity_set *set, struct ye_entity *entity, void *component){
+    if(set == NULL || entity == NULL){
+        ye_logf(warning, "Error adding to entity set, something was null.\n");
         return;
     }
 
-    // if the new node is less than the head, add to head
-    if(newNode->entity->renderer->z < (*list)->entity->renderer->z){
-        newNode->next = *list;
-        *list = newNode;
+    if(entity->_set_index[set->slot] != -1){
+        ye_logf(warning, "Entity \"%s\" is already in this set, ignoring add.\n", entity->name);
         return;
     }
 
-    // otherwise, traverse the list and find the correct spot
-    struct ye_entity_node *current = *list;
-    while(current->next != NULL){
-        if(newNode->entity->renderer->z < current->next->entity->renderer->z){
-            newNode->next = current->next;
-            current->next = newNode;
-            return;
-        }
-        current = current->next;
+    if(!_ye_entity_set_reserve(set, set->count + 1))
+        return;
+
+    set->entities[set->count] = entity;
+    set->components[set->count] = component;
+    entity->_set_index[set->slot] = set->count;
+    set->count++;
+
+    if(set->slot < YE_COMPONENT_COUNT)
+        entity->signature |= YE_COMPONENT_BIT(set->slot);
+    ecs_structure_version++;
+}
+
+void ye_entity_set_add_sorted_renderer_z(struct ye_entity *entity){
+    if(entity == NULL || entity->renderer == NULL){
+        ye_logf(warning, "Error adding to render list sorted Z, something was null.\n");
+        return;
     }
 
-    // if we reach the end of the list, add to the end
-    current->next = newNode;
+    // order lives in the render queue, which sorts everything at once before the next paint
+    ye_entity_set_add(&component_sets[YE_COMPONENT_RENDERER], entity, entity->renderer);
+    ye_render_queue_dirty();
 }
 
 void ye_sort_renderer_entity_list_by_z(void){
-    struct ye_entity_node **list = &renderer_list_head;
-    
-    if(*list == NULL || (*list)->next == NULL) return; // if the list is empty or has only one element, it's already sorted
+    ye_render_queue_dirty();
+}
+
+void ye_entity_set_remove(struct ye_entity_set *set, struct ye_entity *entity){
+    if(set == NULL || entity == NULL)
+        return;
 
-    struct ye_entity_node *sorted = NULL;
+    int index = entity->_set_index[set->slot];
+    if(index < 0 || index >= set->count || set->entities[index] != entity)
+        return;
+
+    entity->_set_index[set->slot] = -1;
+    set->count--;
+
+    if(set->slot < YE_COMPONENT_COUNT)
+        entity->signature &= ~YE_COMPONENT_BIT(set->slot);
+    ecs_structure_version++;
+
+    // paint order lives in the render queue, the renderer set can swap like any other
+    if(set == &component_sets[YE_COMPONENT_RENDERER])
+        ye_render_queue_dirty();
+
+    // swap the last entity into the hole
+    if(index != set->count){
+        set->entities[index] = set->entities[set->count];
+        set->components[index] = set->components[set->count];
+        set->entities[index]->_set_index[set->slot] = index;
+    }
+}
+
+/////////////////////////// QUERIES ///////////////////////////
 
-    struct ye_entity_node *current = *list;
-    while(current != NULL){
-        struct ye_entity_node *next = current->next;
-        current->next = NULL;
+/*
+    One cache entry per mask ever queried. The match list is rebuilt lazily
+    the next time the mask is queried after the structure version moved on.
+*/
+struct ye_query_cache {
+    uint64_t mask;
+    struct ye_entity **entities;
+    int count;
+    int capacity;
+    unsigned int version;
+    bool built;
+    struct ye_query_cache *next;
+};
+
+static struct ye_query_cache *query_caches = NULL;
 
-        if(sorted == NULL || current->entity->renderer->z < sorted->entity->renderer->z){
-            current->next = sorted;
-            sorted = current;
+/*
+    Systems on worker threads may begin queries at the same time (see system.h),
+    they never change structure but can race to create/rebuild the same cache.
+*/
+static SDL_Mutex *query_lock = NULL;
+
+bool ye_entity_has_components(struct ye_entity *entity, uint64_t mask){
+    return entity != NULL && (entity->signature & mask) == mask;
+}
+
+static void _ye_query_cache_rebuild(struct ye_query_cache *cache){
+    // walk the smallest set involved, everything else is a signature check
+    struct ye_entity **candidates = entity_set.entities;
+    int candidate_count = entity_set.count;
+    for(int i = 0; i < YE_MAX_COMPONENT_TYPES; i++){
+        if(!(cache->mask & YE_COMPONENT_BIT(i)))
+            continue;
+
+        struct ye_entity **entities;
+        int count;
+        if(i < YE_COMPONENT_COUNT){
+            entities = component_sets[i].entities;
+            count = component_sets[i].count;
         }
         else{
-            struct ye_entity_node *temp = sorted;
-            while(temp->next != NULL && temp->next->entity->renderer->z <= current->entity->renderer->z){
-                temp = temp->next;
-            }
-            current->next = temp->next;
-            temp->next = current;
+            entities = ye_get_component_entities(i, &count);
+        }
+
+        if(count < candidate_count){
+            candidates = entities;
+            candidate_count = count;
         }
+    }
+
+    if(candidate_count > cache->capacity){
+        struct ye_entity **entities = realloc(cache->entities, sizeof(struct ye_entity *) * candidate_count);
+        if(entities == NULL){
+            ye_logf(error, "Failed to grow query cache to %d entries.\n", candidate_count);
+            cache->count = 0;
+            return;
+        }
+        cache->entities = entities;
+        cache->capacity = candidate_count;
+    }
 
-        current = next;
+    cache->count = 0;
+    for(int i = 0; i < candidate_count; i++){
+        struct ye_entity *entity = candidates[i];
+        if((entity->signature & cache->mask) == cache->mask)
+            cache->entities[cache->count++] = entity;
     }
 
-    *list = sorted;
+    cache->version = ecs_structure_version;
+    cache->built = true;
 }
 
-void ye_entity_list_remove(struct ye_entity_node **list, struct ye_entity *entity) {
-    struct ye_entity_node *current = *list;
-    struct ye_entity_node *prev = NULL;
+struct ye_query ye_query_begin(uint64_t mask){
+    struct ye_query query = { .mask = mask, ._cache = NULL, ._index = 0, ._version = ecs_structure_version };
 
-    while (current != NULL) {
-        if (current->entity == entity) {
-            if (prev == NULL) {
-                *list = current->next; // Update the head of the list
-            } else {
-                prev->next = current->next;
-            }
-            free(current);
-            return;
+    SDL_LockMutex(query_lock);
+
+    struct ye_query_cache *cache = query_caches;
+    while(cache != NULL && cache->mask != mask)
+        cache = cache->next;
+
+    if(cache == NULL){
+        cache = malloc(sizeof(struct ye_query_cache));
+        if(cache == NULL){
+            SDL_UnlockMutex(query_lock);
+            ye_logf(error, "Failed to allocate query cache.\n");
+            return query;
         }
-        prev = current;
-        current = current->next;
+        memset(cache, 0, sizeof(struct ye_query_cache));
+        cache->mask = mask;
+        cache->next = query_caches;
+        query_caches = cache;
     }
+
+    if(!cache->built || cache->version != ecs_structure_version)
+        _ye_query_cache_rebuild(cache);
+
+    SDL_UnlockMutex(query_lock);
+
+    query._cache = cache;
+    return query;
+}
+
+struct ye_entity * ye_query_next(struct ye_query *query){
+    if(query == NULL || query->_cache == NULL)
+        return NULL;
+
+    if(query->_version != ecs_structure_version){
+        ye_logf(warning, "ECS changed while iterating a query, stopping early. Use the deferred destroy/remove functions inside queries.\n");
+        query->_cache = NULL;
+        return NULL;
+    }
+
+    if(query->_index >= query->_cache->count)
+        return NULL;
+
+    return query->_cache->entities[query->_index++];
+}
+
+int ye_query_count(struct ye_query *query){
+    if(query == NULL || query->_cache == NULL)
+        return 0;
+    return query->_cache->count;
 }
 
-void ye_entity_list_destroy(struct ye_entity_node **list) {
-    while (*list != NULL) {
-        struct ye_entity_node *temp = *list;
-        *list = (*list)->next;
-        ye_destroy_entity(temp->entity);
-        free(temp);
+static void _ye_query_caches_free(void){
+    while(query_caches != NULL){
+        struct ye_query_cache *next = query_caches->next;
+        free(query_caches->entities);
+        free(query_caches);
+        query_caches = next;
     }
-    *list = NULL;
 }
 
 ///////////////////////////////////////////////////////////////
 
-struct ye_entity_node *entity_list_head;
-struct ye_entity_node *transform_list_head;
-struct ye_entity_node *renderer_list_head;
-struct ye_entity_node *camera_list_head;
-struct ye_entity_node *tag_list_head;
-struct ye_entity_node *audiosource_list_head;
-struct ye_entity_node *button_list_head;
-struct ye_entity_node *rigidbody_list_head;
+//////////////////////// NAME INDEX //////////////////////////
+
+/*
+    Multimap of name -> entities with that name, kept in sync by
+    create_named, rename and destroy. Each bucket keeps its entities
+    in the order they took the name, so the back is the newest.
+*/
+/*
+    Entity names are atoms (see types/intern.h), so the index is keyed by
+    the atom pointer itself and lookups from a plain string are one intern find.
+*/
+struct ye_entity_name_node {
+    const char *name;           // key (the atom, held by the entities)
+    struct ye_entity **entities;
+    int count;
+    int capacity;
+    UT_hash_handle hh;
+};
+
+static struct ye_entity_name_node *entity_names = NULL;
+
+static void _ye_name_index_add(struct ye_entity *entity){
+    if(entity->name == NULL)
+        return;
+
+    struct ye_entity_name_node *node = NULL;
+    HASH_FIND_PTR(entity_names, &entity->name, node);
+    if(node == NULL){
+        node = malloc(sizeof(struct ye_entity_name_node));
+        if(node == NULL){
+            ye_logf(error, "Failed to allocate name index entry for \"%s\".\n", entity->name);
+            return;
+        }
+        node->name = entity->name;
+        node->entities = NULL;
+        node->count = 0;
+        node->capacity = 0;
+        HASH_ADD_PTR(entity_names, name, node);
+    }
+
+    if(node->count >= node->capacity){
+        int capacity = node->capacity > 0 ? node->capacity * 2 : 1;
+        struct ye_entity **entities = realloc(node->entities, sizeof(struct ye_entity *) * capacity);
+        if(entities == NULL){
+            ye_logf(error, "Failed to grow name index entry for \"%s\".\n", entity->name);
+            return;
+        }
+        node->entities = entities;
+        node->capacity = capacity;
+    }
 
-struct ye_entity_node * ye_get_entity_list_head(){
-    return entity_list_head;
+    node->entities[node->count++] = entity;
 }
 
+static void _ye_name_index_remove(struct ye_entity *entity){
+    if(entity->name == NULL)
+        return;
+
+    struct ye_entity_name_node *node = NULL;
+    HASH_FIND_PTR(entity_names, &entity->name, node);
+    if(node == NULL)
+        return;
+
+    for(int i = 0; i < node->count; i++){
+        if(node->entities[i] == entity){
+            memmove(&node->entities[i], &node->entities[i + 1], sizeof(struct ye_entity *) * (node->count - i - 1));
+            node->count--;
+            break;
+        }
+    }
+
+    if(node->count == 0){
+        HASH_DEL(entity_names, node);
+        free(node->entities);
+        free(node);
+    }
+}
+
+//////////////////////// ALLOCATION //////////////////////////
+
+/*
+    Entities come from a pool, and their names are atoms (see types/intern.h)
+    shared with every other holder of the same string. Names must only ever
+    be changed through ye_rename_entity.
+*/
+#define YE_ENTITY_SHORT_NAME_LENGTH 32
+
+static struct ye_pool entity_pool = YE_POOL_INIT("entity", struct ye_entity, 1024);
+
 struct ye_entity * ye_create_entity(){
-    struct ye_entity *entity = malloc(sizeof(struct ye_entity));
-    entity->id = eid++; // assign unique id to entity
+    struct ye_entity *entity = ye_pool_alloc(&entity_pool);
+    _ye_entity_slot_acquire(entity); // assign an id (slot) to the entity
     entity->active = true;
 
     //name the entity "entity id"
-    char *name = malloc(sizeof(char) * 100);
-    snprintf(name, 100, "entity %d", entity->id);
-    entity->name = name;
+    char name[YE_ENTITY_SHORT_NAME_LENGTH];
+    snprintf(name, sizeof(name), "entity %d", entity->id);
+    entity->name = ye_intern(name);
+    _ye_name_index_add(entity);
+    entity->_name_label = NULL;
 
     // assign all copmponents to null
     entity->transform = NULL;
@@ -173,8 +499,12 @@ struct ye_entity * ye_create_entity(){
     entity->audiosource = NULL;
     entity->rigidbody = NULL;
 
-    // add the entity to the entity list
-    ye_entity_list_add(&entity_list_head, entity);
+    entity->signature = 0;
+    for(int i = 0; i < YE_COMPONENT_COUNT + 1; i++)
+        entity->_set_index[i] = -1;
+
+    // add the entity to the entity set
+    ye_entity_set_add(&entity_set, entity, NULL);
     // ye_logf(debug, "Created and added an entity\n");
 
     YE_STATE.runtime.entity_count++;
@@ -183,13 +513,13 @@ struct ye_entity * ye_create_entity(){
 }
 
 struct ye_entity * ye_create_entity_named(const char *name){
-    struct ye_entity *entity = malloc(sizeof(struct ye_entity));
-    entity->id = eid++; // assign unique id to entity
+    struct ye_entity *entity = ye_pool_alloc(&entity_pool);
+    _ye_entity_slot_acquire(entity); // assign an id (slot) to the entity
     entity->active = true;
 
     // name the entity by its passed name
-    entity->name = malloc(strlen(name) + 1);
-    strcpy(entity->name, name);
+    entity->name = ye_intern(name);
+    _ye_name_index_add(entity);
     
     // assign all copmponents to null
     entity->transform = NULL;
@@ -200,8 +530,12 @@ struct ye_entity * ye_create_entity_named(const char *name){
     entity->tag = NULL;
     entity->audiosource = NULL;
 
-    // add the entity to the entity list
-    ye_entity_list_add(&entity_list_head, entity);
+    entity->signature = 0;
+    for(int i = 0; i < YE_COMPONENT_COUNT + 1; i++)
+        entity->_set_index[i] = -1;
+
+    // add the entity to the entity set
+    ye_entity_set_add(&entity_set, entity, NULL);
     // ye_logf(debug, "Created and added an entity\n");
 
     YE_STATE.runtime.entity_count++;
@@ -211,11 +545,16 @@ struct ye_entity * ye_create_entity_named(const char *name){
 
 void ye_rename_entity(struct ye_entity *entity, const char *new_name){
     // free the old name
-    free(entity->name);
+    _ye_name_index_remove(entity);
+    ye_intern_release(entity->name);
 
     // name the entity by its passed name
-    entity->name = malloc(strlen(new_name) + 1);
-    strcpy(entity->name, new_name);
+    entity->name = ye_intern(new_name);
+    _ye_name_index_add(entity);
+
+    // the editor label still shows the old name, lay it out again next time it is shown
+    ye_text_layout_release(entity->_name_label);
+    entity->_name_label = NULL;
 }
 
 struct ye_entity * ye_duplicate_entity(struct ye_entity *entity){
@@ -239,38 +578,12 @@ struct ye_entity * ye_duplicate_entity(struct ye_entity *entity){
     if(entity->transform != NULL){
         ye_add_transform_component(new_entity, entity->transform->x, entity->transform->y);
         new_entity->transform->rotation = entity->transform->rotation;
+        if(entity->transform->parent)
+            ye_set_transform_parent(new_entity, entity->transform->parent);
     }
     if(entity->renderer != NULL){
-        if(entity->renderer->type == YE_RENDERER_TYPE_IMAGE){
-            ye_add_image_renderer_component(new_entity, entity->renderer->z, entity->renderer->renderer_impl.image->src);
-        }
-        else if(entity->renderer->type == YE_RENDERER_TYPE_TEXT){
-            ye_add_text_renderer_component(new_entity, entity->renderer->z, entity->renderer->renderer_impl.text->text, entity->renderer->renderer_impl.text->font_name, entity->renderer->renderer_impl.text->font_size, entity->renderer->renderer_impl.text->color_name, entity->renderer->renderer_impl.text->wrap_width);
-        }
-        else if(entity->renderer->type == YE_RENDERER_TYPE_TEXT_OUTLINED){
-            ye_add_text_outlined_renderer_component(new_entity, entity->renderer->z, entity->renderer->renderer_impl.text_outlined->text, entity->renderer->renderer_impl.text_outlined->font_name, entity->renderer->renderer_impl.text_outlined->font_size, entity->renderer->renderer_impl.text_outlined->color_name, entity->renderer->renderer_impl.text_outlined->outline_color_name, entity->renderer->renderer_impl.text_outlined->outline_size, entity->renderer->renderer_impl.text_outlined->wrap_width);
-        }
-        else if(entity->renderer->type == YE_RENDERER_TYPE_ANIMATION){
-            ye_add_animation_renderer_component(new_entity, entity->renderer->z, entity->renderer->renderer_impl.animation->meta_file);
-        }
-        else if (entity->renderer->type == YE_RENDERER_TYPE_TILEMAP_TILE) {
-			ye_add_tilemap_renderer_component(new_entity, entity->renderer->z, entity->renderer->renderer_impl.tile->handle, entity->renderer->renderer_impl.tile->src);
-        }
-
-        /*
-            Update any fields here that arent tracked by the constructor
-        */
-        new_entity->renderer->flipped_x = entity->renderer->flipped_x;
-        new_entity->renderer->flipped_y = entity->renderer->flipped_y;
-        new_entity->renderer->active = entity->renderer->active;
-        new_entity->renderer->rect = entity->renderer->rect;
-        new_entity->renderer->relative = entity->renderer->relative;
-        new_entity->renderer->rotation = entity->renderer->rotation;
-        new_entity->renderer->alpha = entity->renderer->alpha;
-        new_entity->renderer->alignment = entity->renderer->alignment;
-        new_entity->renderer->center = entity->renderer->center;
-        new_entity->renderer->preserve_original_size = entity->renderer->preserve_original_size;
-        new_entity->renderer->lock_aspect_ratio = entity->renderer->lock_aspect_ratio;
+        // shares the clip / laid out text instead of loading them again
+        ye_add_renderer_component_copy(new_entity, entity->renderer);
     }
     if(entity->camera != NULL){
         ye_add_camera_component(new_entity, entity->camera->z, entity->camera->view_field);
@@ -291,9 +604,9 @@ struct ye_entity * ye_duplicate_entity(struct ye_entity *entity){
     if(entity->tag != NULL){
         ye_add_tag_component(new_entity);
         for(int i = 0; i < YE_TAG_MAX_NUMBER; i++){
-            // we could iterate over the tags and add only non-empty,
-            // but this will achieve the same since we can just add empty tags.
-            ye_add_tag(new_entity, entity->tag->tags[i]);
+            if(entity->tag->tags[i] != YE_TAG_NONE){
+                ye_add_tag(new_entity, ye_tag_name(entity->tag->tags[i]));
+            }
         }
         new_entity->tag->active = entity->tag->active;
     }
@@ -303,6 +616,16 @@ struct ye_entity * ye_duplicate_entity(struct ye_entity *entity){
         new_entity->audiosource->relative = entity->audiosource->relative;
     }
 
+    // custom components are copied as plain bytes
+    for(int type = YE_COMPONENT_COUNT; type < YE_MAX_COMPONENT_TYPES; type++){
+        if(!(entity->signature & YE_COMPONENT_BIT(type)))
+            continue;
+
+        void *component = ye_add_component(new_entity, type);
+        if(component != NULL)
+            memcpy(component, ye_get_component(entity, type), ye_get_component_stride(type));
+    }
+
     return new_entity;
 }
 
@@ -312,8 +635,14 @@ void ye_destroy_entity(struct ye_entity * entity){
         return;
     }
 
-    // remove from the entity list (frees its node)
-    ye_entity_list_remove(&entity_list_head, entity);
+    // remove from the entity set
+    ye_entity_set_remove(&entity_set, entity);
+
+    // custom component storage is indexed by id, so clear it before the id is freed
+    ye_remove_custom_components(entity);
+
+    // free the id, invalidating any handles to this entity
+    _ye_entity_slot_release(entity);
 
     // check for non null components and free them
     if(entity->transform != NULL) ye_remove_transform_component(entity);
@@ -324,10 +653,13 @@ void ye_destroy_entity(struct ye_entity * entity){
     if(entity->button != NULL) ye_remove_button_component(entity);
     if(entity->audiosource != NULL) ye_remove_audiosource_component(entity);
     // free the entity name
-    free(entity->name);
+    _ye_name_index_remove(entity);
+    ye_intern_release(entity->name);
+    ye_text_layout_release(entity->_name_label);
+    entity->_name_label = NULL;
 
     // free the entity
-    free(entity);
+    ye_pool_free(&entity_pool, entity);
 
     entity = NULL;
 
@@ -336,48 +668,156 @@ void ye_destroy_entity(struct ye_entity * entity){
     YE_STATE.runtime.entity_count--;
 }
 
+struct ye_entity * ye_try_get_entity_by_name(const char *name){
+    if(name == NULL)
+        return NULL;
+
+    // nothing holds this string, so no entity can have it as a name
+    const char *atom = ye_intern_find(name);
+    if(atom == NULL)
+        return NULL;
+
+    struct ye_entity_name_node *node = NULL;
+    HASH_FIND_PTR(entity_names, &atom, node);
+    if(node == NULL || node->count == 0)
+        return NULL;
+
+    // newest first, same as the old head inserted list
+    return node->entities[node->count - 1];
+}
+
 struct ye_entity * ye_get_entity_by_name(const char *name){
-    struct ye_entity_node *current = entity_list_head;
+    struct ye_entity *entity = ye_try_get_entity_by_name(name);
+    if(entity == NULL){
+        ye_logf(error, "COULD NOT LOCATE ENTITY BY THE NAME \"%s\"\n",name);
+    }
+    return entity;
+}
 
-    while(current != NULL){
-        if(strcmp(current->entity->name, name) == 0){
-            return current->entity;
-        }
-        current = current->next;
+struct ye_entity *ye_get_entity_by_id(int id){
+    if(id >= 0 && id < entity_slot_count && entity_slots[id].entity != NULL){
+        return entity_slots[id].entity;
     }
 
-    ye_logf(error, "COULD NOT LOCATE ENTITY BY THE NAME \"%s\"\n",name);
+    ye_logf(error, "COULD NOT LOCATE ENTITY BY THE ID \"%d\"\n",id);
     return NULL;
 }
 
-struct ye_entity * ye_get_entity_by_tag(const char *tag){
-    struct ye_entity_node *current = tag_list_head;
+////////////////////// DEFERRED COMMANDS //////////////////////
 
-    while(current != NULL){
-        for(int i = 0; i < YE_TAG_MAX_NUMBER; i++){
-            if(strcmp(current->entity->tag->tags[i], tag) == 0){
-                return current->entity;
-            }
+/*
+    Structural changes queued during the frame. Entities are referenced by
+    handle so a command targeting an entity that already died (destroyed
+    twice, or destroyed before its component removal ran) just gets skipped.
+*/
+enum ye_deferred_command_type {
+    YE_DEFERRED_DESTROY_ENTITY,
+    YE_DEFERRED_REMOVE_COMPONENT
+};
+
+struct ye_deferred_command {
+    enum ye_deferred_command_type type;
+    struct ye_entity_handle handle;
+    enum ye_component_type component;
+};
+
+static struct ye_deferred_command *deferred_commands = NULL;
+static int deferred_command_count = 0;
+static int deferred_command_capacity = 0;
+
+static void _ye_push_deferred_command(struct ye_deferred_command command){
+    if(deferred_command_count >= deferred_command_capacity){
+        int capacity = deferred_command_capacity > 0 ? deferred_command_capacity * 2 : 64;
+        struct ye_deferred_command *commands = realloc(deferred_commands, sizeof(struct ye_deferred_command) * capacity);
+        if(commands == NULL){
+            ye_logf(error, "Failed to grow deferred command buffer to %d entries.\n", capacity);
+            return;
         }
-        current = current->next;
+        deferred_commands = commands;
+        deferred_command_capacity = capacity;
+    }
+    deferred_commands[deferred_command_count++] = command;
+}
+
+void ye_destroy_entity_deferred(struct ye_entity * entity){
+    if(entity == NULL){
+        ye_logf(warning, "Attempted to queue a null entity for destruction\n");
+        return;
     }
 
-    ye_logf(error, "COULD NOT LOCATE ENTITY BY THE TAG \"%s\"\n",tag);
-    return NULL;
+    _ye_push_deferred_command((struct ye_deferred_command){
+        .type = YE_DEFERRED_DESTROY_ENTITY,
+        .handle = ye_get_entity_handle(entity),
+    });
 }
 
-struct ye_entity *ye_get_entity_by_id(int id){
-    struct ye_entity_node *current = entity_list_head;
+void ye_remove_component_deferred(struct ye_entity * entity, enum ye_component_type type){
+    if(entity == NULL){
+        ye_logf(warning, "Attempted to queue a component removal on a null entity\n");
+        return;
+    }
 
-    while(current != NULL){
-        if(current->entity->id == id){
-            return current->entity;
-        }
-        current = current->next;
+    if(type < 0 || type >= YE_MAX_COMPONENT_TYPES){
+        ye_logf(error, "Attempted to queue removal of invalid component type %d\n", type);
+        return;
     }
 
-    ye_logf(error, "COULD NOT LOCATE ENTITY BY THE ID \"%d\"\n",id);
-    return NULL;
+    _ye_push_deferred_command((struct ye_deferred_command){
+        .type = YE_DEFERRED_REMOVE_COMPONENT,
+        .handle = ye_get_entity_handle(entity),
+        .component = type,
+    });
+}
+
+static void _ye_remove_component(struct ye_entity *entity, enum ye_component_type type){
+    switch(type){
+        case YE_COMPONENT_TRANSFORM:
+            if(entity->transform != NULL) ye_remove_transform_component(entity);
+            break;
+        case YE_COMPONENT_RENDERER:
+            if(entity->renderer != NULL) ye_remove_renderer_component(entity);
+            break;
+        case YE_COMPONENT_RIGIDBODY:
+            if(entity->rigidbody != NULL) ye_remove_rigidbody_component(entity);
+            break;
+        case YE_COMPONENT_AUDIOSOURCE:
+            if(entity->audiosource != NULL) ye_remove_audiosource_component(entity);
+            break;
+        case YE_COMPONENT_CAMERA:
+            if(entity->camera != NULL) ye_remove_camera_component(entity);
+            break;
+        case YE_COMPONENT_TAG:
+            if(entity->tag != NULL) ye_remove_tag_component(entity);
+            break;
+        case YE_COMPONENT_BUTTON:
+            if(entity->button != NULL) ye_remove_button_component(entity);
+            break;
+        default:
+            // custom component type
+            if(ye_has_component(entity, type)) ye_remove_component(entity, type);
+            break;
+    }
+}
+
+void ye_flush_deferred_commands(void){
+    // index based, commands queued by a destroy (ex: an event handler) land at the end and still run
+    for(int i = 0; i < deferred_command_count; i++){
+        struct ye_deferred_command command = deferred_commands[i];
+
+        struct ye_entity *entity = ye_get_entity_from_handle(command.handle);
+        if(entity == NULL)
+            continue; // already gone
+
+        switch(command.type){
+            case YE_DEFERRED_DESTROY_ENTITY:
+                ye_destroy_entity(entity);
+                break;
+            case YE_DEFERRED_REMOVE_COMPONENT:
+                _ye_remove_component(entity, command.component);
+                break;
+        }
+    }
+    deferred_command_count = 0;
 }
 
 /////////////////////////  SYSTEMS  ////////////////////////////
@@ -390,14 +830,11 @@ struct ye_entity *ye_get_entity_by_id(int id){
 
 
 void ye_init_ecs(){
-    entity_list_head = ye_entity_list_create();
-    transform_list_head = ye_entity_list_create();
-    renderer_list_head = ye_entity_list_create();
-    camera_list_head = ye_entity_list_create();
-    tag_list_head = ye_entity_list_create();
-    audiosource_list_head = ye_entity_list_create();
-    button_list_head = ye_entity_list_create();
-    rigidbody_list_head = ye_entity_list_create();
+    entity_set.slot = YE_COMPONENT_COUNT;
+    for(int i = 0; i < YE_COMPONENT_COUNT; i++){
+        component_sets[i].slot = i;
+    }
+    query_lock = SDL_CreateMutex();
     ye_logf(info, "Initialized ECS\n");
 }
 
@@ -408,49 +845,51 @@ void ye_purge_ecs(){
 }
 
 void ye_shutdown_ecs(){
-    ye_entity_list_destroy(&entity_list_head);
-    
-    /* 
-        destroy the other, now empty lists (all items are null)
+    // every entity is about to go away, nothing left to defer
+    deferred_command_count = 0;
 
-        this mainly consists of freeing the malloced nodes (2 pointers to ent and nxt)
-    */
+    _ye_query_caches_free();
+    SDL_DestroyMutex(query_lock);
+    query_lock = NULL;
 
-    ye_entity_list_destroy(&transform_list_head);
-    ye_entity_list_destroy(&renderer_list_head);
-    ye_entity_list_destroy(&camera_list_head);
-    ye_entity_list_destroy(&tag_list_head);
-    ye_entity_list_destroy(&audiosource_list_head);
-    ye_entity_list_destroy(&button_list_head);
-    ye_entity_list_destroy(&rigidbody_list_head);
+    // destroy from the back so removal never has to move anything
+    while(entity_set.count > 0){
+        ye_destroy_entity(entity_set.entities[entity_set.count - 1]);
+    }
+
+    /* 
+        free the dense arrays of the now empty sets
+    */
+    _ye_entity_set_free(&entity_set);
+    for(int i = 0; i < YE_COMPONENT_COUNT; i++){
+        _ye_entity_set_free(&component_sets[i]);
+    }
 
     // take care of cleaning up any entity pointers that exist in global state
     YE_STATE.engine.target_camera = NULL;
     YE_STATE.editor.scene_default_camera = NULL;
 
-    eid = 0;
+    _ye_entity_slots_reset();
 
     ye_logf(info, "Shut down ECS\n");
 }
 
 void ye_print_entities(){
-    struct ye_entity_node *current = entity_list_head;
     int i = 0;
-    while(current != NULL){
+    for(; i < entity_set.count; i++){
+        struct ye_entity *entity = entity_set.entities[i];
         char b[100];
         snprintf(b, sizeof(b), "\"%s\" -> ID:%d Trn:%d Rdr:%d Cam:%d Btn:%d RB:%d Tag:%d Aud:%d\n",
-            current->entity->name, current->entity->id, 
-            current->entity->transform != NULL, 
-            current->entity->renderer != NULL, 
-            current->entity->camera != NULL,
-            current->entity->button != NULL,
-            current->entity->rigidbody != NULL,
-            current->entity->tag != NULL,
-            current->entity->audiosource != NULL
+            entity->name, entity->id, 
+            entity->transform != NULL, 
+            entity->renderer != NULL, 
+            entity->camera != NULL,
+            entity->button != NULL,
+            entity->rigidbody != NULL,
+            entity->tag != NULL,
+            entity->audiosource != NULL
         );
         ye_logf(debug, b);
-        current = current->next;
-        i++;
     }
     ye_logf(debug, "Total entities: %d\n", i);
 }
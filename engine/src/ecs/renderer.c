@@ -5,11 +5,16 @@
     Licensed under the MIT license. See LICENSE file in the project root for details.
 */
 
+#include <math.h>
+#include <stdint.h>
 #include <string.h>
+#include <stdlib.h>
 
 #include <SDL_ttf.h>
 #include <jansson.h>
 
+#include <uthash/uthash.h>
+
 #include <yoyoengine/yep.h>
 #include <yoyoengine/json.h>
 #include <yoyoengine/cache.h>
@@ -18,6 +23,7 @@
 #include <yoyoengine/version.h>
 #include <yoyoengine/ecs/ecs.h>
 #include <yoyoengine/graphics.h>
+#include <yoyoengine/glyph_atlas.h>
 #include <yoyoengine/ui/overlays.h>
 #include <yoyoengine/ecs/camera.h>
 #include <yoyoengine/ecs/renderer.h>
@@ -27,54 +33,719 @@
 #include <yoyoengine/ecs/audiosource.h>
 
 #include <yoyoengine/types.h>
+#include <yoyoengine/types/pool.h>
+#include <yoyoengine/types/intern.h>
+#include <yoyoengine/types/affine.h>
+
+static struct ye_pool renderer_pool         = YE_POOL_INIT("renderer", struct ye_component_renderer, 1024);
+static struct ye_pool image_impl_pool       = YE_POOL_INIT("renderer image", struct ye_component_renderer_image, 1024);
+static struct ye_pool text_impl_pool        = YE_POOL_INIT("renderer text", struct ye_component_renderer_text, 128);
+static struct ye_pool text_outlined_impl_pool = YE_POOL_INIT("renderer text outlined", struct ye_component_renderer_text_outlined, 64);
+static struct ye_pool animation_impl_pool   = YE_POOL_INIT("renderer animation", struct ye_component_renderer_animation, 256);
+static struct ye_pool tile_impl_pool        = YE_POOL_INIT("renderer tile", struct ye_component_renderer_tilemap_tile, 1024);
+static struct ye_pool tile_layer_impl_pool  = YE_POOL_INIT("renderer tilemap layer", struct ye_component_renderer_tilemap_layer, 16);
+
+static struct ye_pool * _ye_renderer_impl_pool(enum ye_component_renderer_type type){
+    switch(type){
+        case YE_RENDERER_TYPE_IMAGE:            return &image_impl_pool;
+        case YE_RENDERER_TYPE_TEXT:             return &text_impl_pool;
+        case YE_RENDERER_TYPE_TEXT_OUTLINED:    return &text_outlined_impl_pool;
+        case YE_RENDERER_TYPE_ANIMATION:        return &animation_impl_pool;
+        case YE_RENDERER_TYPE_TILEMAP_TILE:     return &tile_impl_pool;
+        case YE_RENDERER_TYPE_TILEMAP_LAYER:    return &tile_layer_impl_pool;
+    }
+    return NULL;
+}
+
+void * ye_alloc_renderer_impl(enum ye_component_renderer_type type){
+    struct ye_pool *pool = _ye_renderer_impl_pool(type);
+    if(pool == NULL){
+        ye_logf(error, "Attempt to allocate invalid renderer type %d\n", type);
+        return NULL;
+    }
+    return ye_pool_alloc(pool);
+}
+
+/*
+    Spatial grid for culling
+
+    Renderers are bucketed by their world space AABB into a sparse grid of
+    YE_RENDER_GRID_CELL sized cells, so each frame only the cells under the
+    camera are visited instead of every renderer in the scene.
+
+    The grid is maintained incrementally: anything that moves a renderer
+    (transform changes, constructors, ye_renderer_bounds_changed) puts it on
+    the dirty list, and only dirty renderers are re-bucketed before the next
+    paint. Renderers that are painted also re-bucket themselves if their
+    bounds drifted without anyone telling us.
+
+    Renderers spanning too many cells (backgrounds, huge tilemaps) live in an
+    oversized list that every query visits.
+*/
+#define YE_RENDER_GRID_CELL 512.0f
+#define YE_RENDER_GRID_MAX_SPAN 16
+
+struct ye_render_grid_cell {
+    int64_t key;
+    struct ye_entity **entities;
+    int count;
+    int capacity;
+    UT_hash_handle hh;
+};
+
+struct ye_render_grid_list {
+    struct ye_entity **entities;
+    int count;
+    int capacity;
+};
+
+static struct ye_render_grid_cell *grid_cells = NULL;
+static struct ye_render_grid_list grid_oversized = {0};
+static struct ye_render_grid_list grid_dirty = {0};
+static struct ye_render_grid_list grid_candidates = {0};
+static unsigned int grid_stamp = 0;
+
+static int64_t _ye_grid_key(int cx, int cy){
+    return ((int64_t)cx << 32) | (uint32_t)cy;
+}
+
+static bool _ye_grid_list_push(struct ye_render_grid_list *list, struct ye_entity *entity){
+    if(list->count == list->capacity){
+        int capacity = list->capacity > 0 ? list->capacity * 2 : 64;
+        struct ye_entity **entities = realloc(list->entities, sizeof(struct ye_entity *) * capacity);
+        if(entities == NULL){
+            ye_logf(error, "Failed to grow renderer grid list.\n");
+            return false;
+        }
+        list->entities = entities;
+        list->capacity = capacity;
+    }
+    list->entities[list->count++] = entity;
+    return true;
+}
+
+// swap remove, order within a cell doesn't matter (queries sort by render queue order)
+static void _ye_grid_list_remove(struct ye_render_grid_list *list, struct ye_entity *entity){
+    for(int i = 0; i < list->count; i++){
+        if(list->entities[i] == entity){
+            list->entities[i] = list->entities[--list->count];
+            return;
+        }
+    }
+}
+
+static void _ye_grid_cell_add(int cx, int cy, struct ye_entity *entity){
+    int64_t key = _ye_grid_key(cx, cy);
+    struct ye_render_grid_cell *cell = NULL;
+    HASH_FIND(hh, grid_cells, &key, sizeof(int64_t), cell);
+    if(cell == NULL){
+        cell = calloc(1, sizeof(struct ye_render_grid_cell));
+        if(cell == NULL){
+            ye_logf(error, "Failed to allocate renderer grid cell.\n");
+            return;
+        }
+        cell->key = key;
+        HASH_ADD(hh, grid_cells, key, sizeof(int64_t), cell);
+    }
+
+    // a cell is just a list, reuse the list helpers on its fields
+    struct ye_render_grid_list list = {cell->entities, cell->count, cell->capacity};
+    _ye_grid_list_push(&list, entity);
+    cell->entities = list.entities;
+    cell->count = list.count;
+    cell->capacity = list.capacity;
+}
+
+static void _ye_grid_cell_remove(int cx, int cy, struct ye_entity *entity){
+    int64_t key = _ye_grid_key(cx, cy);
+    struct ye_render_grid_cell *cell = NULL;
+    HASH_FIND(hh, grid_cells, &key, sizeof(int64_t), cell);
+    if(cell == NULL)
+        return;
+
+    struct ye_render_grid_list list = {cell->entities, cell->count, cell->capacity};
+    _ye_grid_list_remove(&list, entity);
+    cell->count = list.count;
+
+    // drop empty cells so roaming entities don't leave a trail behind
+    if(cell->count == 0){
+        HASH_DEL(grid_cells, cell);
+        free(cell->entities);
+        free(cell);
+    }
+}
+
+static void _ye_grid_unplace(struct ye_entity *entity){
+    struct ye_component_renderer *rend = entity->renderer;
+    if(!rend->_grid_placed)
+        return;
+
+    if(rend->_grid_oversized){
+        _ye_grid_list_remove(&grid_oversized, entity);
+    }
+    else{
+        for(int cy = rend->_grid_y0; cy <= rend->_grid_y1; cy++)
+            for(int cx = rend->_grid_x0; cx <= rend->_grid_x1; cx++)
+                _ye_grid_cell_remove(cx, cy, entity);
+    }
+    rend->_grid_placed = false;
+}
+
+// put a renderer in the cells covering its world AABB, moving it only if the cells changed
+static void _ye_grid_place(struct ye_entity *entity, struct ye_rectf aabb){
+    struct ye_component_renderer *rend = entity->renderer;
+
+    int x0 = (int)floorf(aabb.x / YE_RENDER_GRID_CELL);
+    int y0 = (int)floorf(aabb.y / YE_RENDER_GRID_CELL);
+    int x1 = (int)floorf((aabb.x + aabb.w) / YE_RENDER_GRID_CELL);
+    int y1 = (int)floorf((aabb.y + aabb.h) / YE_RENDER_GRID_CELL);
+    bool oversized = (x1 - x0) >= YE_RENDER_GRID_MAX_SPAN || (y1 - y0) >= YE_RENDER_GRID_MAX_SPAN;
+
+    if(rend->_grid_placed){
+        if(oversized && rend->_grid_oversized)
+            return;
+        if(!oversized && !rend->_grid_oversized &&
+            x0 == rend->_grid_x0 && y0 == rend->_grid_y0 &&
+            x1 == rend->_grid_x1 && y1 == rend->_grid_y1)
+            return;
+        _ye_grid_unplace(entity);
+    }
+
+    rend->_grid_x0 = x0;
+    rend->_grid_y0 = y0;
+    rend->_grid_x1 = x1;
+    rend->_grid_y1 = y1;
+    rend->_grid_oversized = oversized;
+    rend->_grid_placed = true;
+
+    if(oversized){
+        _ye_grid_list_push(&grid_oversized, entity);
+    }
+    else{
+        for(int cy = y0; cy <= y1; cy++)
+            for(int cx = x0; cx <= x1; cx++)
+                _ye_grid_cell_add(cx, cy, entity);
+    }
+}
+
+// forget a renderer entirely (component removed)
+static void _ye_grid_forget(struct ye_entity *entity){
+    struct ye_component_renderer *rend = entity->renderer;
+    _ye_grid_unplace(entity);
+
+    int i = rend->_grid_dirty_index;
+    if(i >= 0){
+        struct ye_entity *last = grid_dirty.entities[--grid_dirty.count];
+        grid_dirty.entities[i] = last;
+        last->renderer->_grid_dirty_index = i;
+        rend->_grid_dirty_index = -1;
+    }
+}
+
+static void _ye_grid_reset_fields(struct ye_component_renderer *rend){
+    rend->_grid_placed = false;
+    rend->_grid_oversized = false;
+    rend->_grid_dirty_index = -1;
+    rend->_grid_stamp = 0;
+}
+
+void ye_renderer_bounds_changed(struct ye_entity *entity){
+    if(entity == NULL || entity->renderer == NULL || entity->renderer->_grid_dirty_index >= 0)
+        return;
+
+    if(_ye_grid_list_push(&grid_dirty, entity))
+        entity->renderer->_grid_dirty_index = grid_dirty.count - 1;
+}
+
+static void _ye_grid_shutdown(void){
+    struct ye_render_grid_cell *cell, *tmp;
+    HASH_ITER(hh, grid_cells, cell, tmp){
+        HASH_DEL(grid_cells, cell);
+        free(cell->entities);
+        free(cell);
+    }
+    free(grid_oversized.entities);
+    free(grid_dirty.entities);
+    free(grid_candidates.entities);
+    grid_oversized = (struct ye_render_grid_list){0};
+    grid_dirty = (struct ye_render_grid_list){0};
+    grid_candidates = (struct ye_render_grid_list){0};
+}
+
+/*
+    Render queue
+
+    Paint order is (z, texture, creation order). Instead of keeping the
+    renderer set sorted on every insert (quadratic when a scene loads
+    thousands of tiles), anything that could change the order just marks
+    the queue dirty, and the whole queue is radix sorted once before the
+    next paint. Grouping by texture inside a z keeps sprites of the same
+    texture adjacent, so they end up in the same batch.
+
+    Texture ids are handed out the first time the queue sees a texture, so
+    the order is the same from run to run (unlike sorting by pointer).
+*/
+struct ye_render_queue_item {
+    uint64_t key;           // biased z in the high half, texture id in the low half
+    unsigned int seq;       // creation order, least significant
+    struct ye_entity *entity;
+};
+
+struct ye_render_texture_id {
+    SDL_Texture *texture;
+    uint32_t id;
+    UT_hash_handle hh;
+};
+
+static struct ye_render_queue_item *render_queue = NULL;
+static struct ye_render_queue_item *render_queue_scratch = NULL;
+static int render_queue_capacity = 0;
+static bool render_queue_is_dirty = true;
+static unsigned int render_queue_seq = 0;
+
+static struct ye_render_texture_id *render_texture_ids = NULL;
+static uint32_t render_texture_next_id = 0;
+
+void ye_render_queue_dirty(void){
+    render_queue_is_dirty = true;
+}
+
+void ye_set_renderer_z(struct ye_entity *entity, int z){
+    if(entity == NULL || entity->renderer == NULL){
+        ye_logf(error, "Could not set renderer z, entity or renderer is NULL.\n");
+        return;
+    }
+
+    if(entity->renderer->z != z){
+        entity->renderer->z = z;
+        render_queue_is_dirty = true;
+    }
+}
+
+static uint32_t _ye_render_texture_id(SDL_Texture *texture){
+    struct ye_render_texture_id *node = NULL;
+    HASH_FIND_PTR(render_texture_ids, &texture, node);
+    if(node != NULL)
+        return node->id;
+
+    node = malloc(sizeof(struct ye_render_texture_id));
+    if(node == NULL)
+        return 0;
+    node->texture = texture;
+    node->id = render_texture_next_id++;
+    HASH_ADD_PTR(render_texture_ids, texture, node);
+    return node->id;
+}
+
+static void _ye_render_texture_ids_clear(void){
+    struct ye_render_texture_id *node, *tmp;
+    HASH_ITER(hh, render_texture_ids, node, tmp){
+        HASH_DEL(render_texture_ids, node);
+        free(node);
+    }
+    render_texture_next_id = 0;
+}
+
+static unsigned int _ye_render_queue_digit(const struct ye_render_queue_item *item, int pass){
+    if(pass < 4)
+        return (item->seq >> (pass * 8)) & 0xFF;
+    return (unsigned int)(item->key >> ((pass - 4) * 8)) & 0xFF;
+}
+
+/*
+    LSD radix sort, one byte at a time from the least significant (seq)
+    to the most significant (z). Every pass is stable, so the result is
+    ordered by the full (key, seq). Passes where every item has the same
+    byte (ex: the high bytes of z) are skipped.
+*/
+static void _ye_render_queue_sort(int count){
+    struct ye_render_queue_item *src = render_queue;
+    struct ye_render_queue_item *dst = render_queue_scratch;
+
+    for(int pass = 0; pass < 12; pass++){
+        int histogram[256] = {0};
+        for(int i = 0; i < count; i++)
+            histogram[_ye_render_queue_digit(&src[i], pass)]++;
+
+        if(histogram[_ye_render_queue_digit(&src[0], pass)] == count)
+            continue;
+
+        int offset = 0;
+        for(int b = 0; b < 256; b++){
+            int n = histogram[b];
+            histogram[b] = offset;
+            offset += n;
+        }
+
+        for(int i = 0; i < count; i++)
+            dst[histogram[_ye_render_queue_digit(&src[i], pass)]++] = src[i];
+
+        struct ye_render_queue_item *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    // make sure the sorted result ends up in render_queue
+    if(src != render_queue)
+        memcpy(render_queue, src, sizeof(struct ye_render_queue_item) * count);
+}
+
+static void _ye_render_queue_rebuild(void){
+    struct ye_entity_set *set = ye_get_component_set(YE_COMPONENT_RENDERER);
+    int count = set->count;
+
+    if(count > render_queue_capacity){
+        int capacity = render_queue_capacity > 0 ? render_queue_capacity : 256;
+        while(capacity < count)
+            capacity *= 2;
+
+        struct ye_render_queue_item *queue = realloc(render_queue, sizeof(struct ye_render_queue_item) * capacity);
+        if(queue == NULL){
+            ye_logf(error, "Failed to grow render queue to %d entries.\n", capacity);
+            return;
+        }
+        render_queue = queue;
+
+        struct ye_render_queue_item *scratch = realloc(render_queue_scratch, sizeof(struct ye_render_queue_item) * capacity);
+        if(scratch == NULL){
+            ye_logf(error, "Failed to grow render queue to %d entries.\n", capacity);
+            return;
+        }
+        render_queue_scratch = scratch;
+
+        render_queue_capacity = capacity;
+    }
+
+    // text textures come and go, don't let ids for dead textures pile up forever
+    if(HASH_COUNT(render_texture_ids) > (unsigned int)count * 2 + 1024)
+        _ye_render_texture_ids_clear();
+
+    for(int i = 0; i < count; i++){
+        struct ye_entity *entity = set->entities[i];
+        struct ye_component_renderer *rend = entity->renderer;
+        rend->_queue_z = rend->z;
+
+        // flip the sign bit so negative z's sort below positive ones as unsigned
+        uint64_t z = (uint32_t)rend->z ^ 0x80000000u;
+        render_queue[i].key = (z << 32) | _ye_render_texture_id(rend->texture);
+        render_queue[i].seq = rend->_queue_seq;
+        render_queue[i].entity = entity;
+    }
+
+    if(count > 1)
+        _ye_render_queue_sort(count);
+
+    for(int i = 0; i < count; i++)
+        render_queue[i].entity->renderer->_queue_index = i;
+
+    render_queue_is_dirty = false;
+}
+
+static void _ye_render_queue_shutdown(void){
+    _ye_render_texture_ids_clear();
+
+    free(render_queue);
+    free(render_queue_scratch);
+    render_queue = NULL;
+    render_queue_scratch = NULL;
+    render_queue_capacity = 0;
+    render_queue_is_dirty = true;
+}
+
+/*
+    Text renderers don't own a texture, their string is laid out into quads
+    of the shared glyph atlas (see glyph_atlas.h). Layouts come from the
+    cache, so every renderer showing the same text holds the same one.
+*/
+static struct ye_text_layout * _ye_text_layout_of(struct ye_component_renderer *renderer){
+    if(renderer->type == YE_RENDERER_TYPE_TEXT)
+        return renderer->renderer_impl.text->layout;
+    if(renderer->type == YE_RENDERER_TYPE_TEXT_OUTLINED)
+        return renderer->renderer_impl.text_outlined->layout;
+    return NULL;
+}
+
+// lay a text renderer's string out again with its current text, font and wrap
+static void _ye_text_relayout(struct ye_component_renderer *renderer){
+    struct ye_text_layout **layout;
+    if(renderer->type == YE_RENDERER_TYPE_TEXT){
+        struct ye_component_renderer_text *text = renderer->renderer_impl.text;
+        ye_text_layout_release(text->layout); // copies of this renderer keep theirs
+        text->layout = ye_text(text->text, text->font, 0, text->wrap_width);
+        layout = &text->layout;
+    }
+    else{
+        struct ye_component_renderer_text_outlined *text = renderer->renderer_impl.text_outlined;
+        ye_text_layout_release(text->layout);
+        text->layout = ye_text(text->text, text->font, text->outline_size, text->wrap_width);
+        layout = &text->layout;
+    }
+
+    // the first glyph page is what the renderer sorts and batches by, most text only touches one
+    renderer->texture = (*layout != NULL && (*layout)->quad_count > 0) ? (*layout)->quads[0].texture : NULL;
+    renderer->_uv = (SDL_FRect){0, 0, 1, 1};
+}
+
+/*
+    Animation clips are cached by meta file while anything holds them, so
+    spawning many of the same animation parses its meta file once.
+*/
+struct ye_animation_clip_node {
+    struct ye_animation_clip clip;  // first, so a clip pointer is its node
+    bool cached;                    // still in the table (false once forgotten)
+    UT_hash_handle hh;
+};
+
+static struct ye_animation_clip_node *animation_clips = NULL;
+
+static struct ye_animation_clip_node * _ye_animation_clip_load(const char *meta_file){
+    // load the meta file
+    json_t *META = NULL;
+    if(YE_STATE.editor.editor_mode)
+        META = ye_json_read(ye_path_resources(meta_file));
+    else
+        META = yep_resource_json(meta_file);
+    
+    if(META == NULL){
+        ye_logf(error, "Failed to load animation meta file %s\n", meta_file);
+        return NULL;
+    }
+
+    // version of the file
+    int version; ye_json_int(META, "version", &version);
+    if(version != YOYO_ENGINE_ANIMATION_FILE_VERSION){
+        ye_logf(error, "Invalid animation meta file version %d against %d\n", version, YOYO_ENGINE_ANIMATION_FILE_VERSION);
+        json_decref(META);
+        return NULL;
+    }
+
+    // source location of the map    
+    const char *path = NULL; 
+    if(!ye_json_string(META, "src", &path)){
+        ye_logf(error, "Failed to load SRC from animation meta file %s\n", meta_file);
+        json_decref(META);
+        return NULL;
+    }
+
+    // size of each frame
+    int frame_width;
+    if(!ye_json_int(META, "frame_width", &frame_width)){
+        ye_logf(error, "Failed to load frame_width from animation meta file %s\n", meta_file);
+        json_decref(META);
+        return NULL;
+    }
+    int frame_height;
+    if(!ye_json_int(META, "frame_height", &frame_height)){
+        ye_logf(error, "Failed to load frame_height from animation meta file %s\n", meta_file);
+        json_decref(META);
+        return NULL;
+    }
+
+    // number of frames
+    int frame_count;
+    if(!ye_json_int(META, "frame_count", &frame_count)){
+        ye_logf(error, "Failed to load frame_count from animation meta file %s\n", meta_file);
+        json_decref(META);
+        return NULL;
+    }
+
+    // frame delay
+    int frame_delay;
+    if(!ye_json_int(META, "frame_delay", &frame_delay)){
+        ye_logf(error, "Failed to load frame_delay from animation meta file %s\n", meta_file);
+        json_decref(META);
+        return NULL;
+    }
+
+    // loops
+    int loops;
+    if(!ye_json_int(META, "loops", &loops)){
+        ye_logf(error, "Failed to load loops from animation meta file %s\n", meta_file);
+        json_decref(META);
+        return NULL;
+    }
+
+    struct ye_animation_clip_node *node = calloc(1, sizeof(struct ye_animation_clip_node));
+    if(node == NULL){
+        ye_logf(error, "Failed to allocate animation clip for %s\n", meta_file);
+        json_decref(META);
+        return NULL;
+    }
+
+    // optional per frame delays, used instead of frame_delay
+    node->clip.duration = SDL_max(frame_delay, 1) * frame_count;
+    if(ye_json_has_key(META, "frame_delays")){
+        json_t *delays = NULL;
+        ye_json_array(META, "frame_delays", &delays);
+        if(delays == NULL || frame_count <= 0 || json_array_size(delays) != (size_t)frame_count){
+            ye_logf(warning, "frame_delays in animation meta file %s must have frame_count entries, using frame_delay\n", meta_file);
+        }
+        else if((node->clip.frame_ends = malloc(sizeof(int) * frame_count)) != NULL){
+            int end = 0;
+            for(int i = 0; i < frame_count; i++){
+                int delay = frame_delay;
+                ye_json_arr_int(delays, i, &delay);
+                end += SDL_max(delay, 1);
+                node->clip.frame_ends[i] = end;
+            }
+            node->clip.duration = end;
+        }
+    }
+    node->clip.meta_file = ye_intern(meta_file);
+    node->clip.src = ye_intern(path);
+    node->clip.frame_width = frame_width;
+    node->clip.frame_height = frame_height;
+    node->clip.frame_count = frame_count;
+    node->clip.frame_delay = frame_delay;
+    node->clip.loops = loops;
+
+    // free the meta file
+    json_decref(META);
+    return node;
+}
+
+struct ye_animation_clip * ye_animation_clip_acquire(const char *meta_file){
+    if(meta_file == NULL)
+        return NULL;
+
+    struct ye_animation_clip_node *node = NULL;
+    HASH_FIND_STR(animation_clips, meta_file, node);
+    if(node == NULL){
+        node = _ye_animation_clip_load(meta_file);
+        if(node == NULL)
+            return NULL;
+        node->cached = true;
+        HASH_ADD_KEYPTR(hh, animation_clips, node->clip.meta_file, strlen(node->clip.meta_file), node);
+    }
+
+    node->clip.refcount++;
+    return &node->clip;
+}
+
+void ye_animation_clip_release(struct ye_animation_clip *clip){
+    if(clip == NULL || --clip->refcount > 0)
+        return;
+
+    struct ye_animation_clip_node *node = (struct ye_animation_clip_node *)clip;
+    if(node->cached)
+        HASH_DEL(animation_clips, node);
+
+    ye_intern_release(clip->meta_file);
+    ye_intern_release(clip->src);
+    free(clip->frame_ends);
+    free(node);
+}
+
+// stop handing out the current clip for a meta file, holders keep it until they release
+static void _ye_animation_clip_forget(const char *meta_file){
+    struct ye_animation_clip_node *node = NULL;
+    HASH_FIND_STR(animation_clips, meta_file, node);
+    if(node != NULL){
+        HASH_DEL(animation_clips, node);
+        node->cached = false;
+    }
+}
+
+// remember the tile texture size, the tile's uvs are computed from it every frame
+static void _ye_tile_cache_texture_size(struct ye_component_renderer *renderer){
+    float w = 0, h = 0;
+    SDL_GetTextureSize(renderer->texture, &w, &h);
+    renderer->renderer_impl.tile->_texture_w = w;
+    renderer->renderer_impl.tile->_texture_h = h;
+}
+
+/*
+    Tilemap layers
+
+    The tile grid is cut into chunks of whole tiles, each baked into its own
+    render target. Baking is lazy: a chunk is only drawn into the first time
+    it is on screen after one of its tiles changed, so editing a tile costs
+    one chunk bake, and an untouched map costs one quad per visible chunk.
+*/
+static void _ye_tilemap_layer_free_chunks(struct ye_component_renderer_tilemap_layer *layer){
+    if(layer->chunks == NULL)
+        return;
+
+    for(int i = 0; i < layer->chunk_cols * layer->chunk_rows; i++){
+        if(layer->chunks[i].texture != NULL){
+            ye_untrack_texture_state(layer->chunks[i].texture);
+            SDL_DestroyTexture(layer->chunks[i].texture);
+        }
+    }
+    free(layer->chunks);
+    layer->chunks = NULL;
+    layer->chunk_cols = 0;
+    layer->chunk_rows = 0;
+}
+
+// (re)cut a layer into chunks, every chunk starts out needing a bake
+static void _ye_tilemap_layer_init_chunks(struct ye_component_renderer_tilemap_layer *layer){
+    _ye_tilemap_layer_free_chunks(layer);
+
+    layer->chunk_tiles_x = SDL_clamp(YE_TILEMAP_CHUNK_PIXELS / layer->tile_w, 1, layer->cols);
+    layer->chunk_tiles_y = SDL_clamp(YE_TILEMAP_CHUNK_PIXELS / layer->tile_h, 1, layer->rows);
+    int chunk_cols = (layer->cols + layer->chunk_tiles_x - 1) / layer->chunk_tiles_x;
+    int chunk_rows = (layer->rows + layer->chunk_tiles_y - 1) / layer->chunk_tiles_y;
+
+    layer->chunks = calloc((size_t)chunk_cols * chunk_rows, sizeof(struct ye_tilemap_chunk));
+    if(layer->chunks == NULL){
+        ye_logf(error, "Failed to allocate %dx%d tilemap chunks.\n", chunk_cols, chunk_rows);
+        return;
+    }
+    layer->chunk_cols = chunk_cols;
+    layer->chunk_rows = chunk_rows;
+
+    for(int i = 0; i < chunk_cols * chunk_rows; i++)
+        layer->chunks[i].dirty = true;
+}
+
+// chunks sample the tileset at 1:1, so it gets its own texture instead of an atlas region
+static void _ye_tilemap_layer_load_tileset(struct ye_component_renderer *renderer){
+    struct ye_component_renderer_tilemap_layer *layer = renderer->renderer_impl.tilemap_layer;
+
+    renderer->texture = ye_image(layer->tileset);
+    renderer->_uv = (SDL_FRect){0, 0, 1, 1};
+
+    float w = 0, h = 0;
+    SDL_GetTextureSize(renderer->texture, &w, &h);
+    layer->tileset_cols = SDL_max(1, (int)w / layer->tile_w);
+}
 
 void ye_update_renderer_component(struct ye_entity *entity){
     /*The purpose of this function is to be invoked when we know we have changed some internal variables of the renderer, and need to recompute the outputted texture*/
     switch(entity->renderer->type){
-        case YE_RENDERER_TYPE_IMAGE:
-            entity->renderer->texture = ye_image(
-                entity->renderer->renderer_impl.image->src
-            );
+        case YE_RENDERER_TYPE_IMAGE: {
+            struct ye_image_region region = ye_image_atlased(entity->renderer->renderer_impl.image->src);
+            entity->renderer->texture = region.texture;
+            entity->renderer->_uv = region.uv;
             break;
+        }
         case YE_RENDERER_TYPE_TEXT:
-            // destroy old text texture (not managed in cache)
-            if(entity->renderer->texture != NULL){
-                SDL_DestroyTexture(entity->renderer->texture);
-                entity->renderer->texture = NULL;
-            }
-
             // fetch new colors and fonts from cache
             entity->renderer->renderer_impl.text->font = ye_font(entity->renderer->renderer_impl.text->font_name, entity->renderer->renderer_impl.text->font_size);
             entity->renderer->renderer_impl.text->color = ye_color(entity->renderer->renderer_impl.text->color_name);
 
-            // create new text texture
-            if(entity->renderer->renderer_impl.text->wrap_width > 0)
-                entity->renderer->texture = createTextTextureWrapped(entity->renderer->renderer_impl.text->text, entity->renderer->renderer_impl.text->font, entity->renderer->renderer_impl.text->color, entity->renderer->renderer_impl.text->wrap_width);
-            else
-                entity->renderer->texture = createTextTexture(entity->renderer->renderer_impl.text->text, entity->renderer->renderer_impl.text->font, entity->renderer->renderer_impl.text->color);
+            _ye_text_relayout(entity->renderer);
             break;
         case YE_RENDERER_TYPE_TEXT_OUTLINED:
-            // destroy old text texture (not managed in cache)
-            if(entity->renderer->texture != NULL){
-                SDL_DestroyTexture(entity->renderer->texture);
-                entity->renderer->texture = NULL;
-            }
-
             // fetch new colors and fonts from cache
             entity->renderer->renderer_impl.text_outlined->font = ye_font(entity->renderer->renderer_impl.text_outlined->font_name, entity->renderer->renderer_impl.text_outlined->font_size);
             entity->renderer->renderer_impl.text_outlined->color = ye_color(entity->renderer->renderer_impl.text_outlined->color_name);
             entity->renderer->renderer_impl.text_outlined->outline_color = ye_color(entity->renderer->renderer_impl.text_outlined->outline_color_name);
 
-            // create new text texture
-            if(entity->renderer->renderer_impl.text_outlined->wrap_width > 0)
-                entity->renderer->texture = createTextTextureWithOutlineWrapped(entity->renderer->renderer_impl.text_outlined->text, entity->renderer->renderer_impl.text_outlined->outline_size, entity->renderer->renderer_impl.text_outlined->font, entity->renderer->renderer_impl.text_outlined->color, entity->renderer->renderer_impl.text_outlined->outline_color, entity->renderer->renderer_impl.text_outlined->wrap_width);
-            else
-                entity->renderer->texture = createTextTextureWithOutline(entity->renderer->renderer_impl.text_outlined->text, entity->renderer->renderer_impl.text_outlined->outline_size, entity->renderer->renderer_impl.text_outlined->font, entity->renderer->renderer_impl.text_outlined->color, entity->renderer->renderer_impl.text_outlined->outline_color);
+            _ye_text_relayout(entity->renderer);
             break;
-        case YE_RENDERER_TYPE_TILEMAP_TILE:
-            entity->renderer->texture = ye_image(
-                entity->renderer->renderer_impl.tile->handle
-            );
+        case YE_RENDERER_TYPE_TILEMAP_TILE: {
+            struct ye_image_region region = ye_image_atlased(entity->renderer->renderer_impl.tile->handle);
+            entity->renderer->texture = region.texture;
+            entity->renderer->_uv = region.uv;
+            _ye_tile_cache_texture_size(entity->renderer);
+            break;
+        }
+        case YE_RENDERER_TYPE_TILEMAP_LAYER:
+            // the tileset might be a different image now, bake every chunk again from it
+            _ye_tilemap_layer_load_tileset(entity->renderer);
+            _ye_tilemap_layer_init_chunks(entity->renderer->renderer_impl.tilemap_layer);
             break;
         default: ; // this semicolon fixes a mingw complaint
             // try to open new meta file and get out "src" field
@@ -107,16 +778,22 @@ void ye_update_renderer_component(struct ye_entity *entity){
             }
 
             // if we made it here, the proposed change exists, so delete and re add the animator component with the same z
-            char *meta_file = strdup(entity->renderer->renderer_impl.animation->meta_file);
+            const char *meta_file = ye_intern_retain(entity->renderer->renderer_impl.animation->meta_file);
             int z = entity->renderer->z;
 
+            // the meta file changed, don't hand out the old clip anymore
+            _ye_animation_clip_forget(meta_file);
+
             ye_remove_renderer_component(entity);
             ye_add_animation_renderer_component(entity, z, meta_file);
 
             json_decref(META);
-            free(meta_file);
+            ye_intern_release(meta_file);
             break;
     }
+
+    // new texture or text can mean new bounds
+    ye_renderer_bounds_changed(entity);
 }
 
 void ye_add_renderer_component(
@@ -127,8 +804,7 @@ void ye_add_renderer_component(
     void *data
     ){
 
-    entity->renderer = malloc(sizeof(struct ye_component_renderer));
-    memset(entity->renderer, 0, sizeof(struct ye_component_renderer));
+    entity->renderer = ye_pool_alloc(&renderer_pool);
     entity->renderer->active = true;
     entity->renderer->type = type;
     entity->renderer->alpha = 255; // by default renderer is fully opaque
@@ -144,6 +820,10 @@ void ye_add_renderer_component(
     entity->renderer->alignment = YE_ALIGN_MID_CENTER;  // default alignment is mid center
     entity->renderer->preserve_original_size = false;   // default is to grow to fit
     entity->renderer->relative = true;                  // default is relative positioning
+    entity->renderer->_uv = (SDL_FRect){0, 0, 1, 1};    // whole texture unless set from an atlas
+    _ye_grid_reset_fields(entity->renderer);
+    entity->renderer->_world_valid = false;
+    entity->renderer->_queue_seq = render_queue_seq++;
 
     if(type == YE_RENDERER_TYPE_IMAGE){
         entity->renderer->renderer_impl.image = data;
@@ -160,42 +840,45 @@ void ye_add_renderer_component(
     else if(type == YE_RENDERER_TYPE_TILEMAP_TILE){
         entity->renderer->renderer_impl.tile = data;
     }
+    else if(type == YE_RENDERER_TYPE_TILEMAP_LAYER){
+        entity->renderer->renderer_impl.tilemap_layer = data;
+    }
     else{
         ye_logf(error, "Attempt add Invalid renderer type %d\n", type);
     }
 
-    // add this entity to the renderer component list
-    ye_entity_list_add_sorted_renderer_z(&renderer_list_head, entity);
+    // add this entity to the renderer component set
+    ye_entity_set_add_sorted_renderer_z(entity);
+
+    // bounds aren't known until the constructor is done, the grid places it before the next paint
+    ye_renderer_bounds_changed(entity);
 
     // log that we added a renderer and to what ID
     // ye_logf(debug, "Added renderer to entity %d\n", entity->id);
 }
 
 void ye_add_image_renderer_component(struct ye_entity *entity, int z, const char *src){
-    struct ye_component_renderer_image *image = malloc(sizeof(struct ye_component_renderer_image));
-    memset(image, 0, sizeof(struct ye_component_renderer_image));
-    // copy src to image->src
-    image->src = malloc(sizeof(char) * (strlen(src) + 1));
-    strcpy(image->src, src);
+    struct ye_component_renderer_image *image = ye_alloc_renderer_impl(YE_RENDERER_TYPE_IMAGE);
+    image->src = ye_intern(src);
 
     // create the renderer top level
     ye_add_renderer_component(entity, YE_RENDERER_TYPE_IMAGE, z, image);
 
-    // create the image texture
-    entity->renderer->texture = ye_image(src);
+    // create the image texture (might be a region of an atlas page)
+    struct ye_image_region region = ye_image_atlased(src);
+    entity->renderer->texture = region.texture;
+    entity->renderer->_uv = region.uv;
 
     // update rect based off generated image
-    SDL_Rect size = ye_get_real_texture_size_rect(entity->renderer->texture);
-    entity->renderer->rect.w = size.w;
-    entity->renderer->rect.h = size.h;
+    entity->renderer->rect.w = region.w;
+    entity->renderer->rect.h = region.h;
 
     // default center to be the middle of the rect
     entity->renderer->center = (SDL_Point){entity->renderer->rect.w / 2, entity->renderer->rect.h / 2};
 }
 
 void ye_add_image_renderer_component_preloaded(struct ye_entity *entity, int z, SDL_Texture *texture){
-    struct ye_component_renderer_image *image = malloc(sizeof(struct ye_component_renderer_image));
-    memset(image, 0, sizeof(struct ye_component_renderer_image));
+    struct ye_component_renderer_image *image = ye_alloc_renderer_impl(YE_RENDERER_TYPE_IMAGE);
     image->src = NULL;
 
     // create the renderer top level
@@ -211,237 +894,397 @@ void ye_add_image_renderer_component_preloaded(struct ye_entity *entity, int z,
 }
 
 void ye_add_text_renderer_component(struct ye_entity *entity, int z, const char *text, const char* font, int font_size, const char *color, int wrap_width){
-    struct ye_component_renderer_text *text_renderer = malloc(sizeof(struct ye_component_renderer_text));
-    memset(text_renderer, 0, sizeof(struct ye_component_renderer_text));
+    struct ye_component_renderer_text *text_renderer = ye_alloc_renderer_impl(YE_RENDERER_TYPE_TEXT);
     text_renderer->text = strdup(text);
 
-    text_renderer->font = ye_font(font, font_size);
-    text_renderer->font_name = strdup(font);
+    text_renderer->font_name = ye_intern(font);
+    text_renderer->font = ye_font(text_renderer->font_name, font_size);
     text_renderer->font_size = font_size;
 
     text_renderer->wrap_width = wrap_width;
 
-    text_renderer->color = ye_color(color);
-    text_renderer->color_name = strdup(color);
+    text_renderer->color_name = ye_intern(color);
+    text_renderer->color = ye_color(text_renderer->color_name);
 
     // create the renderer top level
     ye_add_renderer_component(entity, YE_RENDERER_TYPE_TEXT, z, text_renderer);
 
-    // create the text texture
-    if(wrap_width > 0){
-        entity->renderer->texture = createTextTextureWrapped(text, text_renderer->font, text_renderer->color, wrap_width);
-    }
-    else{
-        entity->renderer->texture = createTextTexture(text, text_renderer->font, text_renderer->color);
-    }
+    // lay out the text
+    _ye_text_relayout(entity->renderer);
 
-    // update rect based off generated image
-    SDL_Rect size = ye_get_real_texture_size_rect(entity->renderer->texture);
-    entity->renderer->rect.w = size.w;
-    entity->renderer->rect.h = size.h;
+    // update rect based off the laid out text
+    if(text_renderer->layout != NULL){
+        entity->renderer->rect.w = text_renderer->layout->w;
+        entity->renderer->rect.h = text_renderer->layout->h;
+    }
 }
 
 void ye_add_text_outlined_renderer_component(struct ye_entity *entity, int z, const char *text, const char *font, int font_size, const char *color, const char *outline_color, int outline_size, int wrap_width){
-    struct ye_component_renderer_text_outlined *text_renderer = malloc(sizeof(struct ye_component_renderer_text_outlined));
-    memset(text_renderer, 0, sizeof(struct ye_component_renderer_text_outlined));
+    struct ye_component_renderer_text_outlined *text_renderer = ye_alloc_renderer_impl(YE_RENDERER_TYPE_TEXT_OUTLINED);
     text_renderer->text = strdup(text);
 
-    text_renderer->font = ye_font(font, font_size);
-    text_renderer->font_name = strdup(font);
+    text_renderer->font_name = ye_intern(font);
+    text_renderer->font = ye_font(text_renderer->font_name, font_size);
     text_renderer->font_size = font_size;
 
     text_renderer->wrap_width = wrap_width;
 
-    text_renderer->color = ye_color(color);
-    text_renderer->color_name = strdup(color);
+    text_renderer->color_name = ye_intern(color);
+    text_renderer->color = ye_color(text_renderer->color_name);
 
-    text_renderer->outline_color = ye_color(outline_color);
-    text_renderer->outline_color_name = strdup(outline_color);
+    text_renderer->outline_color_name = ye_intern(outline_color);
+    text_renderer->outline_color = ye_color(text_renderer->outline_color_name);
 
     text_renderer->outline_size = outline_size;
 
     // create the renderer top level
     ye_add_renderer_component(entity, YE_RENDERER_TYPE_TEXT_OUTLINED, z, text_renderer);
 
-    // create the text texture
-    if(wrap_width > 0)
-        entity->renderer->texture = createTextTextureWithOutlineWrapped(text,outline_size,text_renderer->font,text_renderer->color,text_renderer->outline_color,wrap_width);
-    else
-        entity->renderer->texture = createTextTextureWithOutline(text,outline_size,text_renderer->font,text_renderer->color,text_renderer->outline_color);
+    // lay out the text
+    _ye_text_relayout(entity->renderer);
 
-    // update rect based off generated image
-    SDL_Rect size = ye_get_real_texture_size_rect(entity->renderer->texture);
-    entity->renderer->rect.w = size.w;
-    entity->renderer->rect.h = size.h;
+    // update rect based off the laid out text
+    if(text_renderer->layout != NULL){
+        entity->renderer->rect.w = text_renderer->layout->w;
+        entity->renderer->rect.h = text_renderer->layout->h;
+    }
 }
 
 void ye_add_animation_renderer_component(struct ye_entity *entity, int z, const char *meta_file){
-    // load the meta file
-    json_t *META = NULL;
-    if(YE_STATE.editor.editor_mode)
-        META = ye_json_read(ye_path_resources(meta_file));
-    else
-        META = yep_resource_json(meta_file);
-    
-    if(META == NULL){
-        ye_logf(error, "Failed to load animation meta file %s\n", meta_file);
+    struct ye_animation_clip *clip = ye_animation_clip_acquire(meta_file);
+    if(clip == NULL){
+        // reason was already logged
         entity->renderer = NULL; // just in case :P
         return;
     }
 
-    // version of the file
-    int version; ye_json_int(META, "version", &version);
-    if(version != YOYO_ENGINE_ANIMATION_FILE_VERSION){
-        ye_logf(error, "Invalid animation meta file version %d against %d\n", version, YOYO_ENGINE_ANIMATION_FILE_VERSION);
-        json_decref(META);
-        return;
-    }
-
-    // source location of the map    
-    const char *path = NULL; 
-    if(!ye_json_string(META, "src", &path)){
-        ye_logf(error, "Failed to load SRC from animation meta file %s\n", meta_file);
-        json_decref(META);
-        return;
-    }
-
-    // size of each frame
-    int frame_width;
-    if(!ye_json_int(META, "frame_width", &frame_width)){
-        ye_logf(error, "Failed to load frame_width from animation meta file %s\n", meta_file);
-        json_decref(META);
-        return;
-    }
-    int frame_height;
-    if(!ye_json_int(META, "frame_height", &frame_height)){
-        ye_logf(error, "Failed to load frame_height from animation meta file %s\n", meta_file);
-        json_decref(META);
-        return;
-    }
-
-    // number of frames
-    int frame_count;
-    if(!ye_json_int(META, "frame_count", &frame_count)){
-        ye_logf(error, "Failed to load frame_count from animation meta file %s\n", meta_file);
-        json_decref(META);
-        return;
-    }
-
-    // frame delay
-    int frame_delay;
-    if(!ye_json_int(META, "frame_delay", &frame_delay)){
-        ye_logf(error, "Failed to load frame_delay from animation meta file %s\n", meta_file);
-        json_decref(META);
-        return;
-    }
-
-    // loops
-    int loops;
-    if(!ye_json_int(META, "loops", &loops)){
-        ye_logf(error, "Failed to load loops from animation meta file %s\n", meta_file);
-        json_decref(META);
-        return;
-    }
-
-    struct ye_component_renderer_animation *animation = malloc(sizeof(struct ye_component_renderer_animation));
-    memset(animation, 0, sizeof(struct ye_component_renderer_animation));
-    animation->frame_count = frame_count;
-    animation->frame_delay = frame_delay;
-    animation->loops = loops;
-    animation->last_updated = 0; // set as 0 now so the operations between now and setting it do not count towards its frame time
+    struct ye_component_renderer_animation *animation = ye_alloc_renderer_impl(YE_RENDERER_TYPE_ANIMATION);
+    animation->clip = clip;
+    animation->frame_count = clip->frame_count;
+    animation->frame_delay = clip->frame_delay;
+    animation->loops = clip->loops;
     animation->current_frame_index = 0;
     animation->paused = false;
-    animation->animation_handle = strdup(path);
-    animation->meta_file = strdup(meta_file);
-    animation->frame_width = frame_width;
-    animation->frame_height = frame_height;
+    animation->animation_handle = ye_intern_retain(clip->src);
+    animation->meta_file = ye_intern_retain(clip->meta_file);
+    animation->frame_width = clip->frame_width;
+    animation->frame_height = clip->frame_height;
 
     // create the renderer top level
     ye_add_renderer_component(entity, YE_RENDERER_TYPE_ANIMATION, z, animation);
 
     // set the texture to the the map
-    entity->renderer->texture = ye_image(path);
+    struct ye_image_region region = ye_image_atlased(clip->src);
+    entity->renderer->texture = region.texture;
+    entity->renderer->_uv = region.uv;
 
     // update rect based off of frame size
-    entity->renderer->rect.w = frame_width;
-    entity->renderer->rect.h = frame_height;
-
-    animation->last_updated = SDL_GetTicks(); // set the last updated to now so we can start ticking it accurately
+    entity->renderer->rect.w = clip->frame_width;
+    entity->renderer->rect.h = clip->frame_height;
 
-    // free the meta file
-    json_decref(META);
+    animation->start_time = SDL_GetTicks(); // frames are counted from now
 }
 
 void ye_add_tilemap_renderer_component(struct ye_entity *entity, int z, const char * handle, SDL_Rect src){
-    struct ye_component_renderer_tilemap_tile *tile = malloc(sizeof(struct ye_component_renderer_tilemap_tile));
-    memset(tile, 0, sizeof(struct ye_component_renderer_tilemap_tile));
-    tile->handle = strdup(handle);
+    struct ye_component_renderer_tilemap_tile *tile = ye_alloc_renderer_impl(YE_RENDERER_TYPE_TILEMAP_TILE);
+    tile->handle = ye_intern(handle);
     tile->src = src;
 
     // create the renderer top level
     ye_add_renderer_component(entity, YE_RENDERER_TYPE_TILEMAP_TILE, z, tile);
 
     // create the tile texture
-    entity->renderer->texture = ye_image(handle);
+    struct ye_image_region region = ye_image_atlased(handle);
+    entity->renderer->texture = region.texture;
+    entity->renderer->_uv = region.uv;
+    _ye_tile_cache_texture_size(entity->renderer);
 
     // update rect based off of src size
     entity->renderer->rect.w = src.w;
     entity->renderer->rect.h = src.h;
 }
 
-void ye_remove_renderer_component(struct ye_entity *entity){
-    // free contents of renderer_impl
-    switch(entity->renderer->type){
+void ye_add_tilemap_layer_renderer_component(struct ye_entity *entity, int z, const char *tileset, int tile_w, int tile_h, int cols, int rows){
+    if(tile_w <= 0 || tile_h <= 0 || cols <= 0 || rows <= 0){
+        ye_logf(error, "Invalid tilemap layer on \"%s\": %dx%d tiles of %dx%d.\n", entity->name, cols, rows, tile_w, tile_h);
+        entity->renderer = NULL; // just in case :P
+        return;
+    }
+
+    int *tiles = malloc(sizeof(int) * (size_t)cols * rows);
+    if(tiles == NULL){
+        ye_logf(error, "Failed to allocate %dx%d tilemap layer on \"%s\".\n", cols, rows, entity->name);
+        entity->renderer = NULL;
+        return;
+    }
+    for(int i = 0; i < cols * rows; i++)
+        tiles[i] = -1;
+
+    struct ye_component_renderer_tilemap_layer *layer = ye_alloc_renderer_impl(YE_RENDERER_TYPE_TILEMAP_LAYER);
+    layer->tileset = ye_intern(tileset);
+    layer->tile_w = tile_w;
+    layer->tile_h = tile_h;
+    layer->cols = cols;
+    layer->rows = rows;
+    layer->tiles = tiles;
+    _ye_tilemap_layer_init_chunks(layer);
+
+    // create the renderer top level
+    ye_add_renderer_component(entity, YE_RENDERER_TYPE_TILEMAP_LAYER, z, layer);
+    _ye_tilemap_layer_load_tileset(entity->renderer);
+
+    // the layer is as big as all of its tiles
+    entity->renderer->rect.w = cols * tile_w;
+    entity->renderer->rect.h = rows * tile_h;
+}
+
+static struct ye_component_renderer_tilemap_layer * _ye_tilemap_layer_of(struct ye_entity *entity){
+    if(entity == NULL || entity->renderer == NULL || entity->renderer->type != YE_RENDERER_TYPE_TILEMAP_LAYER){
+        ye_logf(error, "Entity \"%s\" does not have a tilemap layer renderer.\n", entity != NULL ? entity->name : "NULL");
+        return NULL;
+    }
+    return entity->renderer->renderer_impl.tilemap_layer;
+}
+
+void ye_tilemap_layer_set_tile(struct ye_entity *entity, int col, int row, int tile){
+    struct ye_component_renderer_tilemap_layer *layer = _ye_tilemap_layer_of(entity);
+    if(layer == NULL)
+        return;
+
+    if(col < 0 || row < 0 || col >= layer->cols || row >= layer->rows){
+        ye_logf(warning, "Tile %d,%d is outside of tilemap layer \"%s\" (%dx%d).\n", col, row, entity->name, layer->cols, layer->rows);
+        return;
+    }
+
+    if(tile < 0)
+        tile = -1;
+
+    int *slot = &layer->tiles[row * layer->cols + col];
+    if(*slot == tile)
+        return;
+    *slot = tile;
+
+    // only the chunk holding this tile has to be baked again
+    if(layer->chunks != NULL)
+        layer->chunks[(row / layer->chunk_tiles_y) * layer->chunk_cols + col / layer->chunk_tiles_x].dirty = true;
+}
+
+int ye_tilemap_layer_get_tile(struct ye_entity *entity, int col, int row){
+    struct ye_component_renderer_tilemap_layer *layer = _ye_tilemap_layer_of(entity);
+    if(layer == NULL || col < 0 || row < 0 || col >= layer->cols || row >= layer->rows)
+        return -1;
+
+    return layer->tiles[row * layer->cols + col];
+}
+
+void ye_tilemap_layer_set_tiles(struct ye_entity *entity, const int *tiles){
+    struct ye_component_renderer_tilemap_layer *layer = _ye_tilemap_layer_of(entity);
+    if(layer == NULL || tiles == NULL)
+        return;
+
+    for(int i = 0; i < layer->cols * layer->rows; i++)
+        layer->tiles[i] = tiles[i] < 0 ? -1 : tiles[i];
+
+    for(int i = 0; i < layer->chunk_cols * layer->chunk_rows; i++)
+        layer->chunks[i].dirty = true;
+}
+
+// free the contents of renderer_impl, and the impl itself
+static void _ye_free_renderer_impl(struct ye_component_renderer *renderer){
+    switch(renderer->type){
         case YE_RENDERER_TYPE_IMAGE:
-            free(entity->renderer->renderer_impl.image->src);
-            free(entity->renderer->renderer_impl.image);
+            ye_intern_release(renderer->renderer_impl.image->src);
+            ye_pool_free(&image_impl_pool, renderer->renderer_impl.image);
             break;
         case YE_RENDERER_TYPE_TEXT:
-            free(entity->renderer->renderer_impl.text->text);
-            // free the strings we strdup'd before the impl itself (duh)
-            free(entity->renderer->renderer_impl.text->font_name);
-            free(entity->renderer->renderer_impl.text->color_name);
-            free(entity->renderer->renderer_impl.text);
-
-            // text textures are not stored in cache, manually remove them
-            if(entity->renderer->texture != NULL){
-                SDL_DestroyTexture(entity->renderer->texture);
-                entity->renderer->texture = NULL;
-            }
+            free(renderer->renderer_impl.text->text);
+            // release the strings we hold before the impl itself (duh)
+            ye_intern_release(renderer->renderer_impl.text->font_name);
+            ye_intern_release(renderer->renderer_impl.text->color_name);
+
+            // copies of this renderer keep the layout until they let go of it too
+            ye_text_layout_release(renderer->renderer_impl.text->layout);
+            renderer->texture = NULL;
+
+            ye_pool_free(&text_impl_pool, renderer->renderer_impl.text);
             break;
         case YE_RENDERER_TYPE_TEXT_OUTLINED:
-            free(entity->renderer->renderer_impl.text_outlined->text);
-            // free the strings we strdup'd before the impl itself (duh)
-            free(entity->renderer->renderer_impl.text_outlined->font_name);
-            free(entity->renderer->renderer_impl.text_outlined->color_name);
-            free(entity->renderer->renderer_impl.text_outlined->outline_color_name);
-            free(entity->renderer->renderer_impl.text_outlined);
-
-            // text textures are not stored in cache, manually remove them
-            if(entity->renderer->texture != NULL){
-                SDL_DestroyTexture(entity->renderer->texture);
-                entity->renderer->texture = NULL;
-            }
+            free(renderer->renderer_impl.text_outlined->text);
+            // release the strings we hold before the impl itself (duh)
+            ye_intern_release(renderer->renderer_impl.text_outlined->font_name);
+            ye_intern_release(renderer->renderer_impl.text_outlined->color_name);
+            ye_intern_release(renderer->renderer_impl.text_outlined->outline_color_name);
+
+            // copies of this renderer keep the layout until they let go of it too
+            ye_text_layout_release(renderer->renderer_impl.text_outlined->layout);
+            renderer->texture = NULL;
+
+            ye_pool_free(&text_outlined_impl_pool, renderer->renderer_impl.text_outlined);
             break;
         case YE_RENDERER_TYPE_ANIMATION:
             // cache will handle freeing the frame map as needed
-            free(entity->renderer->renderer_impl.animation->animation_handle);
-            free(entity->renderer->renderer_impl.animation->meta_file);
-            free(entity->renderer->renderer_impl.animation);
+            ye_animation_clip_release(renderer->renderer_impl.animation->clip);
+            ye_intern_release(renderer->renderer_impl.animation->animation_handle);
+            ye_intern_release(renderer->renderer_impl.animation->meta_file);
+            ye_pool_free(&animation_impl_pool, renderer->renderer_impl.animation);
             break;
         case YE_RENDERER_TYPE_TILEMAP_TILE:
-            free(entity->renderer->renderer_impl.tile->handle);
-            free(entity->renderer->renderer_impl.tile);
+            ye_intern_release(renderer->renderer_impl.tile->handle);
+            ye_pool_free(&tile_impl_pool, renderer->renderer_impl.tile);
+            break;
+        case YE_RENDERER_TYPE_TILEMAP_LAYER:
+            // chunk textures are ours, the tileset belongs to the cache
+            _ye_tilemap_layer_free_chunks(renderer->renderer_impl.tilemap_layer);
+            free(renderer->renderer_impl.tilemap_layer->tiles);
+            ye_intern_release(renderer->renderer_impl.tilemap_layer->tileset);
+            ye_pool_free(&tile_layer_impl_pool, renderer->renderer_impl.tilemap_layer);
             break;
     }
+}
+
+/*
+    Copy everything about a renderer. Mutable state is copied, read only
+    data (clips, laid out text, interned handles) is shared, and cached
+    images are just the same pointer from the cache.
+*/
+static bool _ye_copy_renderer_into(struct ye_component_renderer *dst, const struct ye_component_renderer *src){
+    *dst = *src;
+    _ye_grid_reset_fields(dst); // the copy is in no grid cells yet
+    dst->_world_valid = false;
+    dst->_queue_seq = render_queue_seq++;
+
+    void *impl = ye_alloc_renderer_impl(src->type);
+    if(impl == NULL)
+        return false;
+
+    switch(src->type){
+        case YE_RENDERER_TYPE_IMAGE: {
+            struct ye_component_renderer_image *image = impl;
+            image->src = ye_intern_retain(src->renderer_impl.image->src);
+            dst->renderer_impl.image = image;
+            break;
+        }
+        case YE_RENDERER_TYPE_TEXT: {
+            struct ye_component_renderer_text *text = impl;
+            *text = *src->renderer_impl.text;
+            text->text = strdup(text->text);
+            ye_intern_retain(text->font_name);
+            ye_intern_retain(text->color_name);
+            if(text->layout != NULL)
+                text->layout->refcount++;
+            dst->renderer_impl.text = text;
+            break;
+        }
+        case YE_RENDERER_TYPE_TEXT_OUTLINED: {
+            struct ye_component_renderer_text_outlined *text = impl;
+            *text = *src->renderer_impl.text_outlined;
+            text->text = strdup(text->text);
+            ye_intern_retain(text->font_name);
+            ye_intern_retain(text->color_name);
+            ye_intern_retain(text->outline_color_name);
+            if(text->layout != NULL)
+                text->layout->refcount++;
+            dst->renderer_impl.text_outlined = text;
+            break;
+        }
+        case YE_RENDERER_TYPE_ANIMATION: {
+            struct ye_component_renderer_animation *animation = impl;
+            *animation = *src->renderer_impl.animation;
+            ye_intern_retain(animation->animation_handle);
+            ye_intern_retain(animation->meta_file);
+            if(animation->clip != NULL)
+                animation->clip->refcount++;
+            dst->renderer_impl.animation = animation;
+            break;
+        }
+        case YE_RENDERER_TYPE_TILEMAP_TILE: {
+            struct ye_component_renderer_tilemap_tile *tile = impl;
+            *tile = *src->renderer_impl.tile;
+            ye_intern_retain(tile->handle);
+            dst->renderer_impl.tile = tile;
+            break;
+        }
+        case YE_RENDERER_TYPE_TILEMAP_LAYER: {
+            struct ye_component_renderer_tilemap_layer *layer = impl;
+            *layer = *src->renderer_impl.tilemap_layer;
+
+            // the copy edits its own tiles, and bakes its own chunks from them
+            size_t count = (size_t)layer->cols * layer->rows;
+            layer->tiles = malloc(sizeof(int) * count);
+            if(layer->tiles == NULL){
+                ye_logf(error, "Failed to copy %dx%d tilemap layer.\n", layer->cols, layer->rows);
+                ye_pool_free(&tile_layer_impl_pool, layer);
+                return false;
+            }
+            memcpy(layer->tiles, src->renderer_impl.tilemap_layer->tiles, sizeof(int) * count);
+            layer->chunks = NULL;
+            _ye_tilemap_layer_init_chunks(layer);
+
+            ye_intern_retain(layer->tileset);
+            dst->renderer_impl.tilemap_layer = layer;
+            break;
+        }
+    }
+    return true;
+}
+
+void ye_add_renderer_component_copy(struct ye_entity *entity, const struct ye_component_renderer *renderer){
+    if(entity == NULL || renderer == NULL){
+        ye_logf(error, "Could not copy renderer component, entity or renderer is NULL.\n");
+        return;
+    }
+
+    struct ye_component_renderer *copy = ye_pool_alloc(&renderer_pool);
+    if(!_ye_copy_renderer_into(copy, renderer)){
+        ye_pool_free(&renderer_pool, copy);
+        return;
+    }
+    entity->renderer = copy;
+
+    // the clip is shared, but a new instance plays from the start on its own clock
+    if(copy->type == YE_RENDERER_TYPE_ANIMATION){
+        struct ye_component_renderer_animation *animation = copy->renderer_impl.animation;
+        animation->start_time = SDL_GetTicks();
+        animation->paused = false;
+        animation->current_frame_index = 0;
+    }
+
+    // add this entity to the renderer component set
+    ye_entity_set_add_sorted_renderer_z(entity);
+    ye_renderer_bounds_changed(entity);
+}
+
+struct ye_component_renderer * ye_copy_renderer_component(const struct ye_component_renderer *renderer){
+    if(renderer == NULL)
+        return NULL;
+
+    struct ye_component_renderer *copy = ye_pool_alloc(&renderer_pool);
+    if(!_ye_copy_renderer_into(copy, renderer)){
+        ye_pool_free(&renderer_pool, copy);
+        return NULL;
+    }
+    return copy;
+}
+
+void ye_free_renderer_component(struct ye_component_renderer *renderer){
+    if(renderer == NULL)
+        return;
+
+    _ye_free_renderer_impl(renderer);
+    ye_pool_free(&renderer_pool, renderer);
+}
+
+void ye_remove_renderer_component(struct ye_entity *entity){
+    _ye_grid_forget(entity);
+    _ye_free_renderer_impl(entity->renderer);
 
     // cache will handle freeing the texture as needed
 
-    free(entity->renderer);
+    ye_pool_free(&renderer_pool, entity->renderer);
     entity->renderer = NULL;
 
-    // remove the entity from the renderer component list
-    ye_entity_list_remove(&renderer_list_head, entity);
+    // remove the entity from the renderer component set
+    ye_entity_set_remove(ye_get_component_set(YE_COMPONENT_RENDERER), entity);
 }
 
 void ye_draw_subsecting_lines(SDL_Renderer * renderer, SDL_Rect cam, int line_spacing, int thickness, SDL_Color color) {
@@ -528,38 +1371,91 @@ void _paint_viewport_lines(SDL_Renderer *renderer) {
     );
 }
 
-void _attempt_tick_animation(struct ye_entity_node *current) {
-    // TODO: this should be decoupled from the renderer and become its own system
-
-    // if not editor mode (we want to not run animations in editor)
-    if(!YE_STATE.editor.editor_mode){
-        struct ye_component_renderer_animation *animation = current->entity->renderer->renderer_impl.animation;
-        if(!animation->paused){
-            int now = SDL_GetTicks();
-            if(now - animation->last_updated >= animation->frame_delay){
-                // the difference between now and last updated
-                int diff = (now - animation->last_updated);// / (animation->frame_delay); 
-
-                // the number of frames we need to advance
-                int frames_to_advance = diff / animation->frame_delay;
-
-                // advance the frame index and wrap around as needed
-                animation->current_frame_index += frames_to_advance;
-                if((size_t)animation->current_frame_index >= animation->frame_count){
-                    animation->current_frame_index = animation->current_frame_index % animation->frame_count;
-                    if(animation->loops != -1){
-                        animation->loops--;
-                        if(animation->loops <= 0){
-                            animation->paused = true; // TODO: dont just pause when it ends, but give option to destroy/ disable renderer
-                            // pause on the last frame of the animation
-                            animation->current_frame_index = animation->frame_count - 1;
-                        }
-                    }
-                }
-                animation->last_updated = now;
-                // current->entity->renderer->texture = animation->frames[animation->current_frame_index]; was this the only thing to change?
-            }
+/*
+    Animations are not ticked, their frame is worked out from how long ago
+    they started: the time into the current loop picks the frame (a binary
+    search when the clip has per frame delays). Nothing accumulates, so an
+    animation that spent a while off screen is on the right frame the moment
+    it is looked at again, and skipping it in the meantime costs nothing.
+*/
+static Uint64 animation_now = 0;    // the one timestamp every animation is evaluated at this frame
+static Uint64 animation_frame = 0;  // number of times ye_system_animation has run
+
+static void _ye_animation_evaluate(struct ye_component_renderer_animation *animation){
+    animation->_evaluated_frame = animation_frame;
+
+    // we want to not run animations in editor
+    if(YE_STATE.editor.editor_mode || animation->paused || animation->frame_count == 0)
+        return;
+
+    struct ye_animation_clip *clip = animation->clip;
+    bool per_frame = clip != NULL && clip->frame_ends != NULL && clip->frame_count == animation->frame_count;
+
+    Uint64 elapsed = animation_now > animation->start_time ? animation_now - animation->start_time : 0;
+    Uint64 duration;
+    if(per_frame){
+        // frame_delay scales the clip's delays, so changing it still changes the speed
+        if(animation->frame_delay > 0 && animation->frame_delay != clip->frame_delay)
+            elapsed = elapsed * SDL_max(clip->frame_delay, 1) / animation->frame_delay;
+        duration = (Uint64)clip->duration;
+    }
+    else{
+        duration = (Uint64)SDL_max(animation->frame_delay, 1) * animation->frame_count;
+    }
+
+    if(animation->loops != -1 && elapsed >= duration * (Uint64)SDL_max(animation->loops, 1)){
+        animation->paused = true; // TODO: dont just pause when it ends, but give option to destroy/ disable renderer
+        // pause on the last frame of the animation
+        animation->current_frame_index = animation->frame_count - 1;
+        return;
+    }
+
+    Uint64 t = elapsed % duration;
+    if(per_frame){
+        // first frame that ends after t
+        int lo = 0, hi = (int)clip->frame_count - 1;
+        while(lo < hi){
+            int mid = (lo + hi) / 2;
+            if(t < (Uint64)clip->frame_ends[mid])
+                hi = mid;
+            else
+                lo = mid + 1;
         }
+        animation->current_frame_index = lo;
+    }
+    else{
+        animation->current_frame_index = (int)(t / SDL_max(animation->frame_delay, 1));
+    }
+}
+
+void ye_system_animation(void){
+    if(YE_STATE.editor.editor_mode)
+        return;
+
+    // one timestamp for every animation, so they agree no matter when they get painted
+    Uint64 now = SDL_GetTicks();
+    Uint64 dt = animation_frame > 0 ? now - animation_now : 0;
+    animation_now = now;
+    animation_frame++;
+
+    struct ye_entity_set *renderer_set = ye_get_component_set(YE_COMPONENT_RENDERER);
+    for(int i = 0; i < renderer_set->count; i++){
+        struct ye_component_renderer *rend = renderer_set->components[i];
+        if(rend->type != YE_RENDERER_TYPE_ANIMATION)
+            continue;
+        struct ye_component_renderer_animation *animation = rend->renderer_impl.animation;
+
+        // paused animations hold their place by starting later
+        if(animation->paused){
+            animation->start_time += dt;
+            continue;
+        }
+
+        // only what was on screen last frame, anything coming back on screen is evaluated when it gets painted
+        if(animation->_evaluated_frame + 1 != animation_frame)
+            continue;
+
+        _ye_animation_evaluate(animation);
     }
 }
 
@@ -659,29 +1555,87 @@ mat3_t _get_auto_bound(struct ye_rectf *bound_AABB, struct ye_rectf *child_AABB,
     return transform;
 }
 
+/*
+    Atom for the editor origin's name, looked up once per frame. Entity names
+    are interned so matching it is a pointer compare (NULL when nothing is
+    named "origin", which no name can equal).
+*/
+static const char *origin_atom = NULL;
+
+/*
+    Editor name labels (display_names)
+
+    Each entity keeps its name laid out in the glyph atlas until it is
+    renamed, and the labels of everything painted this frame are queued and
+    drawn in one batch on top of the scene, rather than rasterizing and
+    destroying a texture per entity per frame.
+*/
+#define YE_NAME_LABEL_FONT_SIZE 32
+
+struct ye_name_label {
+    struct ye_text_layout *layout;
+    float x, y; // screen space top left
+};
+
+static struct ye_name_label *name_labels = NULL;
+static int name_label_count = 0;
+static int name_label_capacity = 0;
+
+static void _ye_name_label_queue(struct ye_entity *entity){
+    if(entity->_name_label == NULL){
+        // the engine font is shared, lay out at a small size then put it back
+        TTF_Font *font = YE_STATE.engine.pEngineFont;
+        float og_size = TTF_GetFontSize(font);
+        TTF_SetFontSize(font, YE_NAME_LABEL_FONT_SIZE);
+        entity->_name_label = ye_text_layout_create(entity->name, font, 0, 0);
+        TTF_SetFontSize(font, og_size);
+
+        if(entity->_name_label == NULL)
+            return; // reason was already logged
+    }
+
+    if(name_label_count == name_label_capacity){
+        int capacity = name_label_capacity > 0 ? name_label_capacity * 2 : 64;
+        struct ye_name_label *grown = realloc(name_labels, sizeof(struct ye_name_label) * capacity);
+        if(grown == NULL){
+            ye_logf(error, "Failed to grow editor name labels.\n");
+            return;
+        }
+        name_labels = grown;
+        name_label_capacity = capacity;
+    }
+
+    struct ye_point_rectf entity_prect = ye_world_prectf_to_screen(ye_get_position2(entity,YE_COMPONENT_TRANSFORM));
+
+    struct ye_name_label *label = &name_labels[name_label_count++];
+    label->layout = entity->_name_label;
+    label->x = entity_prect.verticies[0].x - entity->_name_label->w / 2;
+    label->y = entity_prect.verticies[0].y - 20;
+}
+
 // TODO: refactor for prect
-void _paint_paintbounds(SDL_Renderer *renderer, struct ye_entity_node *current) {
+void _paint_paintbounds(SDL_Renderer *renderer, struct ye_entity *entity) {
     // avoid painting the editor origin TODO: reserve special name/id for editor entities since a user naming an entity origin will exclude them here...
-    if (current->entity->name != NULL && strcmp(current->entity->name, "origin") == 0) {
+    if (origin_atom != NULL && entity->name == origin_atom) {
         return;
     }
     
     // paint bounds, my beloved <3
     if (YE_STATE.editor.paintbounds_visible) {
         for(int i = 0; i < 4; i++){
-            float x1 = current->entity->renderer->_cam_verts[i].position.x;
-            float y1 = current->entity->renderer->_cam_verts[i].position.y;
-            float x2 = current->entity->renderer->_cam_verts[(i + 1) % 4].position.x;
-            float y2 = current->entity->renderer->_cam_verts[(i + 1) % 4].position.y;
+            float x1 = entity->renderer->_cam_verts[i].position.x;
+            float y1 = entity->renderer->_cam_verts[i].position.y;
+            float x2 = entity->renderer->_cam_verts[(i + 1) % 4].position.x;
+            float y2 = entity->renderer->_cam_verts[(i + 1) % 4].position.y;
 
             ye_draw_thick_line(renderer, x1, y1, x2, y2, 2, (SDL_Color){255, 0, 0, 255});
         }
 
         for(int i = 0; i < 4; i++){
-            float x1 = current->entity->renderer->_paintbounds_full_verts.verticies[i].x;
-            float y1 = current->entity->renderer->_paintbounds_full_verts.verticies[i].y;
-            float x2 = current->entity->renderer->_paintbounds_full_verts.verticies[(i + 1) % 4].x;
-            float y2 = current->entity->renderer->_paintbounds_full_verts.verticies[(i + 1) % 4].y;
+            float x1 = entity->renderer->_paintbounds_full_verts.verticies[i].x;
+            float y1 = entity->renderer->_paintbounds_full_verts.verticies[i].y;
+            float x2 = entity->renderer->_paintbounds_full_verts.verticies[(i + 1) % 4].x;
+            float y2 = entity->renderer->_paintbounds_full_verts.verticies[(i + 1) % 4].y;
 
             ye_draw_thick_line(renderer, x1, y1, x2, y2, 2, (SDL_Color){0, 255, 0, 255});
         }
@@ -690,73 +1644,758 @@ void _paint_paintbounds(SDL_Renderer *renderer, struct ye_entity_node *current)
     }
 
     // button bounds
-    if(current->entity->button != NULL && YE_STATE.editor.button_bounds_visible){
+    if(entity->button != NULL && YE_STATE.editor.button_bounds_visible){
 
-        struct ye_point_rectf r = ye_world_prectf_to_screen(ye_get_position2(current->entity,YE_COMPONENT_BUTTON));
+        struct ye_point_rectf r = ye_world_prectf_to_screen(ye_get_position2(entity,YE_COMPONENT_BUTTON));
 
         ye_draw_thick_prect(renderer, r, 2, (SDL_Color){0, 0, 255, 255});
     }
 
     // audio range
-    if(current->entity->audiosource != NULL && YE_STATE.editor.audiorange_visible){
-        struct ye_point_rectf pos = ye_world_prectf_to_screen(ye_get_position2(current->entity, YE_COMPONENT_AUDIOSOURCE));
+    if(entity->audiosource != NULL && YE_STATE.editor.audiorange_visible){
+        struct ye_point_rectf pos = ye_world_prectf_to_screen(ye_get_position2(entity, YE_COMPONENT_AUDIOSOURCE));
         
         SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-        ye_draw_circle(renderer, pos.verticies[0].x, pos.verticies[0].y, (int)current->entity->audiosource->range.w, 2);
-        ye_draw_circle(renderer, pos.verticies[0].x, pos.verticies[0].y, (int)current->entity->audiosource->range.h, 2);
+        ye_draw_circle(renderer, pos.verticies[0].x, pos.verticies[0].y, (int)entity->audiosource->range.w, 2);
+        ye_draw_circle(renderer, pos.verticies[0].x, pos.verticies[0].y, (int)entity->audiosource->range.h, 2);
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     }
 
-    if(YE_STATE.editor.editor_mode && YE_STATE.editor.display_names){
-        // paint the entity name - NOTE: I'm keeping this around because copilot generated it and its kinda cool lol
-        SDL_Color color = {255, 255, 255, 255};
+    // names are drawn together after everything else, see _ye_name_labels_paint
+    if(YE_STATE.editor.editor_mode && YE_STATE.editor.display_names)
+        _ye_name_label_queue(entity);
 
-        // get the current engine font size
-        int og_size = TTF_GetFontHeight(YE_STATE.engine.pEngineFont);
+    if(YE_STATE.editor.colliders_visible && entity->rigidbody != NULL){
+        SDL_Color color;
+        if(entity->rigidbody->p2d_object.is_trigger){
+            color = (SDL_Color){255, 255, 0, 255};
+        }
+        else{
+            color = (SDL_Color){0, 0, 255, 255};
+        }
 
-        // set the size to something way less for performance reasons
-        TTF_SetFontSize(YE_STATE.engine.pEngineFont, 32);
+        if(entity->rigidbody->p2d_object.type == P2D_OBJECT_RECTANGLE){
+            struct ye_rectf pos = (struct ye_rectf){
+                entity->rigidbody->p2d_object.x + entity->rigidbody->transform_offset_x,
+                entity->rigidbody->p2d_object.y + entity->rigidbody->transform_offset_x,
+                entity->rigidbody->p2d_object.rectangle.width,
+                entity->rigidbody->p2d_object.rectangle.height
+            }; 
+            struct ye_point_rectf p = ye_world_prectf_to_screen(ye_rect_to_point_rectf(pos));
+            ye_draw_thick_prect(renderer, p, 2, color);
+        }
+        else if(entity->rigidbody->p2d_object.type == P2D_OBJECT_CIRCLE){
+            struct ye_point_rectf pos = ye_world_prectf_to_screen(ye_get_position2(entity,YE_COMPONENT_RIGIDBODY));
+            ye_draw_circle(renderer, pos.verticies[0].x, pos.verticies[0].y, entity->rigidbody->p2d_object.circle.radius, 2);
+        }
+    }
+}
+
+/*
+    Sprite batch
+
+    Quads are accumulated into one frame-wide vertex/index buffer and only
+    submitted when the texture changes (blend mode lives on the texture, so
+    a texture run is also a blend run) or something has to paint on top of
+    them immediately. A scene of tiles from one tileset becomes a handful of
+    SDL_RenderGeometryRaw calls instead of one per tile.
+*/
+struct ye_sprite_batch {
+    struct ye_affine world2cam; // quads are queued in world space and moved into the camera at flush
+
+    SDL_Texture *texture;   // texture of the current run
+    bool open;              // whether a run has been started (texture can legitimately be NULL)
+
+    SDL_Vertex *verts;
+    int *indices;
+    int quad_count;
+    int quad_capacity;
+};
+
+static struct ye_sprite_batch sprite_batch = {0};
+
+static void _ye_batch_flush(SDL_Renderer *renderer){
+    if(sprite_batch.quad_count > 0){
+        // one pass over every queued vertex (SIMD where available) instead of a matrix product each
+        ye_affine_transform_verts(&sprite_batch.world2cam, sprite_batch.verts, sprite_batch.quad_count * 4);
+
+        const SDL_Vertex *verts = sprite_batch.verts;
+        SDL_RenderGeometryRaw(renderer, sprite_batch.texture,
+            &verts[0].position.x, sizeof(SDL_Vertex),
+            &verts[0].color, sizeof(SDL_Vertex),
+            &verts[0].tex_coord.x, sizeof(SDL_Vertex),
+            sprite_batch.quad_count * 4,
+            sprite_batch.indices, sprite_batch.quad_count * 6, sizeof(int)
+        );
+
+        YE_STATE.runtime.render_v2.num_render_calls++;
+        YE_STATE.runtime.render_v2.num_verticies += sprite_batch.quad_count * 4;
+    }
+
+    sprite_batch.quad_count = 0;
+    sprite_batch.open = false;
+}
+
+static bool _ye_batch_reserve(int quads){
+    if(quads <= sprite_batch.quad_capacity)
+        return true;
+
+    int capacity = sprite_batch.quad_capacity > 0 ? sprite_batch.quad_capacity : 256;
+    while(capacity < quads)
+        capacity *= 2;
+
+    SDL_Vertex *verts = realloc(sprite_batch.verts, sizeof(SDL_Vertex) * 4 * capacity);
+    if(verts == NULL)
+        return false;
+    sprite_batch.verts = verts;
+
+    int *indices = realloc(sprite_batch.indices, sizeof(int) * 6 * capacity);
+    if(indices == NULL)
+        return false;
+    sprite_batch.indices = indices;
+
+    // the index pattern never changes, fill it once for the new quads
+    for(int q = sprite_batch.quad_capacity; q < capacity; q++){
+        int base = q * 4;
+        int *idx = &indices[q * 6];
+        idx[0] = base + 0;
+        idx[1] = base + 1;
+        idx[2] = base + 2;
+        idx[3] = base + 2;
+        idx[4] = base + 3;
+        idx[5] = base + 0;
+    }
+
+    sprite_batch.quad_capacity = capacity;
+    return true;
+}
+
+static void _ye_batch_push_quad(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Vertex verts[4]){
+    if(sprite_batch.open && sprite_batch.texture != texture)
+        _ye_batch_flush(renderer);
+
+    if(!sprite_batch.open){
+        sprite_batch.texture = texture;
+        sprite_batch.open = true;
+    }
+
+    if(!_ye_batch_reserve(sprite_batch.quad_count + 1)){
+        // out of memory, draw what we have and this quad on its own
+        _ye_batch_flush(renderer);
+        SDL_Vertex cam_verts[4];
+        memcpy(cam_verts, verts, sizeof(SDL_Vertex) * 4);
+        ye_affine_transform_verts(&sprite_batch.world2cam, cam_verts, 4);
+        SDL_RenderGeometry(renderer, texture, cam_verts, 4, (int[6]){0, 1, 2, 2, 3, 0}, 6);
+        YE_STATE.runtime.render_v2.num_render_calls++;
+        YE_STATE.runtime.render_v2.num_verticies += 4;
+        return;
+    }
+
+    memcpy(&sprite_batch.verts[sprite_batch.quad_count * 4], verts, sizeof(SDL_Vertex) * 4);
+    sprite_batch.quad_count++;
+}
+
+// whether any per entity editor overlay is going to paint on top of entities this frame
+static bool _ye_entity_overlays_visible(void){
+    return YE_STATE.editor.paintbounds_visible ||
+        YE_STATE.editor.button_bounds_visible ||
+        YE_STATE.editor.audiorange_visible ||
+        (YE_STATE.editor.editor_mode && YE_STATE.editor.display_names) ||
+        YE_STATE.editor.colliders_visible;
+}
+
+// snapshot everything the world space verticies depend on (zeroed first so keys can be memcmp'd)
+static void _ye_renderer_world_key(struct ye_entity *entity, struct ye_component_transform *trans, struct ye_renderer_world_key *key){
+    struct ye_component_renderer *rend = entity->renderer;
+
+    memset(key, 0, sizeof(struct ye_renderer_world_key));
+    if(trans){
+        key->has_transform = true;
+        key->world_x = trans->world_x;
+        key->world_y = trans->world_y;
+        key->world_rotation = trans->world_rotation;
+    }
+    key->rect = rend->rect;
+    key->rotation = rend->rotation;
+    key->center = rend->center;
+    key->alignment = rend->alignment;
+    key->preserve_original_size = rend->preserve_original_size;
+    key->relative = rend->relative;
+    key->texture = rend->texture;
+    key->uv_w = rend->_uv.w;
+    key->uv_h = rend->_uv.h;
+    if(rend->type == YE_RENDERER_TYPE_ANIMATION){
+        key->frame_w = rend->renderer_impl.animation->frame_width;
+        key->frame_h = rend->renderer_impl.animation->frame_height;
+    }
+    else if(rend->type == YE_RENDERER_TYPE_TILEMAP_TILE){
+        key->frame_w = rend->renderer_impl.tile->src.w;
+        key->frame_h = rend->renderer_impl.tile->src.h;
+    }
+    else if(rend->type == YE_RENDERER_TYPE_TILEMAP_LAYER){
+        key->frame_w = rend->renderer_impl.tilemap_layer->cols * rend->renderer_impl.tilemap_layer->tile_w;
+        key->frame_h = rend->renderer_impl.tilemap_layer->rows * rend->renderer_impl.tilemap_layer->tile_h;
+    }
+    else{
+        struct ye_text_layout *layout = _ye_text_layout_of(rend);
+        if(layout != NULL){
+            key->frame_w = (int)layout->w;
+            key->frame_h = (int)layout->h;
+        }
+    }
+}
+
+/*
+    Compute where a renderer sits in world space: fills its world verticies,
+    world rect, center and paintbounds.
 
-        SDL_Texture *text_texture = createTextTexture(current->entity->name, YE_STATE.engine.pEngineFont, &color);
+    Most renderers (level geometry, tiles) never move, so the result is
+    cached against everything it was computed from, and only recomputed
+    when one of those changed. Returns whether anything was recomputed.
+*/
+static bool _ye_renderer_compute_world(struct ye_entity *entity){
+    struct ye_component_renderer *rend = entity->renderer;
+    struct ye_component_transform *trans = ye_update_transform(entity); // world space, cached
+
+    struct ye_renderer_world_key key;
+    _ye_renderer_world_key(entity, trans, &key);
+    if(rend->_world_valid && memcmp(&key, &rend->_world_key, sizeof(struct ye_renderer_world_key)) == 0)
+        return false;
+    rend->_world_key = key;
+    rend->_world_valid = true;
+
+    /*
+        First, fit the AABB so we have a starting point to vertex-ify
+
+        Take the local-space (both are translated to the origin) AABB's and
+        figure out how to scale+translate child_AABB to fit inside bound_AABB
+        fulfilling our stipulations.
+    */
+    struct ye_rectf bound_AABB = (struct ye_rectf){0, 0, rend->rect.w, rend->rect.h};
+    struct ye_rectf child_AABB = ye_convert_rect_rectf(ye_get_real_texture_size_rect(rend->texture));
+    child_AABB.w *= rend->_uv.w; // our image might only be part of an atlas page
+    child_AABB.h *= rend->_uv.h;
+    
+    /*
+        If we are an animation, tmap tile, tmap layer or text, child_AABB is NOT the texture size!!
+    */
+    if(rend->type == YE_RENDERER_TYPE_ANIMATION){
+        child_AABB = (struct ye_rectf){0, 0, rend->renderer_impl.animation->frame_width, rend->renderer_impl.animation->frame_height};
+    }
+    if(rend->type == YE_RENDERER_TYPE_TILEMAP_TILE){
+        child_AABB = (struct ye_rectf){0, 0, rend->renderer_impl.tile->src.w, rend->renderer_impl.tile->src.h};
+    }
+    if(rend->type == YE_RENDERER_TYPE_TILEMAP_LAYER){
+        struct ye_component_renderer_tilemap_layer *layer = rend->renderer_impl.tilemap_layer;
+        child_AABB = (struct ye_rectf){0, 0, layer->cols * layer->tile_w, layer->rows * layer->tile_h};
+    }
+    if(rend->type == YE_RENDERER_TYPE_TEXT || rend->type == YE_RENDERER_TYPE_TEXT_OUTLINED){
+        struct ye_text_layout *layout = _ye_text_layout_of(rend);
+        child_AABB = (struct ye_rectf){0, 0, layout != NULL ? layout->w : 0, layout != NULL ? layout->h : 0};
+    }
+
+    mat3_t align_mat = _get_auto_bound(&bound_AABB, &child_AABB, rend->alignment, !rend->preserve_original_size);
+
+    /*
+        Retrieve a rect comprised of floating point verticies in world space
+    */
+    // struct ye_rectf loc_rect = rend->rect;
+    struct ye_rectf loc_rect = child_AABB;
+    loc_rect.x = 0;
+    loc_rect.y = 0;
+    struct ye_point_rectf entity_prect = ye_rect_to_point_rectf(loc_rect);
+
+    /*
+        Shift matrix to transfer from "local" to "world" space
+    */
+    mat3_t world_matrix = lla_mat3_identity();
+    if(rend->relative && trans) {
+        world_matrix = lla_mat3_translate(world_matrix, (vec2_t){.data = {trans->world_x, trans->world_y}}); // apply transform if it's relative to it
+    }
+    world_matrix = lla_mat3_translate(world_matrix, (vec2_t){.data = {rend->rect.x, rend->rect.y}}); // always offset renderer pos
+
+    /*
+        Create the rotation matrix, taking into account
+        locality, transform positions, relativity, etc
+    */
+    mat3_t rotation_mat = lla_mat3_identity();
+    // Calculate full offset from transform
+    float full_offset_x = rend->rect.x;
+    float full_offset_y = rend->rect.y;
+    if(trans) {
+        full_offset_x += trans->world_x;
+        full_offset_y += trans->world_y;
+    }
+    // Transform rotation around transform center
+    if(trans && trans->world_rotation != 0) {
+        vec2_t transform_pivot;
+        if(rend->relative)
+            transform_pivot = (vec2_t){.data = {
+                trans->world_x - full_offset_x,
+                trans->world_y - full_offset_y
+            }};
+        else
+            transform_pivot = (vec2_t){.data = {0, 0}};
         
-        struct ye_point_rectf entity_prect = ye_world_prectf_to_screen(ye_get_position2(current->entity,YE_COMPONENT_TRANSFORM));
+        rotation_mat = lla_mat3_translate(rotation_mat, transform_pivot);
+        rotation_mat = lla_mat3_rotate(rotation_mat, trans->world_rotation);
+        rotation_mat = lla_mat3_translate(rotation_mat, (vec2_t){.data = {-transform_pivot.data[0], -transform_pivot.data[1]}});
+    }
+    // local rotation around renderer's center
+    if(rend->rotation != 0) {
+        vec2_t local_pivot = (vec2_t){.data = {
+            rend->center.x,
+            rend->center.y
+        }};
+        
+        rotation_mat = lla_mat3_rotate_around(rotation_mat, local_pivot, rend->rotation);
+    }
+
+    /*
+        We can now immediately apply the alignment and rotation matricies to our world space verticies.
 
-        float w,h;
-        SDL_GetTextureSize(text_texture,&w, &h);
+        Initialize the verticies now.
+    */
+    struct ye_point_rectf * world_rect = &rend->_world_rect;
+    SDL_Vertex * world_verts = rend->_world_verts;
+    int * indicies = rend->_indicies;
+
+    // TODO: optimize this to a constructor somehere, im leaving for clarity
+    indicies[0] = 0;
+    indicies[1] = 1;
+    indicies[2] = 2;
+    indicies[3] = 2;
+    indicies[4] = 3;
+    indicies[5] = 0;
 
-        SDL_FRect entity_rect = {entity_prect.verticies[0].x - w / 2, entity_prect.verticies[0].y - 20, w, h};
+    /*
+        Compose the chain once: local -> aligned -> rotated -> world. Every
+        point below is then a single affine transform instead of three mat3
+        products.
+    */
+    struct ye_affine placed = ye_affine_mul(ye_affine_from_mat3(world_matrix), ye_affine_from_mat3(rotation_mat));
+    struct ye_affine local2world = ye_affine_mul(placed, ye_affine_from_mat3(align_mat));
 
-        SDL_RenderTexture(renderer, text_texture, NULL, &entity_rect);
-        SDL_DestroyTexture(text_texture); // TODO: cache for reusability somewhere and invalidate when name changes?
+    /*
+        Cache a transformed center point in world space for use in other places
+    */
+    float center_x = rend->center.x;
+    float center_y = rend->center.y;
+    ye_affine_apply(&local2world, &center_x, &center_y);
+    rend->_world_center = (struct ye_pointf){center_x, center_y};
 
-        // set the font size back to the original size
-        TTF_SetFontSize(YE_STATE.engine.pEngineFont, og_size);
+    // actually compute new world
+    for(int i = 0; i < 4; i++){
+        world_verts[i].position.x = entity_prect.verticies[i].x;
+        world_verts[i].position.y = entity_prect.verticies[i].y;
     }
+    ye_affine_transform_verts(&local2world, world_verts, 4);
 
-    if(YE_STATE.editor.colliders_visible && current->entity->rigidbody != NULL){
-        SDL_Color color;
-        if(current->entity->rigidbody->p2d_object.is_trigger){
-            color = (SDL_Color){255, 255, 0, 255};
+    for(int i = 0; i < 4; i++){
+        // cache
+        world_rect->verticies[i].x = world_verts[i].position.x;
+        world_rect->verticies[i].y = world_verts[i].position.y;
+    }
+
+    // paintbounds are the unaligned bounds, the editor paints them too
+    struct ye_point_rectf pbrf = ye_rect_to_point_rectf(bound_AABB);
+    for(int i = 0; i < 4; i++) {
+        float x = pbrf.verticies[i].x;
+        float y = pbrf.verticies[i].y;
+        ye_affine_apply(&placed, &x, &y);
+        rend->_paintbounds_world_verts.verticies[i].x = x;
+        rend->_paintbounds_world_verts.verticies[i].y = y;
+    }
+
+    return true;
+}
+
+// world space AABB of a renderer, from the verticies _ye_renderer_compute_world cached
+static struct ye_rectf _ye_renderer_world_aabb(struct ye_component_renderer *rend){
+    struct ye_point_rectf *r = &rend->_world_rect;
+    float min_x = r->verticies[0].x, max_x = min_x;
+    float min_y = r->verticies[0].y, max_y = min_y;
+    for(int i = 1; i < 4; i++){
+        min_x = fminf(min_x, r->verticies[i].x);
+        max_x = fmaxf(max_x, r->verticies[i].x);
+        min_y = fminf(min_y, r->verticies[i].y);
+        max_y = fmaxf(max_y, r->verticies[i].y);
+    }
+    return (struct ye_rectf){min_x, min_y, max_x - min_x, max_y - min_y};
+}
+
+/*
+    Re-bucket everything that moved since the last paint
+*/
+static void _ye_grid_flush_dirty(void){
+    for(int i = 0; i < grid_dirty.count; i++){
+        struct ye_entity *entity = grid_dirty.entities[i];
+        entity->renderer->_grid_dirty_index = -1;
+
+        if(_ye_renderer_compute_world(entity) || !entity->renderer->_grid_placed)
+            _ye_grid_place(entity, _ye_renderer_world_aabb(entity->renderer));
+    }
+    grid_dirty.count = 0;
+}
+
+static void _ye_grid_visit(struct ye_entity *entity){
+    struct ye_component_renderer *rend = entity->renderer;
+    if(rend->_grid_stamp == grid_stamp)
+        return;
+    rend->_grid_stamp = grid_stamp;
+
+    // z was written directly since the last sort. A changed texture is left
+    // alone: it only costs a batch break until something else re-sorts, and
+    // re-sorting everything whenever some text changes would cost far more
+    if(rend->z != rend->_queue_z)
+        render_queue_is_dirty = true;
+
+    _ye_grid_list_push(&grid_candidates, entity);
+}
+
+static int _ye_grid_candidate_cmp(const void *a, const void *b){
+    const struct ye_entity *ea = *(struct ye_entity * const *)a;
+    const struct ye_entity *eb = *(struct ye_entity * const *)b;
+    return ea->renderer->_queue_index - eb->renderer->_queue_index;
+}
+
+/*
+    Collect every renderer whose cells overlap a world space rect, in
+    render queue order so layering is unchanged.
+*/
+static struct ye_render_grid_list * _ye_grid_query(struct ye_rectf view){
+    grid_candidates.count = 0;
+    if(++grid_stamp == 0) // never hand out the "never visited" stamp
+        grid_stamp = 1;
+
+    int x0 = (int)floorf(view.x / YE_RENDER_GRID_CELL);
+    int y0 = (int)floorf(view.y / YE_RENDER_GRID_CELL);
+    int x1 = (int)floorf((view.x + view.w) / YE_RENDER_GRID_CELL);
+    int y1 = (int)floorf((view.y + view.h) / YE_RENDER_GRID_CELL);
+
+    // zoomed way out, walking the occupied cells is cheaper than walking the view
+    int64_t view_cells = (int64_t)(x1 - x0 + 1) * (int64_t)(y1 - y0 + 1);
+    if(view_cells > (int64_t)HASH_COUNT(grid_cells)){
+        struct ye_render_grid_cell *cell, *tmp;
+        HASH_ITER(hh, grid_cells, cell, tmp){
+            int cx = (int)(cell->key >> 32);
+            int cy = (int)(int32_t)(cell->key & 0xFFFFFFFF);
+            if(cx < x0 || cx > x1 || cy < y0 || cy > y1)
+                continue;
+            for(int i = 0; i < cell->count; i++)
+                _ye_grid_visit(cell->entities[i]);
         }
-        else{
-            color = (SDL_Color){0, 0, 255, 255};
+    }
+    else{
+        for(int cy = y0; cy <= y1; cy++){
+            for(int cx = x0; cx <= x1; cx++){
+                int64_t key = _ye_grid_key(cx, cy);
+                struct ye_render_grid_cell *cell = NULL;
+                HASH_FIND(hh, grid_cells, &key, sizeof(int64_t), cell);
+                if(cell == NULL)
+                    continue;
+                for(int i = 0; i < cell->count; i++)
+                    _ye_grid_visit(cell->entities[i]);
+            }
         }
+    }
 
-        if(current->entity->rigidbody->p2d_object.type == P2D_OBJECT_RECTANGLE){
-            struct ye_rectf pos = (struct ye_rectf){
-                current->entity->rigidbody->p2d_object.x + current->entity->rigidbody->transform_offset_x,
-                current->entity->rigidbody->p2d_object.y + current->entity->rigidbody->transform_offset_x,
-                current->entity->rigidbody->p2d_object.rectangle.width,
-                current->entity->rigidbody->p2d_object.rectangle.height
-            }; 
-            struct ye_point_rectf p = ye_world_prectf_to_screen(ye_rect_to_point_rectf(pos));
-            ye_draw_thick_prect(renderer, p, 2, color);
+    for(int i = 0; i < grid_oversized.count; i++)
+        _ye_grid_visit(grid_oversized.entities[i]);
+
+    if(render_queue_is_dirty)
+        _ye_render_queue_rebuild();
+
+    qsort(grid_candidates.entities, grid_candidates.count, sizeof(struct ye_entity *), _ye_grid_candidate_cmp);
+
+    return &grid_candidates;
+}
+
+void ye_shutdown_renderer(void){
+    free(sprite_batch.verts);
+    free(sprite_batch.indices);
+    sprite_batch = (struct ye_sprite_batch){0};
+
+    free(name_labels);
+    name_labels = NULL;
+    name_label_count = 0;
+    name_label_capacity = 0;
+
+    _ye_grid_shutdown();
+    _ye_render_queue_shutdown();
+}
+
+// draw a chunk's tiles into its texture, or drop the texture if it has none
+static void _ye_tilemap_chunk_bake(SDL_Renderer *renderer, struct ye_component_renderer *rend, int cx, int cy){
+    struct ye_component_renderer_tilemap_layer *layer = rend->renderer_impl.tilemap_layer;
+    struct ye_tilemap_chunk *chunk = &layer->chunks[cy * layer->chunk_cols + cx];
+    chunk->dirty = false;
+
+    int col0 = cx * layer->chunk_tiles_x;
+    int row0 = cy * layer->chunk_tiles_y;
+    int cols = SDL_min(layer->chunk_tiles_x, layer->cols - col0);
+    int rows = SDL_min(layer->chunk_tiles_y, layer->rows - row0);
+
+    chunk->empty = true;
+    for(int ty = 0; ty < rows && chunk->empty; ty++)
+        for(int tx = 0; tx < cols && chunk->empty; tx++)
+            chunk->empty = layer->tiles[(row0 + ty) * layer->cols + col0 + tx] < 0;
+
+    if(chunk->empty){
+        if(chunk->texture != NULL){
+            ye_untrack_texture_state(chunk->texture);
+            SDL_DestroyTexture(chunk->texture);
+            chunk->texture = NULL;
+        }
+        return;
+    }
+
+    if(chunk->texture == NULL){
+        // edge chunks are only as big as the tiles they hold
+        chunk->texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, cols * layer->tile_w, rows * layer->tile_h);
+        if(chunk->texture == NULL){
+            ye_logf(error, "Failed to create tilemap chunk texture: %s\n", SDL_GetError());
+            chunk->empty = true; // nothing to paint
+            return;
+        }
+        ye_track_texture_state(chunk->texture, SDL_BLENDMODE_BLEND);
+    }
+
+    // queued quads go to whatever the target is when they are flushed, send them first
+    _ye_batch_flush(renderer);
+
+    SDL_Texture *target = SDL_GetRenderTarget(renderer);
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+
+    SDL_SetRenderTarget(renderer, chunk->texture);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+
+    // tiles never overlap, copy them as is instead of blending them onto the transparent chunk
+    ye_texture_set_blend_mode(rend->texture, SDL_BLENDMODE_NONE);
+    for(int ty = 0; ty < rows; ty++){
+        for(int tx = 0; tx < cols; tx++){
+            int tile = layer->tiles[(row0 + ty) * layer->cols + col0 + tx];
+            if(tile < 0)
+                continue;
+
+            SDL_FRect src = {
+                (float)((tile % layer->tileset_cols) * layer->tile_w),
+                (float)((tile / layer->tileset_cols) * layer->tile_h),
+                (float)layer->tile_w, (float)layer->tile_h
+            };
+            SDL_FRect dst = {(float)(tx * layer->tile_w), (float)(ty * layer->tile_h), (float)layer->tile_w, (float)layer->tile_h};
+            SDL_RenderTexture(renderer, rend->texture, &src, &dst);
+        }
+    }
+    ye_texture_set_blend_mode(rend->texture, SDL_BLENDMODE_BLEND);
+
+    SDL_SetRenderTarget(renderer, target);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+}
+
+/*
+    Paint the chunks of a tilemap layer that are on camera, baking any that
+    changed. Chunk quads are queued in world space like any other quad.
+*/
+static void _ye_tilemap_layer_paint(SDL_Renderer *renderer, struct ye_component_renderer *rend, const struct ye_point_rectf *cam_prect, struct p2d_obb_verts cam_obb_verts){
+    struct ye_component_renderer_tilemap_layer *layer = rend->renderer_impl.tilemap_layer;
+    if(layer->chunks == NULL)
+        return;
+
+    /*
+        The layer is a parallelogram in world space, the point at normalized
+        position (pu, pv) of it sits at origin + pu * edge_u + pv * edge_v
+        (verticies are 1---2 over 0---3, with 0 at texture 0,0)
+    */
+    SDL_FPoint origin = rend->_world_verts[0].position;
+    float ux = rend->_world_verts[3].position.x - origin.x;
+    float uy = rend->_world_verts[3].position.y - origin.y;
+    float vx = rend->_world_verts[1].position.x - origin.x;
+    float vy = rend->_world_verts[1].position.y - origin.y;
+    float det = ux * vy - uy * vx;
+    if(fabsf(det) < 1e-6f)
+        return; // no area to paint
+
+    // which part of the layer the camera covers, so only chunks there are looked at
+    float min_u = INFINITY, max_u = -INFINITY, min_v = INFINITY, max_v = -INFINITY;
+    for(int i = 0; i < 4; i++){
+        float dx = cam_prect->verticies[i].x - origin.x;
+        float dy = cam_prect->verticies[i].y - origin.y;
+        float pu = (dx * vy - dy * vx) / det;
+        float pv = (ux * dy - uy * dx) / det;
+
+        // flipping mirrors where the tiles land
+        if(rend->flipped_x) pu = 1.0f - pu;
+        if(rend->flipped_y) pv = 1.0f - pv;
+
+        min_u = fminf(min_u, pu); max_u = fmaxf(max_u, pu);
+        min_v = fminf(min_v, pv); max_v = fmaxf(max_v, pv);
+    }
+    if(max_u < 0 || min_u > 1 || max_v < 0 || min_v > 1)
+        return;
+
+    int col0 = SDL_min((int)(fmaxf(min_u, 0) * layer->cols), layer->cols - 1);
+    int col1 = SDL_min((int)(fminf(max_u, 1) * layer->cols), layer->cols - 1);
+    int row0 = SDL_min((int)(fmaxf(min_v, 0) * layer->rows), layer->rows - 1);
+    int row1 = SDL_min((int)(fminf(max_v, 1) * layer->rows), layer->rows - 1);
+
+    SDL_FColor color = {1.0f, 1.0f, 1.0f, (float)rend->alpha / 255.0f};
+    const SDL_FPoint chunk_uv[4] = {{0, 0}, {0, 1}, {1, 1}, {1, 0}};
+
+    for(int cy = row0 / layer->chunk_tiles_y; cy <= row1 / layer->chunk_tiles_y; cy++){
+        for(int cx = col0 / layer->chunk_tiles_x; cx <= col1 / layer->chunk_tiles_x; cx++){
+            struct ye_tilemap_chunk *chunk = &layer->chunks[cy * layer->chunk_cols + cx];
+            if(!chunk->dirty && chunk->empty)
+                continue;
+
+            // where the chunk sits in the layer, normalized
+            float u0 = (float)(cx * layer->chunk_tiles_x) / layer->cols;
+            float u1 = (float)SDL_min((cx + 1) * layer->chunk_tiles_x, layer->cols) / layer->cols;
+            float v0 = (float)(cy * layer->chunk_tiles_y) / layer->rows;
+            float v1 = (float)SDL_min((cy + 1) * layer->chunk_tiles_y, layer->rows) / layer->rows;
+
+            SDL_Vertex quad[4];
+            struct ye_point_rectf chunk_prect;
+            for(int i = 0; i < 4; i++){
+                float pu = chunk_uv[i].x == 0 ? u0 : u1;
+                float pv = chunk_uv[i].y == 0 ? v0 : v1;
+                if(rend->flipped_x) pu = 1.0f - pu;
+                if(rend->flipped_y) pv = 1.0f - pv;
+
+                quad[i].position.x = origin.x + pu * ux + pv * vx;
+                quad[i].position.y = origin.y + pu * uy + pv * vy;
+                quad[i].color = color;
+                quad[i].tex_coord = chunk_uv[i];
+
+                chunk_prect.verticies[i].x = quad[i].position.x;
+                chunk_prect.verticies[i].y = quad[i].position.y;
+            }
+
+            // the covered range is a bounding box, rotated layers can still have chunks just off camera in it
+            if(!p2d_obb_verts_intersects_obb_verts(cam_obb_verts, ye_prect2obbverts(chunk_prect)))
+                continue;
+
+            if(chunk->dirty)
+                _ye_tilemap_chunk_bake(renderer, rend, cx, cy);
+            if(chunk->empty)
+                continue;
+
+            _ye_batch_push_quad(renderer, chunk->texture, quad);
+        }
+    }
+}
+
+/*
+    Paint a text renderer's glyph quads, tinted with its colors. The text box
+    is a parallelogram in world space just like a tilemap layer, each glyph
+    lands at its normalized position in it.
+*/
+static void _ye_text_paint(SDL_Renderer *renderer, struct ye_component_renderer *rend){
+    struct ye_text_layout *layout = _ye_text_layout_of(rend);
+    if(layout == NULL || layout->quad_count == 0 || layout->w <= 0 || layout->h <= 0)
+        return;
+
+    SDL_Color *fill = NULL, *outline = NULL;
+    if(rend->type == YE_RENDERER_TYPE_TEXT){
+        fill = rend->renderer_impl.text->color;
+    }
+    else{
+        fill = rend->renderer_impl.text_outlined->color;
+        outline = rend->renderer_impl.text_outlined->outline_color;
+    }
+
+    float alpha = (float)rend->alpha / 255.0f;
+    SDL_FColor fill_color = {1.0f, 1.0f, 1.0f, alpha};
+    SDL_FColor outline_color = fill_color;
+    if(fill != NULL)
+        fill_color = (SDL_FColor){fill->r / 255.0f, fill->g / 255.0f, fill->b / 255.0f, fill->a / 255.0f * alpha};
+    if(outline != NULL)
+        outline_color = (SDL_FColor){outline->r / 255.0f, outline->g / 255.0f, outline->b / 255.0f, outline->a / 255.0f * alpha};
+
+    SDL_FPoint origin = rend->_world_verts[0].position;
+    float ux = rend->_world_verts[3].position.x - origin.x;
+    float uy = rend->_world_verts[3].position.y - origin.y;
+    float vx = rend->_world_verts[1].position.x - origin.x;
+    float vy = rend->_world_verts[1].position.y - origin.y;
+
+    const SDL_FPoint corner[4] = {{0, 0}, {0, 1}, {1, 1}, {1, 0}};
+
+    for(int q = 0; q < layout->quad_count; q++){
+        const struct ye_text_quad *glyph = &layout->quads[q];
+
+        SDL_Vertex quad[4];
+        for(int i = 0; i < 4; i++){
+            float pu = (glyph->rect.x + corner[i].x * glyph->rect.w) / layout->w;
+            float pv = (glyph->rect.y + corner[i].y * glyph->rect.h) / layout->h;
+            if(rend->flipped_x) pu = 1.0f - pu;
+            if(rend->flipped_y) pv = 1.0f - pv;
+
+            quad[i].position.x = origin.x + pu * ux + pv * vx;
+            quad[i].position.y = origin.y + pu * uy + pv * vy;
+            quad[i].color = glyph->outline ? outline_color : fill_color;
+            quad[i].tex_coord.x = glyph->uv.x + corner[i].x * glyph->uv.w;
+            quad[i].tex_coord.y = glyph->uv.y + corner[i].y * glyph->uv.h;
         }
-        else if(current->entity->rigidbody->p2d_object.type == P2D_OBJECT_CIRCLE){
-            struct ye_point_rectf pos = ye_world_prectf_to_screen(ye_get_position2(current->entity,YE_COMPONENT_RIGIDBODY));
-            ye_draw_circle(renderer, pos.verticies[0].x, pos.verticies[0].y, current->entity->rigidbody->p2d_object.circle.radius, 2);
+
+        _ye_batch_push_quad(renderer, glyph->texture, quad);
+    }
+}
+
+// draw every name label queued this frame, they are already in screen space
+static void _ye_name_labels_paint(SDL_Renderer *renderer){
+    if(name_label_count == 0)
+        return;
+
+    _ye_batch_flush(renderer);
+    struct ye_affine world2cam = sprite_batch.world2cam;
+    sprite_batch.world2cam = ye_affine_identity();
+
+    const SDL_FColor white = {1.0f, 1.0f, 1.0f, 1.0f};
+    const SDL_FPoint corner[4] = {{0, 0}, {0, 1}, {1, 1}, {1, 0}};
+
+    for(int l = 0; l < name_label_count; l++){
+        const struct ye_name_label *label = &name_labels[l];
+        for(int q = 0; q < label->layout->quad_count; q++){
+            const struct ye_text_quad *glyph = &label->layout->quads[q];
+
+            SDL_Vertex quad[4];
+            for(int i = 0; i < 4; i++){
+                quad[i].position.x = label->x + glyph->rect.x + corner[i].x * glyph->rect.w;
+                quad[i].position.y = label->y + glyph->rect.y + corner[i].y * glyph->rect.h;
+                quad[i].color = white;
+                quad[i].tex_coord.x = glyph->uv.x + corner[i].x * glyph->uv.w;
+                quad[i].tex_coord.y = glyph->uv.y + corner[i].y * glyph->uv.h;
+            }
+            _ye_batch_push_quad(renderer, glyph->texture, quad);
         }
     }
+
+    _ye_batch_flush(renderer);
+    sprite_batch.world2cam = world2cam;
+    name_label_count = 0;
+}
+
+/*
+    Camera space copies of a renderer's verticies, only needed by things that
+    paint per entity (wireframes, editor overlays). Regular painting moves
+    whole batches into the camera at once, see _ye_batch_flush.
+*/
+static void _ye_renderer_update_cam(struct ye_component_renderer *rend, const struct ye_affine *world2cam){
+    memcpy(rend->_cam_verts, rend->_world_verts, sizeof(SDL_Vertex) * 4);
+    ye_affine_transform_verts(world2cam, rend->_cam_verts, 4);
+
+    for(int i = 0; i < 4; i++){
+        rend->_local_rect.verticies[i].x = rend->_cam_verts[i].position.x;
+        rend->_local_rect.verticies[i].y = rend->_cam_verts[i].position.y;
+
+        float x = rend->_paintbounds_world_verts.verticies[i].x;
+        float y = rend->_paintbounds_world_verts.verticies[i].y;
+        ye_affine_apply(world2cam, &x, &y);
+        rend->_paintbounds_full_verts.verticies[i].x = x;
+        rend->_paintbounds_full_verts.verticies[i].y = y;
+    }
 }
 
 /*
@@ -770,6 +2409,10 @@ void ye_renderer_v2(SDL_Renderer *renderer) {
     // reset stats
     YE_STATE.runtime.render_v2.num_render_calls = 0;
     YE_STATE.runtime.render_v2.num_verticies = 0;
+    YE_STATE.runtime.render_v2.num_visited = 0;
+    YE_STATE.runtime.render_v2.num_culled = 0;
+
+    origin_atom = ye_intern_find("origin");
 
     struct ye_entity *current_cam = YE_STATE.engine.target_camera;
     
@@ -802,225 +2445,81 @@ void ye_renderer_v2(SDL_Renderer *renderer) {
         cam_prect.verticies[i].x = point.data[0];
         cam_prect.verticies[i].y = point.data[1];
     }
+
+    // world space AABB of the camera, what we ask the grid for
+    float view_min_x = cam_prect.verticies[0].x, view_max_x = view_min_x;
+    float view_min_y = cam_prect.verticies[0].y, view_max_y = view_min_y;
+    for(int i = 1; i < 4; i++){
+        view_min_x = fminf(view_min_x, cam_prect.verticies[i].x);
+        view_max_x = fmaxf(view_max_x, cam_prect.verticies[i].x);
+        view_min_y = fminf(view_min_y, cam_prect.verticies[i].y);
+        view_max_y = fmaxf(view_max_y, cam_prect.verticies[i].y);
+    }
+    struct ye_rectf view_AABB = {view_min_x, view_min_y, view_max_x - view_min_x, view_max_y - view_min_y};
+
+    // matrix which transforms back to "window" coordinates, the same for every entity
+    // (set even if nothing is on screen, other systems read it)
+    // TODO: this might be why we need to offset camera location in util.c
+    mat3_t world2cam = lla_mat3_inverse(cam_matrix);
+    YE_STATE.runtime.world2cam = world2cam;
+    struct ye_affine world2cam_affine = ye_affine_from_mat3(world2cam);
+    SDL_ScaleMode quality_scale = ye_quality_scale_mode();
+    sprite_batch.world2cam = world2cam_affine;
+
+    // entities are tested against the camera in world space, where both are still true rectangles
+    struct p2d_obb_verts cam_obb_verts = ye_prect2obbverts(cam_prect);
+
+    // bring the grid up to date, then only look at what is near the camera
+    _ye_grid_flush_dirty();
+    struct ye_render_grid_list *candidates = _ye_grid_query(view_AABB);
+
+    struct ye_entity_set *renderer_set = ye_get_component_set(YE_COMPONENT_RENDERER);
+    YE_STATE.runtime.render_v2.num_visited = candidates->count;
+    YE_STATE.runtime.render_v2.num_culled = renderer_set->count - candidates->count;
     
-    // Traverse tracked entities with renderer components
-    struct ye_entity_node *current = renderer_list_head;
-    while (current != NULL) {
-        if(!current->entity->renderer->active){
-            current = current->next;
-            continue;
-        }
+    // overlays paint per entity, so the batch must be flushed before each one to keep them on top
+    bool entity_overlays = _ye_entity_overlays_visible();
+
+    // Traverse renderers near the camera
+    for(int ci = 0; ci < candidates->count; ci++) {
+        struct ye_entity *entity = candidates->entities[ci];
 
-        // if this render object is an anim, tick it
-        if(current->entity->renderer->type == YE_RENDERER_TYPE_ANIMATION)
-            _attempt_tick_animation(current);
-        
         // discard inactive/edge case entities
-        if(!current->entity->active ||
-            current->entity->renderer == NULL ||
-            !current->entity->renderer->active ||
-            current->entity->renderer->z > current_cam->camera->z
+        if(!entity->active ||
+            entity->renderer == NULL ||
+            !entity->renderer->active ||
+            entity->renderer->z > current_cam->camera->z
         ) {
-            current = current->next;
             continue;
         }
 
-        struct ye_component_renderer *rend = current->entity->renderer;
-        struct ye_component_transform *trans = current->entity->transform;
-
-        /*
-            First, fit the AABB so we have a starting point to vertex-ify
-
-            Take the local-space (both are translated to the origin) AABB's and
-            figure out how to scale+translate child_AABB to fit inside bound_AABB
-            fulfilling our stipulations.
-        */
-        struct ye_rectf bound_AABB = (struct ye_rectf){0, 0, rend->rect.w, rend->rect.h};
-        struct ye_rectf child_AABB = ye_convert_rect_rectf(ye_get_real_texture_size_rect(rend->texture));
-        
-        /*
-            If we are an animation or tmap tile, child_AABB is NOT the texture size!!
-        */
-        if(rend->type == YE_RENDERER_TYPE_ANIMATION){
-            child_AABB = (struct ye_rectf){0, 0, rend->renderer_impl.animation->frame_width, rend->renderer_impl.animation->frame_height};
-        }
-        if(rend->type == YE_RENDERER_TYPE_TILEMAP_TILE){
-            child_AABB = (struct ye_rectf){0, 0, rend->renderer_impl.tile->src.w, rend->renderer_impl.tile->src.h};
-        }
-
-        mat3_t align_mat = _get_auto_bound(&bound_AABB, &child_AABB, rend->alignment, !rend->preserve_original_size);
+        struct ye_component_renderer *rend = entity->renderer;
 
-        /*
-            Retrieve a rect comprised of floating point verticies in world space
-        */
-        // struct ye_rectf loc_rect = rend->rect;
-        struct ye_rectf loc_rect = child_AABB;
-        loc_rect.x = 0;
-        loc_rect.y = 0;
-        struct ye_point_rectf entity_prect = ye_rect_to_point_rectf(loc_rect);
-
-        /*
-            Shift matrix to transfer from "local" to "world" space
-        */
-        mat3_t world_matrix = lla_mat3_identity();
-        if(rend->relative && trans) {
-            world_matrix = lla_mat3_translate(world_matrix, (vec2_t){.data = {trans->x, trans->y}}); // apply transform if it's relative to it
-        }
-        world_matrix = lla_mat3_translate(world_matrix, (vec2_t){.data = {rend->rect.x, rend->rect.y}}); // always offset renderer pos
-
-        /*
-            Create the rotation matrix, taking into account
-            locality, transform positions, relativity, etc
-        */
-        mat3_t rotation_mat = lla_mat3_identity();
-        // Calculate full offset from transform
-        float full_offset_x = rend->rect.x;
-        float full_offset_y = rend->rect.y;
-        if(trans) {
-            full_offset_x += trans->x;
-            full_offset_y += trans->y;
-        }
-        // Transform rotation around transform center
-        if(trans && trans->rotation != 0) {
-            vec2_t transform_pivot;
-            if(rend->relative)
-                transform_pivot = (vec2_t){.data = {
-                    trans->x - full_offset_x,
-                    trans->y - full_offset_y
-                }};
-            else
-                transform_pivot = (vec2_t){.data = {0, 0}};
-            
-            rotation_mat = lla_mat3_translate(rotation_mat, transform_pivot);
-            rotation_mat = lla_mat3_rotate(rotation_mat, trans->rotation);
-            rotation_mat = lla_mat3_translate(rotation_mat, (vec2_t){.data = {-transform_pivot.data[0], -transform_pivot.data[1]}});
-        }
-        // local rotation around renderer's center
-        if(rend->rotation != 0) {
-            vec2_t local_pivot = (vec2_t){.data = {
-                rend->center.x,
-                rend->center.y
-            }};
-            
-            rotation_mat = lla_mat3_rotate_around(rotation_mat, local_pivot, rend->rotation);
-        }
-
-        /*
-            We can now immediately apply the alignment and rotation matricies to our world space verticies.
-
-            Initialize the verticies now.
-        */
-        struct ye_point_rectf * local_rect = &rend->_local_rect;
-        struct ye_point_rectf * world_rect = &rend->_world_rect;
         SDL_Vertex * world_verts = rend->_world_verts;
         SDL_Vertex * cam_verts = rend->_cam_verts;
-        int * indicies = rend->_indicies;
-
-        // TODO: optimize this to a constructor somehere, im leaving for clarity
-        indicies[0] = 0;
-        indicies[1] = 1;
-        indicies[2] = 2;
-        indicies[3] = 2;
-        indicies[4] = 3;
-        indicies[5] = 0;
-
-        /*
-            Cache a transformed center point in world space for use in other places
-        */
-        vec2_t center = {.data = {rend->center.x, rend->center.y}};
-        center = lla_mat3_mult_vec2(align_mat, center);
-        center = lla_mat3_mult_vec2(rotation_mat, center);
-        center = lla_mat3_mult_vec2(world_matrix, center);
-        rend->_world_center = (struct ye_pointf){center.data[0], center.data[1]};
-
-        // actually compute new world
-        for(int i = 0; i < 4; i++){
-            vec2_t v = {.data = {entity_prect.verticies[i].x, entity_prect.verticies[i].y}};
-            v = lla_mat3_mult_vec2(align_mat, v);
-            v = lla_mat3_mult_vec2(rotation_mat, v);
-            v = lla_mat3_mult_vec2(world_matrix, v);
-
-            world_verts[i].position.x = v.data[0];
-            world_verts[i].position.y = v.data[1];
 
-            // cache
-            world_rect->verticies[i].x = v.data[0];
-            world_rect->verticies[i].y = v.data[1];
-        }
-
-        // matrix which transforms back to "window" coordinates
-        // TODO: this might be why we need to offset camera location in util.c
-        mat3_t world2cam = lla_mat3_inverse(cam_matrix);
-        YE_STATE.runtime.world2cam = world2cam;
-
-        // we cache this regardless, because in editor we paint the unaligned AABB too
-        // if(YE_STATE.editor.paintbounds_visible){
-            struct ye_point_rectf pbrf = ye_rect_to_point_rectf(bound_AABB);
-            for(int i = 0; i < 4; i++) {
-                vec2_t v = {.data = {pbrf.verticies[i].x, pbrf.verticies[i].y}};
-                v = lla_mat3_mult_vec2(rotation_mat, v);
-                v = lla_mat3_mult_vec2(world_matrix, v);
-                v = lla_mat3_mult_vec2(world2cam, v);
-                
-                // cache
-                rend->_paintbounds_full_verts.verticies[i].x = v.data[0];
-                rend->_paintbounds_full_verts.verticies[i].y = v.data[1];
-            }
-        // }
+        // world space is cached, only redone if the entity changed. Also catches
+        // anything that moved without telling the grid
+        if(_ye_renderer_compute_world(entity))
+            _ye_grid_place(entity, _ye_renderer_world_aabb(rend));
 
-        /*
-            For rendering, afaict RenderGeometry only takes triangles,
-            so we need to port into SDL_Vertex and a list of indicies
-
-            1---2
-            |   |
-            0---3
-        */
-
-        // Translate all verticies from world to camera
-        for(int i = 0; i < 4; i++){
-            // transform from world into camera space
-            vec2_t point = {.data = {world_verts[i].position.x, world_verts[i].position.y}};
-            point = lla_mat3_mult_vec2(world2cam, point);
-            cam_verts[i].position.x = point.data[0];
-            cam_verts[i].position.y = point.data[1];
-
-            // set color
-            cam_verts[i].color.r = 1.0f;
-            cam_verts[i].color.g = 1.0f;
-            cam_verts[i].color.b = 1.0f;
-            cam_verts[i].color.a = ((float)current->entity->renderer->alpha / 255.0f);
-
-            // cache
-            local_rect->verticies[i].x = point.data[0];
-            local_rect->verticies[i].y = point.data[1];
-        }
-
-        /*
-            TODO: before we set UV's or render, we need to
-            check if at least one edge is intersecting the camera
-        */
-
-        // compute cam_prect in local space
-        struct ye_point_rectf local_cam_prect = cam_prect;
-        for(int i = 0; i < 4; i++){
-            vec2_t point = {.data = {cam_prect.verticies[i].x, cam_prect.verticies[i].y}};
-            point = lla_mat3_mult_vec2(world2cam, point);
-            local_cam_prect.verticies[i].x = point.data[0];
-            local_cam_prect.verticies[i].y = point.data[1];
-        }
-
-        struct p2d_obb_verts cam_obb_verts = ye_prect2obbverts(local_cam_prect);
-        struct p2d_obb_verts local_obb_verts = ye_prect2obbverts(*local_rect);
-        if(!p2d_obb_verts_intersects_obb_verts(cam_obb_verts, local_obb_verts)) {
-            current = current->next;
+        // check at least part of us is on camera before doing anything else
+        struct p2d_obb_verts world_obb_verts = ye_prect2obbverts(rend->_world_rect);
+        if(!p2d_obb_verts_intersects_obb_verts(cam_obb_verts, world_obb_verts)) {
+            YE_STATE.runtime.render_v2.num_culled++;
             continue;
         }
 
+        // animations that just came on screen haven't been evaluated by ye_system_animation
+        if(rend->type == YE_RENDERER_TYPE_ANIMATION && rend->renderer_impl.animation->_evaluated_frame != animation_frame)
+            _ye_animation_evaluate(rend->renderer_impl.animation);
+
         /*
             If we are painting wireframes, skip all the overhead
         */
-        if(YE_STATE.editor.wireframe_visible && current->entity->name != NULL && strcmp(current->entity->name, "origin") != 0) {
+        if(YE_STATE.editor.wireframe_visible && (origin_atom == NULL || entity->name != origin_atom)) {
+            _ye_batch_flush(renderer);
+            _ye_renderer_update_cam(rend, &world2cam_affine);
 
             /*
                 To save cycles, we will just paint the quad outline, and then add the diagonal
@@ -1038,50 +2537,82 @@ void ye_renderer_v2(SDL_Renderer *renderer) {
             YE_STATE.runtime.render_v2.num_render_calls++;
             YE_STATE.runtime.render_v2.num_verticies += 4; // TODO: dont think I can do sizeof because of pointer decay
             YE_STATE.runtime.painted_entity_count++;
-            current = current->next;
+            continue;
+        }
+
+        // tilemap layers paint each of their visible chunks, and text each of its glyphs, instead of one quad
+        if(rend->type == YE_RENDERER_TYPE_TILEMAP_LAYER || rend->type == YE_RENDERER_TYPE_TEXT || rend->type == YE_RENDERER_TYPE_TEXT_OUTLINED){
+            if(rend->type == YE_RENDERER_TYPE_TILEMAP_LAYER)
+                _ye_tilemap_layer_paint(renderer, rend, &cam_prect, cam_obb_verts);
+            else
+                _ye_text_paint(renderer, rend);
+
+            YE_STATE.runtime.painted_entity_count++;
+            if(entity_overlays){
+                _ye_batch_flush(renderer);
+                _ye_renderer_update_cam(rend, &world2cam_affine);
+                _paint_paintbounds(renderer, entity);
+            }
             continue;
         }
 
         /*
-            By default, our uvs span the whole texture,
-            but for animations and tilemaps we must compute
-            the normalized uv float
+            By default, our uvs span our image (the whole texture, or our
+            region of an atlas page), but for animations and tilemaps we
+            must compute the normalized uv float
         */
-        float tcx_start = 0;
-        float tcx_end   = 1;
-        float tcy_start = 0;
-        float tcy_end   = 1;
+        SDL_FRect uv = entity->renderer->_uv;
+        float tcx_start = uv.x;
+        float tcx_end   = uv.x + uv.w;
+        float tcy_start = uv.y;
+        float tcy_end   = uv.y + uv.h;
 
         /*
             Animations are comprised of vertical atlas, meaning w=frame_width h=frame_height*num_frames
         */
-        if(current->entity->renderer->type == YE_RENDERER_TYPE_ANIMATION){
-            struct ye_component_renderer * rend = current->entity->renderer;
-            tcy_start = (float)rend->renderer_impl.animation->current_frame_index / (float)rend->renderer_impl.animation->frame_count;
-            tcy_end = (float)(rend->renderer_impl.animation->current_frame_index + 1) / (float)rend->renderer_impl.animation->frame_count;
+        if(entity->renderer->type == YE_RENDERER_TYPE_ANIMATION){
+            struct ye_component_renderer * rend = entity->renderer;
+            tcy_start = uv.y + uv.h * (float)rend->renderer_impl.animation->current_frame_index / (float)rend->renderer_impl.animation->frame_count;
+            tcy_end = uv.y + uv.h * (float)(rend->renderer_impl.animation->current_frame_index + 1) / (float)rend->renderer_impl.animation->frame_count;
         }
 
         /*
-            We lack the meta in struct ye_component_renderer to determine the size and offset of the tilemap in the image,
-            so this is a performance hit workaround.
-
-            TODO: cache this or wrap texture in a meta-preserving struct
+            Tiles are a src rect of their tileset, the texture size is cached
+            on the tile when its texture is set.
         */
-        if(current->entity->renderer->type == YE_RENDERER_TYPE_TILEMAP_TILE){
-            float w, h;
-            SDL_GetTextureSize(current->entity->renderer->texture, &w, &h);
+        if(entity->renderer->type == YE_RENDERER_TYPE_TILEMAP_TILE){
+            float w = entity->renderer->renderer_impl.tile->_texture_w;
+            float h = entity->renderer->renderer_impl.tile->_texture_h;
         
-            SDL_Rect *src = &current->entity->renderer->renderer_impl.tile->src;
+            SDL_Rect *src = &entity->renderer->renderer_impl.tile->src;
             
-            tcx_start = (float)src->x / (float)w;
-            tcx_end = (float)(src->x + src->w) / (float)w;
-            tcy_start = (float)src->y / (float)h;
-            tcy_end = (float)(src->y + src->h) / (float)h;
+            // src is relative to the tileset, which starts at uv within the texture
+            tcx_start = uv.x + (float)src->x / (float)w;
+            tcx_end = uv.x + (float)(src->x + src->w) / (float)w;
+            tcy_start = uv.y + (float)src->y / (float)h;
+            tcy_end = uv.y + (float)(src->y + src->h) / (float)h;
+        }
+
+        /*
+            For rendering, afaict RenderGeometry only takes triangles,
+            so we need to port into SDL_Vertex and a list of indicies
+
+            1---2
+            |   |
+            0---3
+
+            The quad is queued in world space, the batch moves it into the camera.
+        */
+        SDL_Vertex quad[4];
+        SDL_FColor color = {1.0f, 1.0f, 1.0f, (float)rend->alpha / 255.0f};
+        for(int i = 0; i < 4; i++){
+            quad[i].position = world_verts[i].position;
+            quad[i].color = color;
         }
 
         // set texcoord (shoutout gpt4 for the flipped_n computation)
-        bool flipped_x = current->entity->renderer->flipped_x;
-        bool flipped_y = current->entity->renderer->flipped_y;
+        bool flipped_x = entity->renderer->flipped_x;
+        bool flipped_y = entity->renderer->flipped_y;
         float tex_coords[4][2] = {
             {flipped_x ? tcx_end : tcx_start, flipped_y ? tcy_end : tcy_start},
             {flipped_x ? tcx_end : tcx_start, flipped_y ? tcy_start : tcy_end},
@@ -1089,35 +2620,36 @@ void ye_renderer_v2(SDL_Renderer *renderer) {
             {flipped_x ? tcx_start : tcx_end, flipped_y ? tcy_end : tcy_start}
         };
         for (int i = 0; i < 4; i++) {
-            cam_verts[i].tex_coord.x = tex_coords[i][0];
-            cam_verts[i].tex_coord.y = tex_coords[i][1];
+            quad[i].tex_coord.x = tex_coords[i][0];
+            quad[i].tex_coord.y = tex_coords[i][1];
         }
 
         /*
-            TODO: FIXME: REALLY DUMB HACK
-            SDL3 removed the render quality hint, but we can replicate
-            it by manually setting a prop on each texture. To simplify,
-            we will do this FOR EVERY TEXTURE IN EVERY FRAME!
-            This seems really bad, and you should profile this.
+            SDL3 removed the render quality hint, so the scale mode lives on each texture.
+            Textures the engine created already carry it (see ye_track_texture_state), this
+            only reaches SDL for textures made elsewhere.
         */
-        if(YE_STATE.engine.sdl_quality_hint == 0)
-            SDL_SetTextureScaleMode(rend->texture, SDL_SCALEMODE_NEAREST);
-        else
-            SDL_SetTextureScaleMode(rend->texture, SDL_SCALEMODE_LINEAR);
-
-        SDL_RenderGeometry(renderer, current->entity->renderer->texture, cam_verts, 4, indicies, 6);
+        if(!sprite_batch.open || sprite_batch.texture != rend->texture)
+            ye_texture_set_scale_mode(rend->texture, quality_scale);
 
-        YE_STATE.runtime.render_v2.num_render_calls++;
-        YE_STATE.runtime.render_v2.num_verticies += 4; // TODO: dont think I can do sizeof because of pointer decay
+        _ye_batch_push_quad(renderer, rend->texture, quad);
 
         YE_STATE.runtime.painted_entity_count++;
         
         // TODO: prect refactor
-        _paint_paintbounds(renderer, current);
-
-        current = current->next;
+        if(entity_overlays){
+            _ye_batch_flush(renderer);
+            _ye_renderer_update_cam(rend, &world2cam_affine);
+            _paint_paintbounds(renderer, entity);
+        }
     }
 
+    // submit whatever is left before anything else paints on top
+    _ye_batch_flush(renderer);
+
+    // editor name labels go on top of everything
+    _ye_name_labels_paint(renderer);
+
     /*
         additional post processing for editor mode    
         RUNS ONCE AFTER ALL ENTITES ARE PAINTED
@@ -8,9 +8,12 @@
 #include <p2d/p2d.h>
 
 #include <yoyoengine/logging.h>
+#include <yoyoengine/types/pool.h>
 #include <yoyoengine/ecs/transform.h>
 #include <yoyoengine/ecs/rigidbody.h>
 
+static struct ye_pool rigidbody_pool = YE_POOL_INIT("rigidbody", struct ye_component_rigidbody, 256);
+
 // TODO: maybe dont construct with object because we can use bad values
 void ye_add_rigidbody_component(struct ye_entity *entity, float transform_offset_x, float transform_offset_y, struct p2d_object p2d_object) {
     if(!entity) {
@@ -25,10 +28,15 @@ void ye_add_rigidbody_component(struct ye_entity *entity, float transform_offset
         ye_logf(YE_LL_ERROR, "could not add rigidbody component to \"%s\": entity does not have a transform component\n",entity->name);
         return;
     }
+    if(entity->transform->parent) {
+        ye_logf(YE_LL_ERROR, "could not add rigidbody component to \"%s\": entity has a parent transform (physics bodies must be roots)\n",entity->name);
+        return;
+    }
 
-    struct ye_component_rigidbody *rb = malloc(sizeof(struct ye_component_rigidbody));
+    struct ye_component_rigidbody *rb = ye_pool_alloc(&rigidbody_pool);
     if(!rb) {
         ye_logf(YE_LL_ERROR, "could not add rigidbody component: failed to allocate memory\n");
+        return;
     }
     memset(rb, 0, sizeof(struct ye_component_rigidbody));
 
@@ -52,7 +60,7 @@ void ye_add_rigidbody_component(struct ye_entity *entity, float transform_offset
 
     entity->rigidbody = rb;
 
-    ye_entity_list_add(&rigidbody_list_head, entity);
+    ye_entity_set_add(ye_get_component_set(YE_COMPONENT_RIGIDBODY), entity, rb);
 
     // register this entity into p2d
     p2d_create_object(&rb->p2d_object);
@@ -70,12 +78,12 @@ void ye_remove_rigidbody_component(struct ye_entity *entity) {
         return;
     }
 
-    ye_entity_list_remove(&rigidbody_list_head, entity);
+    ye_entity_set_remove(ye_get_component_set(YE_COMPONENT_RIGIDBODY), entity);
 
     // remove from p2d
     p2d_remove_object(&entity->rigidbody->p2d_object);
 
-    free(entity->rigidbody);
+    ye_pool_free(&rigidbody_pool, entity->rigidbody);
     entity->rigidbody = NULL;
 
     // ye_logf(YE_LL_DEBUG, "removed rigidbody component from \"%s\"\n", entity->name);
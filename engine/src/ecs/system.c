@@ -0,0 +1,380 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <string.h>
+#include <stdlib.h>
+
+#include <SDL.h>
+
+#include <yoyoengine/logging.h>
+#include <yoyoengine/ecs/system.h>
+
+#define YE_MAX_SYSTEM_WORKERS 16
+
+// every system, sorted by stage then registration order
+static struct ye_system **systems = NULL;
+static int system_count = 0;
+static int system_capacity = 0;
+
+// enabled systems grouped by level, rebuilt when dirty
+static struct ye_system **schedule = NULL;
+static int schedule_count = 0;
+static int schedule_capacity = 0;
+static bool schedule_dirty = true;
+
+static bool systems_running = false;
+
+/*
+    Worker pool. The main thread publishes one level's worth of jobs,
+    everyone (main included) pulls from it, and the main thread waits
+    until they are all done before moving to the next level.
+*/
+static SDL_Thread *workers[YE_MAX_SYSTEM_WORKERS];
+static int worker_count = 0;
+
+static SDL_Mutex *job_lock = NULL;
+static SDL_Condition *job_ready = NULL;
+static SDL_Condition *jobs_done = NULL;
+
+static struct ye_system **jobs = NULL;  // points into the current level
+static int job_count = 0;
+static int job_next = 0;
+static int jobs_pending = 0;
+static bool workers_quit = false;
+static bool level_parallel = false;  // a level is spread over the workers right now, see ye_systems_in_parallel
+
+static void _ye_run_system(struct ye_system *system, bool on_worker){
+    // unregistered earlier this frame
+    if(system->callback == NULL)
+        return;
+
+    Uint64 start = SDL_GetTicksNS();
+    system->callback(system);
+    system->time_ms = (SDL_GetTicksNS() - start) / 1000000.0f;
+    system->ran_on_worker = on_worker;
+}
+
+static int _ye_system_worker(void *data){
+    (void)data;
+
+    SDL_LockMutex(job_lock);
+    while(true){
+        while(!workers_quit && job_next >= job_count)
+            SDL_WaitCondition(job_ready, job_lock);
+
+        if(workers_quit)
+            break;
+
+        struct ye_system *system = jobs[job_next++];
+        SDL_UnlockMutex(job_lock);
+
+        _ye_run_system(system, true);
+
+        SDL_LockMutex(job_lock);
+        if(--jobs_pending == 0)
+            SDL_SignalCondition(jobs_done);
+    }
+    SDL_UnlockMutex(job_lock);
+
+    return 0;
+}
+
+static bool _ye_systems_conflict(struct ye_system *a, struct ye_system *b){
+    if((a->flags & YE_SYSTEM_EXCLUSIVE) || (b->flags & YE_SYSTEM_EXCLUSIVE))
+        return true;
+
+    return (a->writes & (b->reads | b->writes)) || (b->writes & a->reads);
+}
+
+/*
+    Each system lands one level after the latest earlier system it conflicts
+    with, so anything sharing a level is free to run at the same time.
+*/
+static void _ye_rebuild_schedule(void){
+    if(system_count > schedule_capacity){
+        struct ye_system **grown = realloc(schedule, sizeof(struct ye_system *) * system_count);
+        if(grown == NULL){
+            ye_logf(error, "Failed to grow system schedule to %d systems.\n", system_count);
+            return;
+        }
+        schedule = grown;
+        schedule_capacity = system_count;
+    }
+
+    int level_count = 0;
+    for(int i = 0; i < system_count; i++){
+        struct ye_system *system = systems[i];
+        system->_level = -1;
+        if(!system->enabled)
+            continue;
+
+        int level = 0;
+        for(int j = 0; j < i; j++){
+            struct ye_system *other = systems[j];
+            if(other->_level >= level && _ye_systems_conflict(system, other))
+                level = other->_level + 1;
+        }
+        system->_level = level;
+        if(level + 1 > level_count)
+            level_count = level + 1;
+    }
+
+    /*
+        Group by level. Nothing in a level conflicts so order inside it
+        doesn't matter, put the main thread systems first so the rest
+        of the level can be handed straight to the workers.
+    */
+    schedule_count = 0;
+    for(int level = 0; level < level_count; level++){
+        for(int i = 0; i < system_count; i++){
+            if(systems[i]->_level == level && (systems[i]->flags & YE_SYSTEM_MAIN_THREAD))
+                schedule[schedule_count++] = systems[i];
+        }
+        for(int i = 0; i < system_count; i++){
+            if(systems[i]->_level == level && !(systems[i]->flags & YE_SYSTEM_MAIN_THREAD))
+                schedule[schedule_count++] = systems[i];
+        }
+    }
+
+    schedule_dirty = false;
+}
+
+static void _ye_run_level(struct ye_system **level, int count){
+    // main thread systems are at the front of the level (see _ye_rebuild_schedule)
+    int main_count = 0;
+    while(main_count < count && (level[main_count]->flags & YE_SYSTEM_MAIN_THREAD))
+        main_count++;
+
+    struct ye_system **parallel_jobs = level + main_count;
+    int parallel = count - main_count;
+
+    // nothing to overlap, don't bother waking anyone
+    if(worker_count == 0 || parallel == 0 || count == 1){
+        for(int i = 0; i < count; i++)
+            _ye_run_system(level[i], false);
+        return;
+    }
+
+    SDL_LockMutex(job_lock);
+    level_parallel = true;
+    jobs = parallel_jobs;
+    job_count = parallel;
+    job_next = 0;
+    jobs_pending = parallel;
+    SDL_BroadcastCondition(job_ready);
+    SDL_UnlockMutex(job_lock);
+
+    for(int i = 0; i < main_count; i++)
+        _ye_run_system(level[i], false);
+
+    // then help out with whatever is left
+    SDL_LockMutex(job_lock);
+    while(job_next < job_count){
+        struct ye_system *system = jobs[job_next++];
+        SDL_UnlockMutex(job_lock);
+
+        _ye_run_system(system, false);
+
+        SDL_LockMutex(job_lock);
+        jobs_pending--;
+    }
+    while(jobs_pending > 0)
+        SDL_WaitCondition(jobs_done, job_lock);
+
+    job_count = 0;
+    job_next = 0;
+    jobs = NULL;
+    level_parallel = false;
+    SDL_UnlockMutex(job_lock);
+}
+
+bool ye_systems_in_parallel(void){
+    return level_parallel;
+}
+
+// free anything unregistered while the systems were running
+static void _ye_sweep_systems(void){
+    int kept = 0;
+    for(int i = 0; i < system_count; i++){
+        if(systems[i]->callback == NULL){
+            free(systems[i]);
+            continue;
+        }
+        systems[kept++] = systems[i];
+    }
+    if(kept != system_count){
+        system_count = kept;
+        schedule_dirty = true;
+    }
+}
+
+void ye_run_systems(void){
+    if(schedule_dirty)
+        _ye_rebuild_schedule();
+
+    systems_running = true;
+
+    int start = 0;
+    while(start < schedule_count){
+        int end = start;
+        while(end < schedule_count && schedule[end]->_level == schedule[start]->_level)
+            end++;
+
+        _ye_run_level(schedule + start, end - start);
+        start = end;
+    }
+
+    systems_running = false;
+
+    _ye_sweep_systems();
+}
+
+struct ye_system * ye_register_system(const char *name, void (*callback)(struct ye_system *system), enum ye_system_stage stage, uint64_t reads, uint64_t writes, int flags){
+    if(callback == NULL){
+        ye_logf(error, "Could not register system \"%s\", callback is NULL.\n", name ? name : "");
+        return NULL;
+    }
+
+    if(system_count >= system_capacity){
+        int capacity = system_capacity > 0 ? system_capacity * 2 : 16;
+        struct ye_system **grown = realloc(systems, sizeof(struct ye_system *) * capacity);
+        if(grown == NULL){
+            ye_logf(error, "Failed to grow system list while registering \"%s\".\n", name ? name : "");
+            return NULL;
+        }
+        systems = grown;
+        system_capacity = capacity;
+    }
+
+    struct ye_system *system = malloc(sizeof(struct ye_system));
+    if(system == NULL){
+        ye_logf(error, "Failed to allocate system \"%s\".\n", name ? name : "");
+        return NULL;
+    }
+    memset(system, 0, sizeof(struct ye_system));
+    if(name)
+        SDL_strlcpy(system->name, name, YE_SYSTEM_NAME_MAX);
+    system->callback = callback;
+    system->stage = stage;
+    system->reads = reads;
+    system->writes = writes;
+    system->flags = flags;
+    system->enabled = true;
+    system->_level = -1;
+
+    // insert after every system of the same or an earlier stage
+    int index = system_count;
+    while(index > 0 && systems[index - 1]->stage > stage)
+        index--;
+    memmove(&systems[index + 1], &systems[index], sizeof(struct ye_system *) * (system_count - index));
+    systems[index] = system;
+    system_count++;
+
+    schedule_dirty = true;
+
+    ye_logf(debug, "Registered system \"%s\".\n", system->name);
+    return system;
+}
+
+void ye_unregister_system(struct ye_system *system){
+    if(system == NULL)
+        return;
+
+    // the schedule might still be pointing at it, let the sweep free it after the frame
+    if(systems_running){
+        system->enabled = false;
+        system->callback = NULL;
+        return;
+    }
+
+    for(int i = 0; i < system_count; i++){
+        if(systems[i] == system){
+            memmove(&systems[i], &systems[i + 1], sizeof(struct ye_system *) * (system_count - i - 1));
+            system_count--;
+            free(system);
+            schedule_dirty = true;
+            return;
+        }
+    }
+
+    ye_logf(warning, "Could not unregister system, it was not registered.\n");
+}
+
+void ye_set_system_enabled(struct ye_system *system, bool enabled){
+    if(system == NULL || system->callback == NULL || system->enabled == enabled)
+        return;
+
+    system->enabled = enabled;
+    schedule_dirty = true;
+}
+
+struct ye_system ** ye_get_systems(int *count){
+    if(count)
+        *count = system_count;
+    return systems;
+}
+
+void ye_init_systems(void){
+    job_lock = SDL_CreateMutex();
+    job_ready = SDL_CreateCondition();
+    jobs_done = SDL_CreateCondition();
+    workers_quit = false;
+
+    // leave one core for the main thread
+    int cores = SDL_GetNumLogicalCPUCores();
+    int wanted = cores - 1;
+    if(wanted > YE_MAX_SYSTEM_WORKERS)
+        wanted = YE_MAX_SYSTEM_WORKERS;
+
+    if(job_lock == NULL || job_ready == NULL || jobs_done == NULL)
+        wanted = 0;
+
+    worker_count = 0;
+    for(int i = 0; i < wanted; i++){
+        workers[worker_count] = SDL_CreateThread(_ye_system_worker, "ye_system_worker", NULL);
+        if(workers[worker_count] == NULL){
+            ye_logf(warning, "Failed to start system worker thread: %s\n", SDL_GetError());
+            break;
+        }
+        worker_count++;
+    }
+
+    ye_logf(info, "Initialized system scheduler with %d worker threads.\n", worker_count);
+}
+
+void ye_shutdown_systems(void){
+    SDL_LockMutex(job_lock);
+    workers_quit = true;
+    SDL_BroadcastCondition(job_ready);
+    SDL_UnlockMutex(job_lock);
+
+    for(int i = 0; i < worker_count; i++)
+        SDL_WaitThread(workers[i], NULL);
+    worker_count = 0;
+
+    SDL_DestroyCondition(jobs_done);
+    SDL_DestroyCondition(job_ready);
+    SDL_DestroyMutex(job_lock);
+    jobs_done = NULL;
+    job_ready = NULL;
+    job_lock = NULL;
+
+    for(int i = 0; i < system_count; i++)
+        free(systems[i]);
+    free(systems);
+    systems = NULL;
+    system_count = 0;
+    system_capacity = 0;
+
+    free(schedule);
+    schedule = NULL;
+    schedule_count = 0;
+    schedule_capacity = 0;
+    schedule_dirty = true;
+
+    ye_logf(info, "Shut down system scheduler.\n");
+}
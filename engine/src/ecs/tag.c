@@ -9,10 +9,152 @@
 #include <stdbool.h>
 #include <stdlib.h>
 
+#include <uthash/uthash.h>
+
 #include <yoyoengine/logging.h>
+#include <yoyoengine/types/pool.h>
 #include <yoyoengine/ecs/ecs.h>
 #include <yoyoengine/ecs/tag.h>
 
+static struct ye_pool tag_pool = YE_POOL_INIT("tag", struct ye_component_tag, 256);
+
+/*
+    ==========================================
+                TAG INTERNING
+    ==========================================
+
+    Every distinct tag string gets a small integer id. Each id also owns the
+    list of entities currently carrying it (the inverted index), so matching
+    a tag only ever touches the entities that have it.
+*/
+
+struct ye_tag_entry {
+    char *name;                 // key (owned copy)
+    int id;
+
+    struct ye_entity **entities; // entities with this tag
+    int count;
+    int capacity;
+
+    UT_hash_handle hh;
+};
+
+static struct ye_tag_entry *tag_table = NULL;     // string -> entry
+static struct ye_tag_entry **tag_entries = NULL;  // id -> entry (index 0 unused, YE_TAG_NONE)
+static int tag_entry_count = 1;
+static int tag_entry_capacity = 0;
+
+static struct ye_tag_entry * _ye_tag_find(const char *tag){
+    if(tag == NULL || tag[0] == '\0')
+        return NULL;
+
+    struct ye_tag_entry *entry = NULL;
+    HASH_FIND_STR(tag_table, tag, entry);
+    return entry;
+}
+
+int ye_tag_intern(const char *tag){
+    if(tag == NULL || tag[0] == '\0')
+        return YE_TAG_NONE;
+
+    struct ye_tag_entry *entry = _ye_tag_find(tag);
+    if(entry != NULL)
+        return entry->id;
+
+    if(strlen(tag) >= YE_TAG_MAX_LENGTH){
+        ye_logf(error, "Tag \"%s\" is too long (max %d characters).\n", tag, YE_TAG_MAX_LENGTH - 1);
+        return YE_TAG_NONE;
+    }
+
+    if(tag_entry_count >= tag_entry_capacity){
+        int capacity = tag_entry_capacity > 0 ? tag_entry_capacity * 2 : 16;
+        struct ye_tag_entry **entries = realloc(tag_entries, sizeof(struct ye_tag_entry *) * capacity);
+        if(entries == NULL){
+            ye_logf(error, "Failed to grow tag table while interning \"%s\".\n", tag);
+            return YE_TAG_NONE;
+        }
+        entries[0] = NULL;
+        tag_entries = entries;
+        tag_entry_capacity = capacity;
+    }
+
+    entry = malloc(sizeof(struct ye_tag_entry));
+    if(entry == NULL){
+        ye_logf(error, "Failed to allocate tag \"%s\".\n", tag);
+        return YE_TAG_NONE;
+    }
+    entry->name = strdup(tag);
+    entry->id = tag_entry_count++;
+    entry->entities = NULL;
+    entry->count = 0;
+    entry->capacity = 0;
+
+    tag_entries[entry->id] = entry;
+    HASH_ADD_KEYPTR(hh, tag_table, entry->name, strlen(entry->name), entry);
+
+    return entry->id;
+}
+
+const char * ye_tag_name(int id){
+    if(id <= YE_TAG_NONE || id >= tag_entry_count)
+        return NULL;
+    return tag_entries[id]->name;
+}
+
+void ye_shutdown_tags(){
+    struct ye_tag_entry *entry, *tmp;
+    HASH_ITER(hh, tag_table, entry, tmp) {
+        HASH_DEL(tag_table, entry);
+        free(entry->entities);
+        free(entry->name);
+        free(entry);
+    }
+    tag_table = NULL;
+
+    free(tag_entries);
+    tag_entries = NULL;
+    tag_entry_count = 1;
+    tag_entry_capacity = 0;
+}
+
+// returns the position the entity was stored at, -1 on failure
+static int _ye_tag_index_add(struct ye_tag_entry *entry, struct ye_entity *entity){
+    if(entry->count >= entry->capacity){
+        int capacity = entry->capacity > 0 ? entry->capacity * 2 : 16;
+        struct ye_entity **entities = realloc(entry->entities, sizeof(struct ye_entity *) * capacity);
+        if(entities == NULL){
+            ye_logf(error, "Failed to grow entity index for tag \"%s\".\n", entry->name);
+            return -1;
+        }
+        entry->entities = entities;
+        entry->capacity = capacity;
+    }
+
+    entry->entities[entry->count] = entity;
+    return entry->count++;
+}
+
+static void _ye_tag_index_remove(struct ye_tag_entry *entry, int index){
+    entry->count--;
+    if(index == entry->count)
+        return;
+
+    // swap the last entity into the hole, and fix up its stored position
+    struct ye_entity *moved = entry->entities[entry->count];
+    entry->entities[index] = moved;
+    for(int i = 0; i < YE_TAG_MAX_NUMBER; i++){
+        if(moved->tag->tags[i] == entry->id){
+            moved->tag->_index[i] = index;
+            break;
+        }
+    }
+}
+
+/*
+    ==========================================
+                TAG COMPONENT
+    ==========================================
+*/
 
 void ye_add_tag_component(struct ye_entity *entity){
     if(!entity) {
@@ -25,18 +167,19 @@ void ye_add_tag_component(struct ye_entity *entity){
         return;
     }
 
-    entity->tag = malloc(sizeof(struct ye_component_tag));
+    entity->tag = ye_pool_alloc(&tag_pool);
     entity->tag->active = true;
 
-    // tags are already malloced, set them to be empty
+    // set every slot to be empty
     for(int i = 0; i < YE_TAG_MAX_NUMBER; i++){
-        entity->tag->tags[i][0] = '\0';
+        entity->tag->tags[i] = YE_TAG_NONE;
+        entity->tag->_index[i] = -1;
     }
 
     // log that we added a tag and to what ID
     // ye_logf(debug, "Added tag component to entity %d\n", entity->id);
 
-    ye_entity_list_add(&tag_list_head, entity);
+    ye_entity_set_add(ye_get_component_set(YE_COMPONENT_TAG), entity, entity->tag);
 }
 
 void ye_add_tag(struct ye_entity *entity, const char *tag){
@@ -55,11 +198,14 @@ void ye_add_tag(struct ye_entity *entity, const char *tag){
         return; // TODO: is this necessary?
     }
 
+    int id = ye_tag_intern(tag);
+    if(id == YE_TAG_NONE){
+        return; // empty tag, nothing to add (or error already logged)
+    }
+
     // perform a first pass to check if it already exists
     for(int i = 0; i < YE_TAG_MAX_NUMBER; i++){
-        if(strcmp(tag, entity->tag->tags[i]) == 0
-            && entity->tag->tags[i][0] != '\0'
-        ){
+        if(entity->tag->tags[i] == id){
             ye_logf(error, "Could not add tag \"%s\" to entity #%d. Tag already exists.\n", tag, entity->id);
             return;
         }
@@ -67,7 +213,7 @@ void ye_add_tag(struct ye_entity *entity, const char *tag){
 
     // find the first empty tag slot
     int i = 0;
-    while(entity->tag->tags[i][0] != '\0'){
+    while(entity->tag->tags[i] != YE_TAG_NONE){
         i++;
         if(i >= YE_TAG_MAX_NUMBER){
             ye_logf(error, "Could not add tag \"%s\" to entity #%d. Tags list is full.\n", tag, entity->id);
@@ -75,8 +221,14 @@ void ye_add_tag(struct ye_entity *entity, const char *tag){
         }
     }
 
-    // copy the tag into the slot
-    strcpy(entity->tag->tags[i], tag);
+    // put the entity in the tag's index
+    int index = _ye_tag_index_add(tag_entries[id], entity);
+    if(index == -1){
+        return;
+    }
+
+    entity->tag->tags[i] = id;
+    entity->tag->_index[i] = index;
 
     // log that we added a tag and to what ID
     // ye_logf(debug, "Added tag \"%s\" to entity %d\n", tag, entity->id);
@@ -91,6 +243,7 @@ void ye_remove_tag(struct ye_entity *entity, const char *tag){
     // check if tag component exists
     if(!entity->tag){
         ye_logf(error, "Could not remove tag \"%s\" from entity #%d. Entity has no tag component.\n", tag, entity->id);
+        return;
     }
 
     if(!entity->tag->active){
@@ -99,17 +252,20 @@ void ye_remove_tag(struct ye_entity *entity, const char *tag){
     }
 
     // find the tag
+    struct ye_tag_entry *entry = _ye_tag_find(tag);
     int i = 0;
-    while(strcmp(entity->tag->tags[i], tag) != 0){
+    while(entry == NULL || entity->tag->tags[i] != entry->id){
         i++;
-        if(i >= YE_TAG_MAX_NUMBER){
+        if(entry == NULL || i >= YE_TAG_MAX_NUMBER){
             ye_logf(error, "Could not remove tag \"%s\" from entity #%d. Tag not found.\n", tag, entity->id);
             return;
         }
     }
 
     // remove the tag
-    entity->tag->tags[i][0] = '\0';
+    _ye_tag_index_remove(entry, entity->tag->_index[i]);
+    entity->tag->tags[i] = YE_TAG_NONE;
+    entity->tag->_index[i] = -1;
 
     // log that we removed a tag and to what ID
     // ye_logf(debug, "Removed tag from entity %d\n", entity->id);
@@ -117,7 +273,7 @@ void ye_remove_tag(struct ye_entity *entity, const char *tag){
     // if the tag component is empty, remove it
     bool empty = true;
     for(int i = 0; i < YE_TAG_MAX_NUMBER; i++){
-        if(entity->tag->tags[i][0] != '\0'){
+        if(entity->tag->tags[i] != YE_TAG_NONE){
             empty = false;
             break;
         }
@@ -138,13 +294,32 @@ void ye_remove_tag_component(struct ye_entity *entity){
         return;
     }
 
-    free(entity->tag);
+    // pull the entity out of every tag index it is in
+    for(int i = 0; i < YE_TAG_MAX_NUMBER; i++){
+        if(entity->tag->tags[i] != YE_TAG_NONE){
+            _ye_tag_index_remove(tag_entries[entity->tag->tags[i]], entity->tag->_index[i]);
+        }
+    }
+
+    ye_pool_free(&tag_pool, entity->tag);
     entity->tag = NULL;
 
     // log that we removed a tag and to what ID
     // ye_logf(debug, "Removed tag from entity %d\n", entity->id);
 
-    ye_entity_list_remove(&tag_list_head, entity);
+    ye_entity_set_remove(ye_get_component_set(YE_COMPONENT_TAG), entity);
+}
+
+bool ye_entity_has_tag_id(struct ye_entity *entity, int tag_id){
+    if(!entity || !entity->tag || tag_id == YE_TAG_NONE)
+        return false;
+
+    for(int i = 0; i < YE_TAG_MAX_NUMBER; i++){
+        if(entity->tag->tags[i] == tag_id){
+            return true;
+        }
+    }
+    return false;
 }
 
 bool ye_entity_has_tag(struct ye_entity *entity, const char *tag){
@@ -154,75 +329,52 @@ bool ye_entity_has_tag(struct ye_entity *entity, const char *tag){
     }
 
     // TODO: add more checks for active and such?
-    if(entity->tag != NULL){
-        for(int i = 0; i < YE_TAG_MAX_NUMBER; i++){
-            if(strcmp(tag, entity->tag->tags[i]) == 0){
-                return true;
-            }
-        }
+    struct ye_tag_entry *entry = _ye_tag_find(tag);
+    if(entry == NULL)
+        return false; // nobody has ever had this tag
+
+    return ye_entity_has_tag_id(entity, entry->id);
+}
+
+struct ye_entity * ye_get_entity_by_tag(const char *tag){
+    struct ye_tag_entry *entry = _ye_tag_find(tag);
+    if(entry != NULL && entry->count > 0){
+        return entry->entities[0];
     }
-    return false;
+
+    ye_logf(error, "COULD NOT LOCATE ENTITY BY THE TAG \"%s\"\n",tag);
+    return NULL;
 }
 
 void ye_for_matching_tag(const char * tag, void(*callback)(struct ye_entity *ent)){
+    struct ye_tag_entry *entry = _ye_tag_find(tag);
+    if(entry == NULL || entry->count == 0)
+        return;
+
     /*
         To avoid users mangling state (deleting entities in the callback),
-        we track visited entities and begin iteration from the HEAD after each callback.
+        we snapshot handles to every match before calling anything. Handles
+        let us notice an entity was destroyed (even if its id got reused),
+        and we re-check the tag in case it was removed along the way.
     */
-    int *processed_ids = NULL;
-    int processed_count = 0;
-    int processed_capacity = 0;
-    
-    struct ye_entity_node *itr = tag_list_head;
-    while(itr != NULL){
-        if(itr->entity == NULL){
-            ye_logf(error, "??? Entity node in tag list is NULL\n");
-            free(processed_ids);
-            return;
-        }
+    int count = entry->count;
+    struct ye_entity_handle *matches = malloc(sizeof(struct ye_entity_handle) * count);
+    if(matches == NULL){
+        ye_logf(error, "Failed to allocate memory for matching tag \"%s\"\n", tag);
+        return;
+    }
 
-        if(ye_entity_has_tag(itr->entity, tag)){
-            bool already_processed = false;
-            for(int i = 0; i < processed_count; i++){
-                if(processed_ids[i] == itr->entity->id){
-                    already_processed = true;
-                    break;
-                }
-            }
-            
-            if(already_processed){
-                itr = itr->next;
-                continue;
-            }
-            
-            if(processed_count >= processed_capacity){
-                processed_capacity = processed_capacity == 0 ? 8 : processed_capacity * 2;
-                int *new_ids = realloc(processed_ids, processed_capacity * sizeof(int));
-                if(new_ids == NULL){
-                    ye_logf(error, "Failed to allocate memory for processed entity tracking\n");
-                    free(processed_ids);
-                    return;
-                }
-                processed_ids = new_ids;
-            }
-            processed_ids[processed_count++] = itr->entity->id;
-            
-            /*
-                In order to mitigate the risk of a callback
-                destroying our list state (like if they remove
-                a entity), we will reset to the beginning of the list
-                after this. This gives us non-ideal complexity,
-                but to be honest I don't think I will ever need to optimize
-                this.
-            */
-            callback(itr->entity);
-
-            itr = tag_list_head;
-            continue;
-        }
+    for(int i = 0; i < count; i++){
+        matches[i] = ye_get_entity_handle(entry->entities[i]);
+    }
 
-        itr = itr->next;
+    int id = entry->id; // entry itself stays alive, tags are never uninterned mid-frame
+    for(int i = 0; i < count; i++){
+        struct ye_entity *entity = ye_get_entity_from_handle(matches[i]);
+        if(entity != NULL && ye_entity_has_tag_id(entity, id)){
+            callback(entity);
+        }
     }
-    
-    free(processed_ids);
-}
\ No newline at end of file
+
+    free(matches);
+}
@@ -8,27 +8,214 @@
 #include <stddef.h>
 #include <stdlib.h>
 
+#include <Lilith.h>
+
+#include <yoyoengine/logging.h>
+#include <yoyoengine/types/pool.h>
 #include <yoyoengine/ecs/ecs.h>
+#include <yoyoengine/ecs/system.h>
+#include <yoyoengine/ecs/renderer.h>
 #include <yoyoengine/ecs/transform.h>
 
+static struct ye_pool transform_pool = YE_POOL_INIT("transform", struct ye_component_transform, 1024);
+
 void ye_add_transform_component(struct ye_entity *entity, int x,int y){
-    entity->transform = malloc(sizeof(struct ye_component_transform));
+    entity->transform = ye_pool_alloc(&transform_pool);
     // entity->transform->active = true; transform doesnt need active
     entity->transform->x = x;
     entity->transform->y = y;
     entity->transform->rotation = 0.0f;
 
-    // add this entity to the transform component list
-    ye_entity_list_add(&transform_list_head, entity);
+    // no parent yet, world == local
+    ye_update_transform(entity);
+
+    // add this entity to the transform component set
+    ye_entity_set_add(ye_get_component_set(YE_COMPONENT_TRANSFORM), entity, entity->transform);
 
     // log that we added a transform and to what ID
     // ye_logf(debug, "Added transform to entity %d\n", entity->id);
 }
 
+static void _ye_transform_unlink(struct ye_entity *child){
+    struct ye_entity *parent = child->transform->parent;
+    if(parent == NULL)
+        return;
+
+    struct ye_entity **itr = &parent->transform->first_child;
+    while(*itr != NULL && *itr != child)
+        itr = &(*itr)->transform->next_sibling;
+    if(*itr != NULL)
+        *itr = child->transform->next_sibling;
+
+    child->transform->parent = NULL;
+    child->transform->next_sibling = NULL;
+    child->transform->_cache_valid = false;
+}
+
 void ye_remove_transform_component(struct ye_entity *entity){
-    free(entity->transform);
+    struct ye_component_transform *transform = entity->transform;
+
+    _ye_transform_unlink(entity);
+
+    // orphan our children, they stay exactly where they are in the world
+    struct ye_entity *child = transform->first_child;
+    while(child != NULL){
+        struct ye_entity *next = child->transform->next_sibling;
+
+        ye_update_transform(child);
+        child->transform->x = child->transform->world_x;
+        child->transform->y = child->transform->world_y;
+        child->transform->rotation = child->transform->world_rotation;
+        child->transform->parent = NULL;
+        child->transform->next_sibling = NULL;
+        child->transform->_cache_valid = false;
+
+        child = next;
+    }
+
+    ye_pool_free(&transform_pool, transform);
     entity->transform = NULL;
 
-    // remove the entity from the transform component list
-    ye_entity_list_remove(&transform_list_head, entity);
-}
\ No newline at end of file
+    // remove the entity from the transform component set
+    ye_entity_set_remove(ye_get_component_set(YE_COMPONENT_TRANSFORM), entity);
+
+    // a relative renderer just lost what it was relative to
+    if(entity->renderer != NULL)
+        ye_renderer_bounds_changed(entity);
+}
+
+void ye_set_transform_parent(struct ye_entity *child, struct ye_entity *parent){
+    if(child == NULL || child->transform == NULL){
+        ye_logf(error, "Could not set transform parent, child is NULL or has no transform.\n");
+        return;
+    }
+
+    if(parent != NULL && parent->transform == NULL){
+        ye_logf(error, "Could not parent \"%s\" to \"%s\", parent has no transform.\n", child->name, parent->name);
+        return;
+    }
+
+    if(parent != NULL && child->rigidbody != NULL){
+        ye_logf(error, "Could not parent \"%s\", entities with rigidbodies can't have a parent.\n", child->name);
+        return;
+    }
+
+    // make sure we aren't parenting something to its own descendant (or itself)
+    for(struct ye_entity *itr = parent; itr != NULL; itr = itr->transform->parent){
+        if(itr == child){
+            ye_logf(error, "Could not parent \"%s\" to \"%s\", it would create a cycle.\n", child->name, parent->name);
+            return;
+        }
+    }
+
+    if(child->transform->parent == parent)
+        return;
+
+    _ye_transform_unlink(child);
+
+    if(parent != NULL){
+        child->transform->parent = parent;
+        child->transform->next_sibling = parent->transform->first_child;
+        parent->transform->first_child = child;
+    }
+
+    ye_update_transform(child);
+}
+
+// work out the world values of t from its local values and its (up to date) parent
+static void _ye_transform_compute_world(struct ye_component_transform *t, const struct ye_component_transform *p){
+    if(p != NULL){
+        // rotate our local offset into the parent's frame
+        mat3_t parent_rot = lla_mat3_rotate(lla_mat3_identity(), p->world_rotation);
+        vec2_t offset = lla_mat3_mult_vec2(parent_rot, (vec2_t){.data = {t->x, t->y}});
+
+        t->world_x = p->world_x + offset.data[0];
+        t->world_y = p->world_y + offset.data[1];
+        t->world_rotation = p->world_rotation + t->rotation;
+    }
+    else{
+        t->world_x = t->x;
+        t->world_y = t->y;
+        t->world_rotation = t->rotation;
+    }
+
+    t->world_matrix = lla_mat3_rotate_around(lla_mat3_identity(), (vec2_t){.data = {t->world_x, t->world_y}}, t->world_rotation);
+}
+
+/*
+    Each transform remembers the local values and parent version its world
+    cache was built from. A change anywhere up the chain bumps a version,
+    which every descendant notices the next time it is updated, so
+    unchanged subtrees only cost a comparison.
+*/
+struct ye_component_transform * ye_update_transform(struct ye_entity *entity){
+    if(entity == NULL || entity->transform == NULL)
+        return NULL;
+
+    struct ye_component_transform *t = entity->transform;
+    struct ye_component_transform *p = ye_update_transform(t->parent);
+
+    if(t->_cache_valid &&
+        t->_cached_x == t->x &&
+        t->_cached_y == t->y &&
+        t->_cached_rotation == t->rotation &&
+        (p == NULL || t->_parent_version == p->version)
+    ){
+        return t;
+    }
+
+    _ye_transform_compute_world(t, p);
+    if(p != NULL)
+        t->_parent_version = p->version;
+
+    t->_cached_x = t->x;
+    t->_cached_y = t->y;
+    t->_cached_rotation = t->rotation;
+    t->_cache_valid = true;
+    t->version++;
+
+    // where we paint moved too
+    if(entity->renderer != NULL)
+        ye_renderer_bounds_changed(entity);
+
+    return t;
+}
+
+/*
+    Updating the cache writes the transform and pushes into the renderer's
+    culling grid, neither of which is allowed while systems run in parallel.
+    Then a stale transform is worked out into out instead, leaving the
+    cache for the transform system to refresh.
+*/
+const struct ye_component_transform * ye_read_transform(struct ye_entity *entity, struct ye_component_transform *out){
+    if(!ye_systems_in_parallel())
+        return ye_update_transform(entity);
+
+    if(entity == NULL || entity->transform == NULL)
+        return NULL;
+
+    struct ye_component_transform *t = entity->transform;
+    struct ye_component_transform parent_scratch;
+    const struct ye_component_transform *p = ye_read_transform(t->parent, &parent_scratch);
+
+    // the parent only counts as unchanged if it came straight from its (current) cache
+    if(t->_cache_valid &&
+        t->_cached_x == t->x &&
+        t->_cached_y == t->y &&
+        t->_cached_rotation == t->rotation &&
+        (p == NULL || (p == t->parent->transform && t->_parent_version == p->version))
+    ){
+        return t;
+    }
+
+    *out = *t;
+    _ye_transform_compute_world(out, p);
+    return out;
+}
+
+void ye_system_transform(void){
+    struct ye_entity_set *set = ye_get_component_set(YE_COMPONENT_TRANSFORM);
+    for(int i = 0; i < set->count; i++){
+        ye_update_transform(set->entities[i]);
+    }
+}
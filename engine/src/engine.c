@@ -38,10 +38,16 @@
 #include <yoyoengine/ecs/ecs.h>
 #include <yoyoengine/ui/overlays.h>
 #include <yoyoengine/graphics.h>
+#include <yoyoengine/glyph_atlas.h>
 #include <yoyoengine/ecs/camera.h>
 #include <yoyoengine/ecs/button.h>
+#include <yoyoengine/ecs/tag.h>
 #include <yoyoengine/ecs/renderer.h>
+#include <yoyoengine/ecs/system.h>
+#include <yoyoengine/ecs/component.h>
+#include <yoyoengine/types/intern.h>
 #include <yoyoengine/ecs/transform.h>
+#include <yoyoengine/types/pool.h>
 #include <yoyoengine/debug_renderer.h>
 #include <yoyoengine/ecs/audiosource.h>
 
@@ -105,22 +111,13 @@ char * ye_path_resources(const char * path){
 /* ============== end new paths ============== */
 
 int last_frame_time = 0;
-void ye_process_frame(){
-    // update time delta
-    YE_STATE.runtime.delta_time = (SDL_GetTicks() - last_frame_time) / 1000.0f;
-    last_frame_time = SDL_GetTicks();
-
-    // check if a scene is deferred to be loaded and load it
-    if(ye_scene_check_deferred_load()){
-        YE_STATE.runtime.delta_time = (SDL_GetTicks() - last_frame_time) / 1000.0f;
-        last_frame_time = SDL_GetTicks();
-    }
-
-    // update timers
-    ye_update_timers();
+/*
+    Built-in systems, registered on init. Input and physics call back into
+    game code (events, collisions) so they get exclusive access to the ECS.
+*/
 
-    // C pre frame callback
-    ye_fire_event(YE_EVENT_PRE_FRAME, (union ye_event_args){NULL});
+static void _ye_input_system(struct ye_system *system){
+    (void)system;
 
     int input_time = SDL_GetTicks();
     
@@ -134,7 +131,10 @@ void ye_process_frame(){
     ye_system_input();
 
     YE_STATE.runtime.input_time = SDL_GetTicks() - input_time;
+}
 
+static void _ye_physics_system(struct ye_system *system){
+    (void)system;
 
     int physics_time = SDL_GetTicks();
     if(!YE_STATE.editor.editor_mode){
@@ -159,15 +159,94 @@ void ye_process_frame(){
         // printf("collision pairs: %d\n", p2d_state.p2d_collision_pairs);
     }
     YE_STATE.runtime.physics_time = SDL_GetTicks() - physics_time;
+}
+
+static void _ye_deferred_commands_system(struct ye_system *system){
+    (void)system;
+
+    /*
+        Apply structural changes (deferred destroys/removals) queued by
+        timers, input, collision callbacks, etc. All at once, before we
+        render, so nothing iterating entities above had to care.
+    */
+    ye_flush_deferred_commands();
+}
+
+static void _ye_transform_system(struct ye_system *system){
+    (void)system;
 
-    // this is where i would run any callbacks... IF I HAD ANY!
+    // refresh world space transforms now that physics and game code moved things
+    ye_system_transform();
+}
+
+static void _ye_animation_system(struct ye_system *system){
+    (void)system;
+
+    // advance animations on screen to the current time
+    ye_system_animation();
+}
+
+static void _ye_render_system(struct ye_system *system){
+    (void)system;
 
     // render frame
     ye_render_all();
+}
+
+static void _ye_audiosource_system(struct ye_system *system){
+    (void)system;
 
     // recompute audio spatialization
     if(!YE_STATE.editor.editor_mode)
         ye_system_audiosource();
+}
+
+static void _ye_register_builtin_systems(){
+    ye_register_system("input", _ye_input_system, YE_SYSTEM_STAGE_INPUT,
+        0, 0, YE_SYSTEM_MAIN_THREAD | YE_SYSTEM_EXCLUSIVE);
+
+    ye_register_system("physics", _ye_physics_system, YE_SYSTEM_STAGE_PHYSICS,
+        YE_SIG_TRANSFORM | YE_SIG_RIGIDBODY, YE_SIG_TRANSFORM | YE_SIG_RIGIDBODY, YE_SYSTEM_MAIN_THREAD | YE_SYSTEM_EXCLUSIVE);
+
+    ye_register_system("deferred commands", _ye_deferred_commands_system, YE_SYSTEM_STAGE_RENDER,
+        0, 0, YE_SYSTEM_MAIN_THREAD | YE_SYSTEM_EXCLUSIVE);
+
+    // updating a transform re-buckets its renderer in the culling grid, which is not thread safe
+    ye_register_system("transform", _ye_transform_system, YE_SYSTEM_STAGE_RENDER,
+        YE_SIG_TRANSFORM | YE_SIG_RENDERER, YE_SIG_TRANSFORM | YE_SIG_RENDERER, YE_SYSTEM_MAIN_THREAD);
+
+    ye_register_system("animation", _ye_animation_system, YE_SYSTEM_STAGE_RENDER,
+        YE_SIG_RENDERER, YE_SIG_RENDERER, 0);
+
+    ye_register_system("render", _ye_render_system, YE_SYSTEM_STAGE_RENDER,
+        YE_SIG_TRANSFORM | YE_SIG_RENDERER | YE_SIG_CAMERA, YE_SIG_RENDERER, YE_SYSTEM_MAIN_THREAD);
+
+    ye_register_system("audiosource", _ye_audiosource_system, YE_SYSTEM_STAGE_POST_RENDER,
+        YE_SIG_TRANSFORM | YE_SIG_CAMERA | YE_SIG_AUDIOSOURCE, YE_SIG_AUDIOSOURCE, YE_SYSTEM_MAIN_THREAD);
+}
+
+void ye_process_frame(){
+    // update time delta
+    YE_STATE.runtime.delta_time = (SDL_GetTicks() - last_frame_time) / 1000.0f;
+    last_frame_time = SDL_GetTicks();
+
+    // check if a scene is deferred to be loaded and load it
+    if(ye_scene_check_deferred_load()){
+        YE_STATE.runtime.delta_time = (SDL_GetTicks() - last_frame_time) / 1000.0f;
+        last_frame_time = SDL_GetTicks();
+    }
+
+    // update timers
+    ye_update_timers();
+
+    // C pre frame callback
+    ye_fire_event(YE_EVENT_PRE_FRAME, (union ye_event_args){NULL});
+
+    /*
+        Input, physics, rendering, audio and any game systems. Ordered by
+        stage and by what components they touch, see system.h
+    */
+    ye_run_systems();
 
     YE_STATE.runtime.frame_time = SDL_GetTicks() - last_frame_time;
 
@@ -250,7 +329,7 @@ void setup_splash_screen(){
     json_decref(splash_scene);
 
     // hook into the build text entity and set the version string
-    struct ye_entity *build_text = ye_get_entity_by_name("build text");
+    struct ye_entity *build_text = ye_try_get_entity_by_name("build text");
     if(build_text != NULL){
         free(build_text->renderer->renderer_impl.text->text);
         build_text->renderer->renderer_impl.text->text = strdup(YOYO_ENGINE_VERSION_STRING);
@@ -389,6 +468,10 @@ void ye_init_engine() {
     // initialize entity component system
     ye_init_ecs();
 
+    // start the system scheduler and register the engine systems
+    ye_init_systems();
+    _ye_register_builtin_systems();
+
     // initialize physics
     p2d_init(p2d_grid_size, ye_physics_collision_callback, ye_physics_trigger_callback, ye_p2d_logf_wrapper);
     YE_STATE.engine.p2d_state = &p2d_state;
@@ -463,8 +546,14 @@ void ye_shutdown_engine(){
     // purge debug renderer
     ye_debug_renderer_cleanup(true);
 
+    // stop the scheduler before anything it runs goes away
+    ye_shutdown_systems();
+
     // shutdown ECS
     ye_shutdown_ecs();
+    ye_shutdown_component_types();
+    ye_shutdown_tags();
+    ye_shutdown_pools();
 
     // shutdown physics
     p2d_shutdown();
@@ -482,6 +571,12 @@ void ye_shutdown_engine(){
     // free the engine font
     TTF_CloseFont(YE_STATE.engine.pEngineFont);
 
+    // free renderer buffers
+    ye_shutdown_renderer();
+
+    // free glyph pages (before the renderer they live on goes away)
+    ye_shutdown_glyph_atlas();
+
     // shutdown graphics
     ye_shutdown_graphics();
     ye_logf(YE_LL_INFO, "Shut down graphics.\n");
@@ -499,6 +594,9 @@ void ye_shutdown_engine(){
     // shutdown overlays
     ye_shutdown_overlays();
 
+    // free interned strings, after everything that could hold one
+    ye_shutdown_intern();
+
     // shutdown logging
     // note: must happen before SDL because it relies on SDL path to open file
     ye_log_shutdown();
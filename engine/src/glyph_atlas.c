@@ -0,0 +1,382 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <string.h>
+#include <stdlib.h>
+
+#include <uthash/uthash.h>
+
+#include <yoyoengine/cache.h>
+#include <yoyoengine/engine.h>
+#include <yoyoengine/logging.h>
+#include <yoyoengine/glyph_atlas.h>
+
+/*
+    Glyph pages are shelf packed the same way as the image atlas (see cache.c),
+    but glyphs get a transparent border instead of an extruded one: glyph edges
+    are already transparent, and neighbouring glyphs must never bleed in.
+*/
+#define YE_GLYPH_PADDING 1
+
+struct ye_glyph_page {
+    SDL_Texture *texture;
+    int size;       // pages are square, bigger than YE_GLYPH_PAGE_SIZE only for a glyph that doesn't fit one
+    int shelf_x;    // where the next glyph goes on the current shelf
+    int shelf_y;    // bottom of the current shelf
+    int shelf_h;    // height of the tallest glyph on the current shelf
+    struct ye_glyph_page *next;
+};
+
+/*
+    TTF_Fonts are shared between every size (ye_font sets the size on the
+    cached font before handing it out), so the size is part of the key.
+*/
+struct ye_glyph_key {
+    TTF_Font *font;
+    float size;
+    int outline;
+    Uint32 codepoint;
+};
+
+struct ye_glyph_node {
+    struct ye_glyph_key key;
+    struct ye_glyph glyph;
+    UT_hash_handle hh;
+};
+
+static struct ye_glyph_page *glyph_pages = NULL;
+static struct ye_glyph_node *glyphs = NULL;
+
+// find room for a w*h glyph (padding included), opening a new page if none has any
+static struct ye_glyph_page * _ye_glyph_alloc(int w, int h, int *x, int *y){
+    struct ye_glyph_page *page = glyph_pages;
+    for(; page != NULL; page = page->next){
+        if(page->shelf_x + w <= page->size && page->shelf_y + h <= page->size)
+            break;
+
+        int next_y = page->shelf_y + page->shelf_h;
+        if(w <= page->size && next_y + h <= page->size){
+            page->shelf_x = 0;
+            page->shelf_y = next_y;
+            page->shelf_h = 0;
+            break;
+        }
+    }
+
+    if(page == NULL){
+        page = calloc(1, sizeof(struct ye_glyph_page));
+        if(page == NULL)
+            return NULL;
+
+        page->size = YE_GLYPH_PAGE_SIZE;
+        if(w > page->size) page->size = w;
+        if(h > page->size) page->size = h;
+
+        page->texture = SDL_CreateTexture(YE_STATE.runtime.renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, page->size, page->size);
+        if(page->texture == NULL){
+            ye_logf(error,"Failed to create glyph atlas page: %s\n",SDL_GetError());
+            free(page);
+            return NULL;
+        }
+        ye_track_texture_state(page->texture, SDL_BLENDMODE_BLEND);
+
+        page->next = glyph_pages;
+        glyph_pages = page;
+    }
+
+    *x = page->shelf_x;
+    *y = page->shelf_y;
+    page->shelf_x += w;
+    if(h > page->shelf_h)
+        page->shelf_h = h;
+
+    return page;
+}
+
+// copy a glyph surface into a page, leaving glyph->texture NULL if it couldn't be packed
+static void _ye_glyph_pack(SDL_Surface *surface, struct ye_glyph *glyph){
+    int w = surface->w;
+    int h = surface->h;
+    int pw = w + YE_GLYPH_PADDING * 2;
+    int ph = h + YE_GLYPH_PADDING * 2;
+
+    int x, y;
+    struct ye_glyph_page *page = _ye_glyph_alloc(pw, ph, &x, &y);
+    if(page == NULL)
+        return;
+
+    SDL_Surface *rgba = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+    Uint32 *pixels = calloc((size_t)pw * ph, sizeof(Uint32)); // zeroed, the padding stays transparent
+    if(rgba == NULL || pixels == NULL){
+        SDL_DestroySurface(rgba);
+        free(pixels);
+        return;
+    }
+
+    SDL_LockSurface(rgba);
+    for(int row = 0; row < h; row++){
+        const Uint8 *src = (const Uint8 *)rgba->pixels + row * rgba->pitch;
+        memcpy(&pixels[(row + YE_GLYPH_PADDING) * pw + YE_GLYPH_PADDING], src, sizeof(Uint32) * w);
+    }
+    SDL_UnlockSurface(rgba);
+    SDL_DestroySurface(rgba);
+
+    SDL_Rect dst_rect = {x, y, pw, ph};
+    bool ok = SDL_UpdateTexture(page->texture, &dst_rect, pixels, pw * (int)sizeof(Uint32));
+    free(pixels);
+    if(!ok){
+        ye_logf(error,"Failed to upload glyph to glyph atlas: %s\n",SDL_GetError());
+        return;
+    }
+
+    glyph->texture = page->texture;
+    glyph->uv = (SDL_FRect){
+        (float)(x + YE_GLYPH_PADDING) / page->size,
+        (float)(y + YE_GLYPH_PADDING) / page->size,
+        (float)w / page->size,
+        (float)h / page->size
+    };
+    glyph->w = w;
+    glyph->h = h;
+}
+
+const struct ye_glyph * ye_glyph(TTF_Font *font, int outline, Uint32 codepoint){
+    if(font == NULL)
+        return NULL;
+
+    struct ye_glyph_key key;
+    memset(&key, 0, sizeof(key)); // the key is hashed bytewise, padding included
+    key.font = font;
+    key.size = TTF_GetFontSize(font);
+    key.outline = outline;
+    key.codepoint = codepoint;
+
+    struct ye_glyph_node *node = NULL;
+    HASH_FIND(hh, glyphs, &key, sizeof(struct ye_glyph_key), node);
+    if(node != NULL)
+        return &node->glyph;
+
+    node = calloc(1, sizeof(struct ye_glyph_node));
+    if(node == NULL){
+        ye_logf(error,"%s","Failed to allocate glyph.\n");
+        return NULL;
+    }
+    node->key = key;
+
+    int minx, maxx, miny, maxy, advance = 0;
+    int old_outline = TTF_GetFontOutline(font);
+    if(old_outline != outline)
+        TTF_SetFontOutline(font, outline);
+
+    if(TTF_GetGlyphMetrics(font, codepoint, &minx, &maxx, &miny, &maxy, &advance))
+        node->glyph.advance = advance;
+
+    // rasterized in white so one glyph serves every color, the batch tints it
+    SDL_Surface *surface = TTF_RenderGlyph_Blended(font, codepoint, (SDL_Color){255, 255, 255, 255});
+
+    if(old_outline != outline)
+        TTF_SetFontOutline(font, old_outline);
+
+    // glyphs with nothing to draw (ex: space) are remembered too, just without a texture
+    if(surface != NULL){
+        if(surface->w > 0 && surface->h > 0)
+            _ye_glyph_pack(surface, &node->glyph);
+        SDL_DestroySurface(surface);
+    }
+
+    HASH_ADD(hh, glyphs, key, sizeof(struct ye_glyph_key), node);
+    return &node->glyph;
+}
+
+struct ye_text_layout * ye_text_layout_create(const char *text, TTF_Font *font, int outline, int wrap_width){
+    if(text == NULL || font == NULL){
+        ye_logf(error,"%s","Cannot lay out text without text and a font.\n");
+        return NULL;
+    }
+
+    struct ye_text_layout *layout = calloc(1, sizeof(struct ye_text_layout));
+    if(layout == NULL){
+        ye_logf(error,"%s","Failed to allocate text layout.\n");
+        return NULL;
+    }
+    layout->refcount = 1;
+
+    // decode into glyphs first, wrapping needs to go back and move words
+    size_t len = strlen(text);
+    Uint32 *codepoints = malloc(sizeof(Uint32) * (len + 1));
+    const struct ye_glyph **fills = malloc(sizeof(struct ye_glyph *) * (len + 1));
+    int *kerning = malloc(sizeof(int) * (len + 1));
+    int *lines = malloc(sizeof(int) * (len + 1));
+    float *xs = malloc(sizeof(float) * (len + 1));
+    if(codepoints == NULL || fills == NULL || kerning == NULL || lines == NULL || xs == NULL){
+        ye_logf(error,"%s","Failed to allocate text layout.\n");
+        free(codepoints); free(fills); free(kerning); free(lines); free(xs);
+        free(layout);
+        return NULL;
+    }
+
+    int count = 0;
+    const char *cursor = text;
+    size_t remaining = len;
+    while(remaining > 0){
+        Uint32 codepoint = SDL_StepUTF8(&cursor, &remaining);
+        if(codepoint == 0)
+            break;
+        codepoints[count++] = codepoint;
+    }
+
+    /*
+        Greedy wrap: glyphs go left to right, and when one would cross
+        wrap_width everything after the last space on the line moves down.
+        A single word wider than wrap_width is left to overflow.
+    */
+    int line = 0;
+    int line_start = 0;     // first glyph of the current line
+    int wrap_at = -1;       // last space on the current line
+    float pen = 0.0f;
+    Uint32 previous = 0;
+    int quad_count = 0;
+    for(int i = 0; i < count; i++){
+        Uint32 codepoint = codepoints[i];
+        fills[i] = NULL;
+        kerning[i] = 0;
+        lines[i] = line;
+        xs[i] = pen;
+
+        if(codepoint == '\n'){
+            line++;
+            line_start = i + 1;
+            wrap_at = -1;
+            pen = 0.0f;
+            previous = 0;
+            continue;
+        }
+
+        fills[i] = ye_glyph(font, 0, codepoint);
+        int advance = fills[i] != NULL ? fills[i]->advance : 0;
+        if(previous != 0)
+            TTF_GetGlyphKerning(font, previous, codepoint, &kerning[i]);
+
+        if(wrap_width > 0 && codepoint != ' ' && wrap_at >= line_start && pen + kerning[i] + advance > wrap_width){
+            // the space we break at stays (invisibly) at the end of the line above
+            line++;
+            line_start = wrap_at + 1;
+            wrap_at = -1;
+            pen = 0.0f;
+            for(int j = line_start; j < i; j++){
+                lines[j] = line;
+                xs[j] = pen + (j == line_start ? 0 : kerning[j]);
+                pen = xs[j] + (fills[j] != NULL ? fills[j]->advance : 0);
+            }
+            if(i == line_start)
+                kerning[i] = 0;
+        }
+
+        if(codepoint == ' ')
+            wrap_at = i;
+
+        lines[i] = line;
+        xs[i] = pen + kerning[i];
+        pen = xs[i] + advance;
+        previous = codepoint;
+
+        if(fills[i] != NULL && fills[i]->texture != NULL)
+            quad_count += outline > 0 ? 2 : 1;
+    }
+
+    layout->quads = malloc(sizeof(struct ye_text_quad) * (quad_count > 0 ? quad_count : 1));
+    if(layout->quads == NULL){
+        ye_logf(error,"%s","Failed to allocate text layout.\n");
+        free(codepoints); free(fills); free(kerning); free(lines); free(xs);
+        free(layout);
+        return NULL;
+    }
+
+    int line_skip = TTF_GetFontLineSkip(font);
+    float width = 0.0f;
+    for(int i = 0; i < count; i++){
+        if(fills[i] != NULL && xs[i] + fills[i]->advance > width)
+            width = xs[i] + fills[i]->advance;
+    }
+
+    /*
+        The fill sits outline pixels in from the top left, where an outlined
+        surface would have put it. Outline glyphs are already that much bigger.
+    */
+    for(int pass = outline > 0 ? 0 : 1; pass < 2; pass++){
+        bool is_outline = pass == 0;
+        for(int i = 0; i < count; i++){
+            if(fills[i] == NULL || fills[i]->texture == NULL)
+                continue;
+
+            const struct ye_glyph *glyph = is_outline ? ye_glyph(font, outline, codepoints[i]) : fills[i];
+            if(glyph == NULL || glyph->texture == NULL)
+                continue;
+
+            float offset = is_outline ? 0.0f : (float)outline;
+            struct ye_text_quad *quad = &layout->quads[layout->quad_count++];
+            quad->texture = glyph->texture;
+            quad->rect = (SDL_FRect){xs[i] + offset, (float)(lines[i] * line_skip) + offset, (float)glyph->w, (float)glyph->h};
+            quad->uv = glyph->uv;
+            quad->outline = is_outline;
+        }
+    }
+
+    layout->w = width + outline * 2;
+    layout->h = (float)(line * line_skip + TTF_GetFontHeight(font) + outline * 2);
+
+    free(codepoints); free(fills); free(kerning); free(lines); free(xs);
+    return layout;
+}
+
+void ye_text_layout_release(struct ye_text_layout *layout){
+    if(layout == NULL)
+        return;
+
+    if(--layout->refcount > 0)
+        return;
+
+    free(layout->quads);
+    free(layout);
+}
+
+void ye_glyph_atlas_forget_font(TTF_Font *font){
+    struct ye_glyph_node *node, *tmp;
+    HASH_ITER(hh, glyphs, node, tmp) {
+        if(node->key.font == font){
+            HASH_DEL(glyphs, node);
+            free(node);
+        }
+    }
+}
+
+int ye_get_glyph_atlas_page_count(){
+    int count = 0;
+    for(struct ye_glyph_page *page = glyph_pages; page != NULL; page = page->next)
+        count++;
+    return count;
+}
+
+void ye_shutdown_glyph_atlas(){
+    struct ye_glyph_node *node, *tmp;
+    HASH_ITER(hh, glyphs, node, tmp) {
+        HASH_DEL(glyphs, node);
+        free(node);
+    }
+
+    struct ye_glyph_page *page = glyph_pages;
+    while(page != NULL){
+        struct ye_glyph_page *next = page->next;
+        ye_untrack_texture_state(page->texture);
+        SDL_DestroyTexture(page->texture);
+        free(page);
+        page = next;
+    }
+    glyph_pages = NULL;
+
+    ye_logf(info,"%s","Shut down glyph atlas.\n");
+}
@@ -6,6 +6,7 @@
 */
 
 #include <stdio.h>
+#include <string.h>
 
 #if defined __linux__ || defined __APPLE__ || defined __unix__
     #include <unistd.h>
@@ -84,7 +85,7 @@ SDL_Texture *createTextTextureWithOutline(const char *pText, int width, TTF_Font
     SDL_BlitSurface(fg_surface, NULL, bg_surface, &rect); 
     SDL_DestroySurface(fg_surface); 
     SDL_Texture *pTexture = SDL_CreateTextureFromSurface(pRenderer, bg_surface);
-    SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_BLEND);
+    ye_track_texture_state(pTexture, SDL_BLENDMODE_BLEND);
     SDL_DestroySurface(bg_surface);
     
     // error out if texture creation failed
@@ -114,7 +115,7 @@ SDL_Texture *createTextTextureWithOutlineWrapped(const char *pText, int width, T
     SDL_BlitSurface(fg_surface, NULL, bg_surface, &rect); 
     SDL_DestroySurface(fg_surface); 
     SDL_Texture *pTexture = SDL_CreateTextureFromSurface(pRenderer, bg_surface);
-    SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_BLEND);
+    ye_track_texture_state(pTexture, SDL_BLENDMODE_BLEND);
     SDL_DestroySurface(bg_surface);
     
     // error out if texture creation failed
@@ -150,8 +151,8 @@ SDL_Texture *createTextTexture(const char *pText, TTF_Font *pFont, SDL_Color *pC
         return missing_texture; // return missing texture, error has been logged
     }
 
-    // set blend mode for proper alpha blending
-    SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_BLEND);
+    // set blend mode for proper alpha blending (and the quality scale mode)
+    ye_track_texture_state(pTexture, SDL_BLENDMODE_BLEND);
 
     // free the surface memory
     SDL_DestroySurface(pSurface);
@@ -182,8 +183,8 @@ SDL_Texture *createTextTextureWrapped(const char *pText, TTF_Font *pFont, SDL_Co
         return missing_texture; // return missing texture, error has been logged
     }
 
-    // set blend mode for proper alpha blending
-    SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_BLEND);
+    // set blend mode for proper alpha blending (and the quality scale mode)
+    ye_track_texture_state(pTexture, SDL_BLENDMODE_BLEND);
 
     // free the surface memory
     SDL_DestroySurface(pSurface);
@@ -219,8 +220,8 @@ SDL_Texture * ye_create_image_texture(const char *pPath) {
         return missing_texture; // return missing texture, error has been logged
     }
 
-    // set blend mode for proper alpha blending
-    SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_BLEND);
+    // set blend mode for proper alpha blending (and the quality scale mode)
+    ye_track_texture_state(pTexture, SDL_BLENDMODE_BLEND);
 
     // release surface from memory
     SDL_DestroySurface(pImage_surface);
@@ -233,6 +234,70 @@ SDL_Texture * ye_create_image_texture(const char *pPath) {
 int frame_counter = 0;
 int desired_frame_time = 0;
 int fpsUpdateTime = 0;
+
+/*
+    Renderer state ye_render_all last handed to SDL.
+
+    The game and the ui want different viewports / presentations, but most
+    frames at least some of these calls repeat what SDL already has (ex: no
+    boxing means the viewport is NULL for both), so only pass on changes.
+*/
+static struct {
+    bool viewport_valid;
+    bool viewport_full;     // NULL viewport
+    SDL_Rect viewport;
+
+    bool scale_valid;
+    float scale_x, scale_y;
+
+    bool presentation_valid;
+    int presentation_w, presentation_h;
+    SDL_RendererLogicalPresentation presentation_mode;
+} render_state = {0};
+
+void ye_invalidate_render_state(){
+    render_state.viewport_valid = false;
+    render_state.scale_valid = false;
+    render_state.presentation_valid = false;
+}
+
+static void _ye_set_viewport(const SDL_Rect *viewport){
+    bool full = viewport == NULL;
+    if(render_state.viewport_valid && render_state.viewport_full == full
+        && (full || memcmp(&render_state.viewport, viewport, sizeof(SDL_Rect)) == 0))
+        return;
+
+    SDL_SetRenderViewport(pRenderer, viewport);
+    render_state.viewport_valid = true;
+    render_state.viewport_full = full;
+    if(!full)
+        render_state.viewport = *viewport;
+}
+
+static void _ye_set_render_scale(float scale_x, float scale_y){
+    if(render_state.scale_valid && render_state.scale_x == scale_x && render_state.scale_y == scale_y)
+        return;
+
+    SDL_SetRenderScale(pRenderer, scale_x, scale_y);
+    render_state.scale_valid = true;
+    render_state.scale_x = scale_x;
+    render_state.scale_y = scale_y;
+}
+
+static void _ye_set_logical_presentation(int w, int h, SDL_RendererLogicalPresentation mode){
+    if(render_state.presentation_valid && render_state.presentation_w == w
+        && render_state.presentation_h == h && render_state.presentation_mode == mode)
+        return;
+
+    SDL_SetRenderLogicalPresentation(pRenderer, w, h, mode);
+    render_state.presentation_valid = true;
+    render_state.presentation_w = w;
+    render_state.presentation_h = h;
+    render_state.presentation_mode = mode;
+
+    // the viewport is relative to the presentation, dont trust what we remember of it
+    render_state.viewport_valid = false;
+}
 int fps = 0;
 
 void ye_render_all() {
@@ -256,7 +321,7 @@ void ye_render_all() {
     /*
         Clear the screen
     */
-    // SDL_SetRenderTarget(pRenderer, NULL); Disabled, redundant since we dont change targets anymore
+    // no SDL_SetRenderTarget(pRenderer, NULL) needed, tilemap chunk bakes put the previous target back themselves
     SDL_SetRenderDrawColor(pRenderer, 0, 0, 0, 255);
     SDL_RenderClear(pRenderer);
 
@@ -272,10 +337,10 @@ void ye_render_all() {
             stretch res determines the value of need boxing on resize events and init
         */
         if(YE_STATE.engine.need_boxing){
-            SDL_SetRenderViewport(pRenderer, &YE_STATE.engine.letterbox);
+            _ye_set_viewport(&YE_STATE.engine.letterbox);
         }
         else{
-            SDL_SetRenderViewport(pRenderer, NULL);
+            _ye_set_viewport(NULL);
         }
     }
 
@@ -287,27 +352,24 @@ void ye_render_all() {
     */
     if(!YE_STATE.engine.stretch_viewport){
         // credit to my goat: github copilot for this one
-        SDL_SetRenderLogicalPresentation(pRenderer,
-                                        (int)YE_STATE.engine.target_camera->camera->view_field.w,
-                                        (int)YE_STATE.engine.target_camera->camera->view_field.h,
-                                        SDL_LOGICAL_PRESENTATION_LETTERBOX);
+        _ye_set_logical_presentation((int)YE_STATE.engine.target_camera->camera->view_field.w,
+                                    (int)YE_STATE.engine.target_camera->camera->view_field.h,
+                                    SDL_LOGICAL_PRESENTATION_LETTERBOX);
     }
 
     ye_renderer_v2(pRenderer);
 
     /*
         Reset the viewport and scale to render the ui on top.
-
-        TODO: profile the performance of doing this even if these havent changed
+        (only reaches SDL if they changed, see render_state)
     */
-    SDL_SetRenderViewport(pRenderer, NULL);
-    SDL_SetRenderScale(pRenderer, (float)1, (float)1);
+    _ye_set_viewport(NULL);
+    _ye_set_render_scale(1.0f, 1.0f);
 
     // undo the logical presentation
-    SDL_SetRenderLogicalPresentation(pRenderer,
-                                    (int)YE_STATE.engine.screen_width,
-                                    (int)YE_STATE.engine.screen_height,
-                                    SDL_LOGICAL_PRESENTATION_LETTERBOX);
+    _ye_set_logical_presentation((int)YE_STATE.engine.screen_width,
+                                (int)YE_STATE.engine.screen_height,
+                                SDL_LOGICAL_PRESENTATION_LETTERBOX);
 
     ui_render();
 
@@ -330,6 +392,9 @@ void ye_render_all() {
 
 
 void ye_recompute_boxing(){
+    // the window changed under SDL's presentation, re-send everything next frame
+    ye_invalidate_render_state();
+
     // if we are ok playing with stretched res, we dont need to do any boxing
     if(YE_STATE.engine.stretch_resolution){
         YE_STATE.engine.need_boxing = false;
@@ -475,6 +540,9 @@ void ye_init_graphics(){
 
     init_ui(pWindow,pRenderer);
 
+    // new renderer (and init_ui sets its own scale), forget anything we knew
+    ye_invalidate_render_state();
+
     // test for TTF init, alarm if failed
     if (!TTF_Init()) {
         ye_logf(error, "SDL2_ttf could not initialize! SDL2_ttf Error: %s\n", SDL_GetError());
@@ -0,0 +1,213 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <jansson.h>
+
+#include <yoyoengine/yep.h>
+#include <yoyoengine/json.h>
+#include <yoyoengine/scene.h>
+#include <yoyoengine/engine.h>
+#include <yoyoengine/prefab.h>
+#include <yoyoengine/logging.h>
+#include <yoyoengine/types/intern.h>
+#include <yoyoengine/ecs/ecs.h>
+#include <yoyoengine/ecs/tag.h>
+#include <yoyoengine/ecs/component.h>
+#include <yoyoengine/ecs/camera.h>
+#include <yoyoengine/ecs/button.h>
+#include <yoyoengine/ecs/renderer.h>
+#include <yoyoengine/ecs/rigidbody.h>
+#include <yoyoengine/ecs/transform.h>
+#include <yoyoengine/ecs/audiosource.h>
+
+// malloc a copy of a component struct, NULL stays NULL
+static void * _ye_prefab_dup(const void *component, size_t size){
+    if(component == NULL)
+        return NULL;
+
+    void *copy = malloc(size);
+    if(copy != NULL)
+        memcpy(copy, component, size);
+    return copy;
+}
+
+struct ye_prefab * ye_prefab_capture(struct ye_entity *entity){
+    if(entity == NULL){
+        ye_logf(error, "Could not capture prefab, entity is NULL.\n");
+        return NULL;
+    }
+
+    struct ye_prefab *prefab = calloc(1, sizeof(struct ye_prefab));
+    if(prefab == NULL){
+        ye_logf(error, "Failed to allocate prefab for \"%s\".\n", entity->name);
+        return NULL;
+    }
+
+    prefab->name = ye_intern_retain(entity->name);
+    prefab->active = entity->active;
+
+    if(entity->transform != NULL){
+        prefab->has_transform = true;
+        prefab->x = entity->transform->x;
+        prefab->y = entity->transform->y;
+        prefab->rotation = entity->transform->rotation;
+    }
+
+    // shares the clip / laid out text with the entity, so instances never load them again
+    if(entity->renderer != NULL)
+        prefab->renderer = ye_copy_renderer_component(entity->renderer);
+
+    prefab->camera = _ye_prefab_dup(entity->camera, sizeof(struct ye_component_camera));
+    prefab->button = _ye_prefab_dup(entity->button, sizeof(struct ye_component_button));
+    prefab->rigidbody = _ye_prefab_dup(entity->rigidbody, sizeof(struct ye_component_rigidbody));
+    prefab->tag = _ye_prefab_dup(entity->tag, sizeof(struct ye_component_tag));
+
+    prefab->audiosource = _ye_prefab_dup(entity->audiosource, sizeof(struct ye_component_audiosource));
+    if(prefab->audiosource != NULL){
+        prefab->audiosource->handle = ye_intern_retain(entity->audiosource->handle);
+        prefab->audiosource->track = NULL;
+        prefab->audiosource->playing = false;
+    }
+
+    // custom components are copied as plain bytes
+    for(int type = YE_COMPONENT_COUNT; type < YE_MAX_COMPONENT_TYPES; type++){
+        if(entity->signature & YE_COMPONENT_BIT(type))
+            prefab->custom[type - YE_COMPONENT_COUNT] = _ye_prefab_dup(ye_get_component(entity, type), ye_get_component_stride(type));
+    }
+
+    return prefab;
+}
+
+struct ye_prefab * ye_prefab_load(const char *path){
+    if(path == NULL){
+        ye_logf(error, "Could not load prefab, path is NULL.\n");
+        return NULL;
+    }
+
+    json_t *PREFAB = NULL;
+    if(YE_STATE.editor.editor_mode)
+        PREFAB = ye_json_read(ye_path_resources(path));
+    else
+        PREFAB = yep_resource_json(path);
+
+    if(PREFAB == NULL){
+        ye_logf(error, "Failed to load prefab file %s\n", path);
+        return NULL;
+    }
+
+    /*
+        Build the entity once with the regular scene constructors and capture it,
+        the prefab keeps hold of everything it loaded once the template is gone.
+    */
+    struct ye_entity *template = ye_construct_entity(PREFAB);
+    json_decref(PREFAB);
+
+    if(template == NULL){
+        ye_logf(error, "Failed to construct prefab from %s\n", path);
+        return NULL;
+    }
+
+    struct ye_prefab *prefab = ye_prefab_capture(template);
+    ye_destroy_entity(template);
+
+    return prefab;
+}
+
+struct ye_entity * ye_prefab_instantiate(struct ye_prefab *prefab){
+    if(prefab == NULL){
+        ye_logf(error, "Could not instantiate prefab, prefab is NULL.\n");
+        return NULL;
+    }
+
+    struct ye_entity *entity = ye_create_entity_named(prefab->name);
+    entity->active = prefab->active;
+
+    if(prefab->has_transform){
+        ye_add_transform_component(entity, prefab->x, prefab->y);
+        entity->transform->rotation = prefab->rotation;
+    }
+    if(prefab->renderer != NULL){
+        ye_add_renderer_component_copy(entity, prefab->renderer);
+    }
+    if(prefab->camera != NULL){
+        ye_add_camera_component(entity, prefab->camera->z, prefab->camera->view_field);
+        entity->camera->active = prefab->camera->active;
+        entity->camera->relative = prefab->camera->relative;
+        entity->camera->lock_aspect_ratio = prefab->camera->lock_aspect_ratio;
+    }
+    if(prefab->button != NULL){
+        ye_add_button_component(entity, prefab->button->rect);
+        entity->button->active = prefab->button->active;
+        entity->button->relative = prefab->button->relative;
+    }
+    if(prefab->rigidbody != NULL && entity->transform != NULL){
+        ye_add_rigidbody_component(entity, prefab->rigidbody->transform_offset_x, prefab->rigidbody->transform_offset_y, prefab->rigidbody->p2d_object);
+        entity->rigidbody->active = prefab->rigidbody->active;
+    }
+    if(prefab->tag != NULL){
+        ye_add_tag_component(entity);
+        for(int i = 0; i < YE_TAG_MAX_NUMBER; i++){
+            if(prefab->tag->tags[i] != YE_TAG_NONE){
+                ye_add_tag(entity, ye_tag_name(prefab->tag->tags[i]));
+            }
+        }
+        entity->tag->active = prefab->tag->active;
+    }
+    if(prefab->audiosource != NULL){
+        ye_add_audiosource_component(entity, prefab->audiosource->handle, prefab->audiosource->volume, prefab->audiosource->play_on_awake, prefab->audiosource->loops, prefab->audiosource->simulated, prefab->audiosource->range);
+        entity->audiosource->active = prefab->audiosource->active;
+        entity->audiosource->relative = prefab->audiosource->relative;
+    }
+    for(int type = YE_COMPONENT_COUNT; type < YE_MAX_COMPONENT_TYPES; type++){
+        if(prefab->custom[type - YE_COMPONENT_COUNT] == NULL)
+            continue;
+
+        void *component = ye_add_component(entity, type);
+        if(component != NULL)
+            memcpy(component, prefab->custom[type - YE_COMPONENT_COUNT], ye_get_component_stride(type));
+    }
+
+    return entity;
+}
+
+int ye_prefab_instantiate_n(struct ye_prefab *prefab, int count, struct ye_entity **out){
+    if(prefab == NULL || count <= 0)
+        return 0;
+
+    int created = 0;
+    for(int i = 0; i < count; i++){
+        struct ye_entity *entity = ye_prefab_instantiate(prefab);
+        if(entity == NULL)
+            break;
+        if(out != NULL)
+            out[created] = entity;
+        created++;
+    }
+    return created;
+}
+
+void ye_prefab_free(struct ye_prefab *prefab){
+    if(prefab == NULL)
+        return;
+
+    ye_free_renderer_component(prefab->renderer);
+    if(prefab->audiosource != NULL)
+        ye_intern_release(prefab->audiosource->handle);
+
+    free(prefab->camera);
+    free(prefab->button);
+    free(prefab->rigidbody);
+    free(prefab->tag);
+    free(prefab->audiosource);
+    for(int i = 0; i < YE_MAX_COMPONENT_TYPES - YE_COMPONENT_COUNT; i++)
+        free(prefab->custom[i]);
+    ye_intern_release(prefab->name);
+    free(prefab);
+}
@@ -289,6 +289,36 @@ void ye_construct_renderer(struct ye_entity* e, json_t* renderer, const char* en
             
             ye_add_tilemap_renderer_component(e,z,src,src_rect);
             break;
+        case YE_RENDERER_TYPE_TILEMAP_LAYER: {
+            // get the tileset
+            if(!ye_json_string(impl,"tileset",&src)) {
+                ye_logf(warning,"Entity \"%s\" has a tilemap layer renderer, but it is missing the tileset field\n", entity_name);
+                return;
+            }
+
+            int tile_w, tile_h, cols, rows;
+            if(!ye_json_int(impl,"tile width",&tile_w) || !ye_json_int(impl,"tile height",&tile_h) ||
+                !ye_json_int(impl,"columns",&cols) || !ye_json_int(impl,"rows",&rows)) {
+                ye_logf(warning,"Entity \"%s\" has a tilemap layer renderer, but it is missing its tile width, tile height, columns or rows field\n", entity_name);
+                return;
+            }
+
+            ye_add_tilemap_layer_renderer_component(e,z,src,tile_w,tile_h,cols,rows);
+            if(e->renderer == NULL)
+                return;
+
+            // tiles are optional (row major tileset indices, -1 for none), a layer can start out empty
+            json_t *tiles = NULL;
+            if(ye_json_array(impl,"tiles",&tiles)) {
+                size_t count = json_array_size(tiles);
+                if(count != (size_t)cols * rows)
+                    ye_logf(warning,"Entity \"%s\" has %zu tiles, but its tilemap layer is %dx%d\n", entity_name, count, cols, rows);
+
+                for(size_t i = 0; i < count && i < (size_t)cols * rows; i++)
+                    ye_tilemap_layer_set_tile(e, (int)(i % cols), (int)(i / cols), (int)json_integer_value(json_array_get(tiles, i)));
+            }
+            break;
+        }
         default:
             ye_logf(warning,"Entity %s has a renderer component, but it is missing the type field\n", entity_name);
             break;
@@ -633,105 +663,111 @@ void ye_construct_button(struct ye_entity* e, json_t* button){
     ===================================================================
 */
 
-void ye_construct_scene(json_t *entities){
-    /*
-        traverse backwards (serialization is traversing LL,
-        so we need to reverse it to keep the same order)
-    */
-    for(int i = json_array_size(entities) - 1; i >= 0; i--){
-        json_t *entity = NULL;      ye_json_arr_object(entities,i,&entity);    
-        
-        // get entity name
-        const char *entity_name = NULL;   ye_json_string(entity,"name",&entity_name);
-        struct ye_entity *e = NULL;
-        if(entity_name == NULL){
-            ye_logf(warning,"Unnamed entity in scene file. It's name will be automatically assigned.\n");
-            e = ye_create_entity();
-        }
-        else{
-            // ye_logf(info,"Constructing entity: %s\n", entity_name);
-            e = ye_create_entity_named(entity_name);
-        }
+struct ye_entity * ye_construct_entity(json_t *entity){
+    if(entity == NULL){
+        ye_logf(error,"Failed to construct entity.\n");
+        return NULL;
+    }
 
-        if(entity == NULL){
-            ye_logf(error,"Failed to construct entity.\n");
-            continue;
-        }
+    // get entity name
+    const char *entity_name = NULL;   ye_json_string(entity,"name",&entity_name);
+    struct ye_entity *e = NULL;
+    if(entity_name == NULL){
+        ye_logf(warning,"Unnamed entity in scene file. It's name will be automatically assigned.\n");
+        e = ye_create_entity();
+    }
+    else{
+        // ye_logf(info,"Constructing entity: %s\n", entity_name);
+        e = ye_create_entity_named(entity_name);
+    }
 
-        // set entities properties
-        if(ye_json_has_key(entity,"active")){
-            bool active = true;    ye_json_bool(entity,"active",&active);
-            e->active = active;
-        }
+    // set entities properties
+    if(ye_json_has_key(entity,"active")){
+        bool active = true;    ye_json_bool(entity,"active",&active);
+        e->active = active;
+    }
 
-        // check if components exist
-        json_t *components = NULL; ye_json_object(entity,"components",&components);
+    // check if components exist
+    json_t *components = NULL; ye_json_object(entity,"components",&components);
 
-        // if we have transform on entity
-        if(ye_json_has_key(components,"transform")){
-            json_t *transform = NULL; ye_json_object(components,"transform",&transform);
-            ye_construct_transform(e,transform,entity_name);
-        }
+    // if we have transform on entity
+    if(ye_json_has_key(components,"transform")){
+        json_t *transform = NULL; ye_json_object(components,"transform",&transform);
+        ye_construct_transform(e,transform,entity_name);
+    }
 
-        // if we have camera on entity
-        if(ye_json_has_key(components,"camera")){
-            json_t *camera = NULL; ye_json_object(components,"camera",&camera);
-            if(camera == NULL){
-                ye_logf(warning,"Entity %s has a renderer field, but it's invalid.\n", entity_name);
-                continue;
-            }
-            ye_construct_camera(e,camera,entity_name);
+    // if we have camera on entity
+    if(ye_json_has_key(components,"camera")){
+        json_t *camera = NULL; ye_json_object(components,"camera",&camera);
+        if(camera == NULL){
+            ye_logf(warning,"Entity %s has a renderer field, but it's invalid.\n", entity_name);
+            return e;
         }
-        
-        // if we have a renderer on our entity
-        if(ye_json_has_key(components,"renderer")){
-            json_t *renderer = NULL; ye_json_object(components,"renderer",&renderer);
-            if(renderer == NULL){
-                ye_logf(warning,"Entity %s has a renderer field, but it's invalid.\n", entity_name);
-                continue;
-            }
-            ye_construct_renderer(e,renderer,entity_name);
+        ye_construct_camera(e,camera,entity_name);
+    }
+    
+    // if we have a renderer on our entity
+    if(ye_json_has_key(components,"renderer")){
+        json_t *renderer = NULL; ye_json_object(components,"renderer",&renderer);
+        if(renderer == NULL){
+            ye_logf(warning,"Entity %s has a renderer field, but it's invalid.\n", entity_name);
+            return e;
         }
+        ye_construct_renderer(e,renderer,entity_name);
+    }
 
-        // if we have a rigidbody component on our entity
-        if(ye_json_has_key(components,"rigidbody")){
-            json_t *rigidbody = NULL; ye_json_object(components,"rigidbody",&rigidbody);
-            if(rigidbody == NULL){
-                ye_logf(warning,"Entity %s has a rigidbody field, but it's invalid.\n", entity_name);
-                continue;
-            }
-            ye_construct_rigidbody(e,rigidbody,entity_name);
+    // if we have a rigidbody component on our entity
+    if(ye_json_has_key(components,"rigidbody")){
+        json_t *rigidbody = NULL; ye_json_object(components,"rigidbody",&rigidbody);
+        if(rigidbody == NULL){
+            ye_logf(warning,"Entity %s has a rigidbody field, but it's invalid.\n", entity_name);
+            return e;
         }
+        ye_construct_rigidbody(e,rigidbody,entity_name);
+    }
 
-        // if we have a tag component on our entity
-        if(ye_json_has_key(components,"tag")){
-            json_t *tag = NULL; ye_json_object(components,"tag",&tag);
-            if(tag == NULL){
-                ye_logf(warning,"Entity %s has a tag field, but it's invalid.\n", entity_name);
-                continue;
-            }
-            ye_construct_tag(e,tag);
+    // if we have a tag component on our entity
+    if(ye_json_has_key(components,"tag")){
+        json_t *tag = NULL; ye_json_object(components,"tag",&tag);
+        if(tag == NULL){
+            ye_logf(warning,"Entity %s has a tag field, but it's invalid.\n", entity_name);
+            return e;
         }
+        ye_construct_tag(e,tag);
+    }
 
-        // if we have an audiosource
-        if(ye_json_has_key(components,"audiosource")){
-            json_t *audiosource = NULL; ye_json_object(components,"audiosource",&audiosource);
-            if(audiosource == NULL){
-                ye_logf(warning,"Entity %s has a audiosource field, but it's invalid.\n", entity_name);
-                continue;
-            }
-            ye_construct_audiosource(e,audiosource,entity_name);
+    // if we have an audiosource
+    if(ye_json_has_key(components,"audiosource")){
+        json_t *audiosource = NULL; ye_json_object(components,"audiosource",&audiosource);
+        if(audiosource == NULL){
+            ye_logf(warning,"Entity %s has a audiosource field, but it's invalid.\n", entity_name);
+            return e;
         }
+        ye_construct_audiosource(e,audiosource,entity_name);
+    }
 
-        // button comp
-        if(ye_json_has_key(components,"button")){
-            json_t *button = NULL; ye_json_object(components,"button",&button);
-            if(button == NULL){
-                ye_logf(warning,"Entity %s has a button field, but it's invalid.\n", entity_name);
-                continue;
-            }
-            ye_construct_button(e,button);
+    // button comp
+    if(ye_json_has_key(components,"button")){
+        json_t *button = NULL; ye_json_object(components,"button",&button);
+        if(button == NULL){
+            ye_logf(warning,"Entity %s has a button field, but it's invalid.\n", entity_name);
+            return e;
         }
+        ye_construct_button(e,button);
+    }
+
+    return e;
+}
+
+void ye_construct_scene(json_t *entities){
+    /*
+        traverse backwards (scenes are serialized newest entity first,
+        from when entities lived in a head inserted LL, so we need to
+        reverse it to keep the same order)
+    */
+    for(int i = json_array_size(entities) - 1; i >= 0; i--){
+        json_t *entity = NULL;      ye_json_arr_object(entities,i,&entity);    
+        ye_construct_entity(entity);
     }
 }
 
@@ -821,7 +857,7 @@ void ye_raw_scene_load(json_t *SCENE) {
         ye_logf(error,"Scene \"%s\" has no default camera\n", YE_STATE.runtime.scene_name);
     }
     else{
-        struct ye_entity *camera = ye_get_entity_by_name(default_camera_name);
+        struct ye_entity *camera = ye_try_get_entity_by_name(default_camera_name);
         if(!YE_STATE.editor.editor_mode){
             ye_logf(info,"Setting default camera to: %s\n", default_camera_name);
             if(camera == NULL){
@@ -0,0 +1,1145 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <SDL.h>
+
+#include <p2d/p2d.h>
+
+#include <yoyoengine/cache.h>
+#include <yoyoengine/engine.h>
+#include <yoyoengine/logging.h>
+#include <yoyoengine/snapshot.h>
+#include <yoyoengine/types/intern.h>
+#include <yoyoengine/ecs/ecs.h>
+#include <yoyoengine/ecs/tag.h>
+#include <yoyoengine/ecs/camera.h>
+#include <yoyoengine/ecs/button.h>
+#include <yoyoengine/ecs/renderer.h>
+#include <yoyoengine/ecs/rigidbody.h>
+#include <yoyoengine/ecs/transform.h>
+#include <yoyoengine/ecs/component.h>
+#include <yoyoengine/ecs/audiosource.h>
+
+#define YE_SNAPSHOT_MAGIC   0x50414E53 // "SNAP"
+#define YE_SNAPSHOT_VERSION 2
+
+/*
+    ==========================================
+                    WRITING
+    ==========================================
+*/
+
+struct _ye_snapshot_writer {
+    struct ye_snapshot *snapshot;
+    bool ok;
+};
+
+static void _ye_put(struct _ye_snapshot_writer *w, const void *src, size_t size){
+    if(!w->ok)
+        return;
+
+    struct ye_snapshot *s = w->snapshot;
+    if(s->size + size > s->capacity){
+        size_t capacity = s->capacity > 0 ? s->capacity : 4096;
+        while(s->size + size > capacity)
+            capacity *= 2;
+
+        unsigned char *data = realloc(s->data, capacity);
+        if(data == NULL){
+            ye_logf(error, "Failed to grow snapshot to %zu bytes.\n", capacity);
+            w->ok = false;
+            return;
+        }
+        s->data = data;
+        s->capacity = capacity;
+    }
+
+    memcpy(s->data + s->size, src, size);
+    s->size += size;
+}
+
+static void _ye_put_u64(struct _ye_snapshot_writer *w, uint64_t v) { _ye_put(w, &v, sizeof(v)); }
+static void _ye_put_u32(struct _ye_snapshot_writer *w, uint32_t v) { _ye_put(w, &v, sizeof(v)); }
+static void _ye_put_i32(struct _ye_snapshot_writer *w, int32_t v)  { _ye_put(w, &v, sizeof(v)); }
+static void _ye_put_f32(struct _ye_snapshot_writer *w, float v)    { _ye_put(w, &v, sizeof(v)); }
+static void _ye_put_bool(struct _ye_snapshot_writer *w, bool v)    { uint8_t b = v; _ye_put(w, &b, sizeof(b)); }
+
+static void _ye_put_rectf(struct _ye_snapshot_writer *w, struct ye_rectf r){
+    _ye_put_f32(w, r.x); _ye_put_f32(w, r.y); _ye_put_f32(w, r.w); _ye_put_f32(w, r.h);
+}
+
+// strings are stored with their terminator (length 0 means NULL) so restore can point right at them
+static void _ye_put_str(struct _ye_snapshot_writer *w, const char *str){
+    if(str == NULL){
+        _ye_put_u32(w, 0);
+        return;
+    }
+    uint32_t len = (uint32_t)strlen(str) + 1;
+    _ye_put_u32(w, len);
+    _ye_put(w, str, len);
+}
+
+/*
+    ==========================================
+                    READING
+    ==========================================
+*/
+
+struct _ye_snapshot_reader {
+    const unsigned char *data;
+    size_t size;
+    size_t pos;
+    bool ok;
+};
+
+static void _ye_get(struct _ye_snapshot_reader *r, void *dst, size_t size){
+    if(!r->ok || r->pos + size > r->size){
+        r->ok = false;
+        memset(dst, 0, size);
+        return;
+    }
+    memcpy(dst, r->data + r->pos, size);
+    r->pos += size;
+}
+
+static uint64_t _ye_get_u64(struct _ye_snapshot_reader *r) { uint64_t v; _ye_get(r, &v, sizeof(v)); return v; }
+static uint32_t _ye_get_u32(struct _ye_snapshot_reader *r) { uint32_t v; _ye_get(r, &v, sizeof(v)); return v; }
+static int32_t _ye_get_i32(struct _ye_snapshot_reader *r)  { int32_t v;  _ye_get(r, &v, sizeof(v)); return v; }
+static float _ye_get_f32(struct _ye_snapshot_reader *r)    { float v;    _ye_get(r, &v, sizeof(v)); return v; }
+static bool _ye_get_bool(struct _ye_snapshot_reader *r)    { uint8_t b;  _ye_get(r, &b, sizeof(b)); return b != 0; }
+
+static struct ye_rectf _ye_get_rectf(struct _ye_snapshot_reader *r){
+    struct ye_rectf rect;
+    rect.x = _ye_get_f32(r); rect.y = _ye_get_f32(r); rect.w = _ye_get_f32(r); rect.h = _ye_get_f32(r);
+    return rect;
+}
+
+static const char * _ye_get_str(struct _ye_snapshot_reader *r){
+    uint32_t len = _ye_get_u32(r);
+    if(!r->ok || len == 0)
+        return NULL;
+
+    if(r->pos + len > r->size || r->data[r->pos + len - 1] != '\0'){
+        r->ok = false;
+        return NULL;
+    }
+
+    const char *str = (const char *)(r->data + r->pos);
+    r->pos += len;
+    return str;
+}
+
+/*
+    ==========================================
+                    CAPTURE
+    ==========================================
+*/
+
+// position of an entity in the entity set, which is also its index in the snapshot
+static int32_t _ye_snapshot_index(struct ye_entity *entity){
+    return entity != NULL ? entity->_set_index[YE_COMPONENT_COUNT] : -1;
+}
+
+static void _ye_capture_renderer(struct _ye_snapshot_writer *w, struct ye_component_renderer *rend){
+    _ye_put_i32(w, rend->type);
+    _ye_put_bool(w, rend->active);
+    _ye_put_i32(w, rend->z);
+    _ye_put_i32(w, rend->alpha);
+    _ye_put_bool(w, rend->relative);
+    _ye_put_rectf(w, rend->rect);
+    _ye_put_i32(w, rend->alignment);
+    _ye_put_bool(w, rend->preserve_original_size);
+    _ye_put_i32(w, rend->center.x);
+    _ye_put_i32(w, rend->center.y);
+    _ye_put_f32(w, rend->rotation);
+    _ye_put_bool(w, rend->flipped_x);
+    _ye_put_bool(w, rend->flipped_y);
+    _ye_put_bool(w, rend->lock_aspect_ratio);
+
+    switch(rend->type){
+        case YE_RENDERER_TYPE_IMAGE:
+            _ye_put_str(w, rend->renderer_impl.image->src);
+            break;
+        case YE_RENDERER_TYPE_TEXT: {
+            struct ye_component_renderer_text *text = rend->renderer_impl.text;
+            _ye_put_str(w, text->text);
+            _ye_put_str(w, text->font_name);
+            _ye_put_i32(w, text->font_size);
+            _ye_put_str(w, text->color_name);
+            _ye_put_i32(w, text->wrap_width);
+            break;
+        }
+        case YE_RENDERER_TYPE_TEXT_OUTLINED: {
+            struct ye_component_renderer_text_outlined *text = rend->renderer_impl.text_outlined;
+            _ye_put_str(w, text->text);
+            _ye_put_str(w, text->font_name);
+            _ye_put_i32(w, text->font_size);
+            _ye_put_str(w, text->color_name);
+            _ye_put_i32(w, text->wrap_width);
+            _ye_put_str(w, text->outline_color_name);
+            _ye_put_i32(w, text->outline_size);
+            break;
+        }
+        case YE_RENDERER_TYPE_ANIMATION: {
+            struct ye_component_renderer_animation *anim = rend->renderer_impl.animation;
+            _ye_put_str(w, anim->meta_file);
+            _ye_put_str(w, anim->animation_handle);
+            _ye_put_i32(w, (int32_t)anim->frame_count);
+            _ye_put_i32(w, anim->frame_width);
+            _ye_put_i32(w, anim->frame_height);
+            _ye_put_i32(w, anim->frame_delay);
+            _ye_put_i32(w, anim->loops);
+            _ye_put_bool(w, anim->paused);
+            _ye_put_i32(w, anim->current_frame_index);
+            _ye_put_i32(w, (int32_t)(SDL_GetTicks() - anim->start_time)); // time into the animation, its frame is computed from it
+            break;
+        }
+        case YE_RENDERER_TYPE_TILEMAP_TILE: {
+            struct ye_component_renderer_tilemap_tile *tile = rend->renderer_impl.tile;
+            _ye_put_str(w, tile->handle);
+            _ye_put_i32(w, tile->src.x);
+            _ye_put_i32(w, tile->src.y);
+            _ye_put_i32(w, tile->src.w);
+            _ye_put_i32(w, tile->src.h);
+            break;
+        }
+        case YE_RENDERER_TYPE_TILEMAP_LAYER: {
+            struct ye_component_renderer_tilemap_layer *layer = rend->renderer_impl.tilemap_layer;
+            _ye_put_str(w, layer->tileset);
+            _ye_put_i32(w, layer->tile_w);
+            _ye_put_i32(w, layer->tile_h);
+            _ye_put_i32(w, layer->cols);
+            _ye_put_i32(w, layer->rows);
+            for(int i = 0; i < layer->cols * layer->rows; i++)
+                _ye_put_i32(w, layer->tiles[i]);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void _ye_capture_rigidbody(struct _ye_snapshot_writer *w, struct ye_component_rigidbody *rb){
+    struct p2d_object *obj = &rb->p2d_object;
+
+    _ye_put_bool(w, rb->active);
+    _ye_put_f32(w, rb->transform_offset_x);
+    _ye_put_f32(w, rb->transform_offset_y);
+
+    _ye_put_i32(w, obj->type);
+    _ye_put_bool(w, obj->is_static);
+    _ye_put_bool(w, obj->is_trigger);
+    _ye_put_i32(w, obj->mask);
+    _ye_put_f32(w, obj->density);
+    _ye_put_f32(w, obj->restitution);
+    if(obj->type == P2D_OBJECT_RECTANGLE){
+        _ye_put_f32(w, obj->rectangle.width);
+        _ye_put_f32(w, obj->rectangle.height);
+    }
+    else{
+        _ye_put_f32(w, obj->circle.radius);
+        _ye_put_f32(w, 0);
+    }
+
+    // simulation state
+    _ye_put_f32(w, obj->x);
+    _ye_put_f32(w, obj->y);
+    _ye_put_f32(w, obj->rotation);
+    _ye_put_f32(w, obj->vx);
+    _ye_put_f32(w, obj->vy);
+    _ye_put_f32(w, obj->vr);
+}
+
+bool ye_snapshot_capture(struct ye_snapshot *snapshot){
+    if(snapshot == NULL){
+        ye_logf(error, "Could not capture snapshot, snapshot is NULL.\n");
+        return false;
+    }
+
+    struct _ye_snapshot_writer w = { .snapshot = snapshot, .ok = true };
+    snapshot->size = 0;
+
+    struct ye_entity_set *entities = ye_get_entity_set();
+
+    _ye_put_u32(&w, YE_SNAPSHOT_MAGIC);
+    _ye_put_u32(&w, YE_SNAPSHOT_VERSION);
+    _ye_put_i32(&w, entities->count);
+    _ye_put_i32(&w, _ye_snapshot_index(YE_STATE.engine.target_camera));
+
+    // handles up front, so restore knows what survives before it touches anything
+    for(int i = 0; i < entities->count; i++){
+        struct ye_entity_handle handle = ye_get_entity_handle(entities->entities[i]);
+        _ye_put_i32(&w, handle.id);
+        _ye_put_u32(&w, handle.generation);
+    }
+
+    for(int i = 0; i < entities->count; i++){
+        struct ye_entity *e = entities->entities[i];
+
+        _ye_put_str(&w, e->name);
+        _ye_put_bool(&w, e->active);
+        _ye_put_u64(&w, e->signature);
+
+        if(e->transform){
+            _ye_put_f32(&w, e->transform->x);
+            _ye_put_f32(&w, e->transform->y);
+            _ye_put_f32(&w, e->transform->rotation);
+            _ye_put_i32(&w, _ye_snapshot_index(e->transform->parent));
+        }
+
+        if(e->renderer)
+            _ye_capture_renderer(&w, e->renderer);
+
+        if(e->rigidbody)
+            _ye_capture_rigidbody(&w, e->rigidbody);
+
+        if(e->audiosource){
+            struct ye_component_audiosource *as = e->audiosource;
+            _ye_put_bool(&w, as->active);
+            _ye_put_bool(&w, as->simulated);
+            _ye_put_str(&w, as->handle);
+            _ye_put_f32(&w, as->volume);
+            _ye_put_rectf(&w, as->range);
+            _ye_put_bool(&w, as->relative);
+            _ye_put_bool(&w, as->play_on_awake);
+            _ye_put_i32(&w, as->loops);
+        }
+
+        if(e->camera){
+            _ye_put_bool(&w, e->camera->active);
+            _ye_put_bool(&w, e->camera->relative);
+            _ye_put_i32(&w, e->camera->z);
+            _ye_put_rectf(&w, e->camera->view_field);
+            _ye_put_bool(&w, e->camera->lock_aspect_ratio);
+        }
+
+        if(e->tag){
+            int count = 0;
+            for(int t = 0; t < YE_TAG_MAX_NUMBER; t++)
+                if(e->tag->tags[t] != YE_TAG_NONE)
+                    count++;
+
+            _ye_put_i32(&w, count);
+            for(int t = 0; t < YE_TAG_MAX_NUMBER; t++)
+                if(e->tag->tags[t] != YE_TAG_NONE)
+                    _ye_put_str(&w, ye_tag_name(e->tag->tags[t]));
+        }
+
+        if(e->button){
+            _ye_put_bool(&w, e->button->active);
+            _ye_put_bool(&w, e->button->relative);
+            _ye_put_rectf(&w, e->button->rect);
+        }
+
+        // custom components go by type name (ids depend on registration order), raw bytes
+        int custom_count = 0;
+        for(int type = YE_COMPONENT_COUNT; type < YE_MAX_COMPONENT_TYPES; type++)
+            if(e->signature & YE_COMPONENT_BIT(type))
+                custom_count++;
+
+        _ye_put_i32(&w, custom_count);
+        for(int type = YE_COMPONENT_COUNT; type < YE_MAX_COMPONENT_TYPES; type++){
+            if(!(e->signature & YE_COMPONENT_BIT(type)))
+                continue;
+
+            size_t stride = ye_get_component_stride(type);
+            _ye_put_str(&w, ye_get_component_type_name(type));
+            _ye_put_u32(&w, (uint32_t)stride);
+            _ye_put(&w, ye_get_component(e, type), stride);
+        }
+    }
+
+    return w.ok;
+}
+
+/*
+    ==========================================
+                    DECODE
+    ==========================================
+
+    The whole snapshot is decoded and validated before the ECS is touched,
+    strings point straight into the snapshot buffer.
+*/
+
+struct _ye_snapshot_entity {
+    struct ye_entity_handle handle;
+    struct ye_entity *entity;   // live entity this record is applied to
+
+    const char *name;
+    bool active;
+    uint64_t signature;
+
+    struct {
+        float x, y, rotation;
+        int32_t parent;
+    } transform;
+
+    struct {
+        enum ye_component_renderer_type type;
+        bool active;
+        int32_t z, alpha;
+        bool relative;
+        struct ye_rectf rect;
+        int32_t alignment;
+        bool preserve_original_size;
+        SDL_Point center;
+        float rotation;
+        bool flipped_x, flipped_y, lock_aspect_ratio;
+
+        const char *handle;     // image src, text, meta file, tile handle or tileset
+        const char *font_name, *color_name, *outline_color_name, *animation_handle;
+        int32_t font_size, wrap_width, outline_size;
+        int32_t frame_count, frame_width, frame_height, frame_delay, loops, current_frame_index, elapsed;
+        bool paused;
+        SDL_Rect tile_src;      // tilemap layers keep their tile size in w, h
+        int32_t layer_cols, layer_rows;
+        const unsigned char *layer_tiles;   // layer_cols*layer_rows int32s, in the snapshot buffer (unaligned)
+    } renderer;
+
+    struct {
+        bool active;
+        float transform_offset_x, transform_offset_y;
+        struct p2d_object object;
+    } rigidbody;
+
+    struct {
+        bool active, simulated, relative, play_on_awake;
+        const char *handle;
+        float volume;
+        struct ye_rectf range;
+        int32_t loops;
+    } audiosource;
+
+    struct {
+        bool active, relative, lock_aspect_ratio;
+        int32_t z;
+        struct ye_rectf view_field;
+    } camera;
+
+    struct {
+        int32_t count;
+        const char *names[YE_TAG_MAX_NUMBER];
+    } tag;
+
+    struct {
+        bool active, relative;
+        struct ye_rectf rect;
+    } button;
+
+    struct {
+        int32_t count;
+        const char *names[YE_MAX_COMPONENT_TYPES - YE_COMPONENT_COUNT];
+        uint32_t sizes[YE_MAX_COMPONENT_TYPES - YE_COMPONENT_COUNT];
+        const unsigned char *data[YE_MAX_COMPONENT_TYPES - YE_COMPONENT_COUNT]; // in the snapshot buffer (unaligned)
+    } custom;
+};
+
+static void _ye_decode_renderer(struct _ye_snapshot_reader *r, struct _ye_snapshot_entity *rec){
+    rec->renderer.type = (enum ye_component_renderer_type)_ye_get_i32(r); // unknown values fail the switch below
+    rec->renderer.active = _ye_get_bool(r);
+    rec->renderer.z = _ye_get_i32(r);
+    rec->renderer.alpha = _ye_get_i32(r);
+    rec->renderer.relative = _ye_get_bool(r);
+    rec->renderer.rect = _ye_get_rectf(r);
+    rec->renderer.alignment = _ye_get_i32(r);
+    rec->renderer.preserve_original_size = _ye_get_bool(r);
+    rec->renderer.center.x = _ye_get_i32(r);
+    rec->renderer.center.y = _ye_get_i32(r);
+    rec->renderer.rotation = _ye_get_f32(r);
+    rec->renderer.flipped_x = _ye_get_bool(r);
+    rec->renderer.flipped_y = _ye_get_bool(r);
+    rec->renderer.lock_aspect_ratio = _ye_get_bool(r);
+
+    switch(rec->renderer.type){
+        case YE_RENDERER_TYPE_IMAGE:
+            rec->renderer.handle = _ye_get_str(r);
+            break;
+        case YE_RENDERER_TYPE_TEXT:
+        case YE_RENDERER_TYPE_TEXT_OUTLINED:
+            rec->renderer.handle = _ye_get_str(r);
+            rec->renderer.font_name = _ye_get_str(r);
+            rec->renderer.font_size = _ye_get_i32(r);
+            rec->renderer.color_name = _ye_get_str(r);
+            rec->renderer.wrap_width = _ye_get_i32(r);
+            if(rec->renderer.type == YE_RENDERER_TYPE_TEXT_OUTLINED){
+                rec->renderer.outline_color_name = _ye_get_str(r);
+                rec->renderer.outline_size = _ye_get_i32(r);
+            }
+            if(r->ok && (rec->renderer.handle == NULL || rec->renderer.font_name == NULL || rec->renderer.color_name == NULL ||
+                (rec->renderer.type == YE_RENDERER_TYPE_TEXT_OUTLINED && rec->renderer.outline_color_name == NULL)))
+                r->ok = false;
+            break;
+        case YE_RENDERER_TYPE_ANIMATION:
+            rec->renderer.handle = _ye_get_str(r);
+            rec->renderer.animation_handle = _ye_get_str(r);
+            rec->renderer.frame_count = _ye_get_i32(r);
+            rec->renderer.frame_width = _ye_get_i32(r);
+            rec->renderer.frame_height = _ye_get_i32(r);
+            rec->renderer.frame_delay = _ye_get_i32(r);
+            rec->renderer.loops = _ye_get_i32(r);
+            rec->renderer.paused = _ye_get_bool(r);
+            rec->renderer.current_frame_index = _ye_get_i32(r);
+            rec->renderer.elapsed = _ye_get_i32(r);
+            if(r->ok && (rec->renderer.handle == NULL || rec->renderer.animation_handle == NULL || rec->renderer.frame_count <= 0))
+                r->ok = false;
+            break;
+        case YE_RENDERER_TYPE_TILEMAP_TILE:
+            rec->renderer.handle = _ye_get_str(r);
+            rec->renderer.tile_src.x = _ye_get_i32(r);
+            rec->renderer.tile_src.y = _ye_get_i32(r);
+            rec->renderer.tile_src.w = _ye_get_i32(r);
+            rec->renderer.tile_src.h = _ye_get_i32(r);
+            if(r->ok && rec->renderer.handle == NULL)
+                r->ok = false;
+            break;
+        case YE_RENDERER_TYPE_TILEMAP_LAYER:
+            rec->renderer.handle = _ye_get_str(r);
+            rec->renderer.tile_src.w = _ye_get_i32(r);
+            rec->renderer.tile_src.h = _ye_get_i32(r);
+            rec->renderer.layer_cols = _ye_get_i32(r);
+            rec->renderer.layer_rows = _ye_get_i32(r);
+            if(r->ok && (rec->renderer.handle == NULL || rec->renderer.tile_src.w <= 0 || rec->renderer.tile_src.h <= 0 ||
+                rec->renderer.layer_cols <= 0 || rec->renderer.layer_rows <= 0 ||
+                (uint64_t)rec->renderer.layer_cols * (uint64_t)rec->renderer.layer_rows > (r->size - r->pos) / sizeof(int32_t)))
+                r->ok = false;
+            if(r->ok){
+                // the tiles are read right out of the buffer when restoring
+                rec->renderer.layer_tiles = r->data + r->pos;
+                r->pos += (size_t)rec->renderer.layer_cols * rec->renderer.layer_rows * sizeof(int32_t);
+            }
+            break;
+        default:
+            r->ok = false; // unknown renderer type
+            break;
+    }
+}
+
+static void _ye_decode_rigidbody(struct _ye_snapshot_reader *r, struct _ye_snapshot_entity *rec){
+    struct p2d_object *obj = &rec->rigidbody.object;
+    memset(obj, 0, sizeof(struct p2d_object));
+
+    rec->rigidbody.active = _ye_get_bool(r);
+    rec->rigidbody.transform_offset_x = _ye_get_f32(r);
+    rec->rigidbody.transform_offset_y = _ye_get_f32(r);
+
+    obj->type = _ye_get_i32(r);
+    obj->is_static = _ye_get_bool(r);
+    obj->is_trigger = _ye_get_bool(r);
+    obj->mask = _ye_get_i32(r);
+    obj->density = _ye_get_f32(r);
+    obj->restitution = _ye_get_f32(r);
+    float a = _ye_get_f32(r);
+    float b = _ye_get_f32(r);
+    if(obj->type == P2D_OBJECT_RECTANGLE){
+        obj->rectangle.width = a;
+        obj->rectangle.height = b;
+    }
+    else{
+        obj->circle.radius = a;
+    }
+
+    obj->x = _ye_get_f32(r);
+    obj->y = _ye_get_f32(r);
+    obj->rotation = _ye_get_f32(r);
+    obj->vx = _ye_get_f32(r);
+    obj->vy = _ye_get_f32(r);
+    obj->vr = _ye_get_f32(r);
+}
+
+static bool _ye_decode_entity(struct _ye_snapshot_reader *r, struct _ye_snapshot_entity *rec, int32_t entity_count){
+    rec->name = _ye_get_str(r);
+    rec->active = _ye_get_bool(r);
+    rec->signature = _ye_get_u64(r);
+
+    if(rec->signature & YE_SIG_TRANSFORM){
+        rec->transform.x = _ye_get_f32(r);
+        rec->transform.y = _ye_get_f32(r);
+        rec->transform.rotation = _ye_get_f32(r);
+        rec->transform.parent = _ye_get_i32(r);
+        if(rec->transform.parent < -1 || rec->transform.parent >= entity_count)
+            r->ok = false;
+    }
+
+    if(rec->signature & YE_SIG_RENDERER)
+        _ye_decode_renderer(r, rec);
+
+    if(rec->signature & YE_SIG_RIGIDBODY){
+        _ye_decode_rigidbody(r, rec);
+        if(!(rec->signature & YE_SIG_TRANSFORM))
+            r->ok = false; // rigidbodies always have a transform
+    }
+
+    if(rec->signature & YE_SIG_AUDIOSOURCE){
+        rec->audiosource.active = _ye_get_bool(r);
+        rec->audiosource.simulated = _ye_get_bool(r);
+        rec->audiosource.handle = _ye_get_str(r);
+        rec->audiosource.volume = _ye_get_f32(r);
+        rec->audiosource.range = _ye_get_rectf(r);
+        rec->audiosource.relative = _ye_get_bool(r);
+        rec->audiosource.play_on_awake = _ye_get_bool(r);
+        rec->audiosource.loops = _ye_get_i32(r);
+        if(r->ok && rec->audiosource.handle == NULL)
+            r->ok = false;
+    }
+
+    if(rec->signature & YE_SIG_CAMERA){
+        rec->camera.active = _ye_get_bool(r);
+        rec->camera.relative = _ye_get_bool(r);
+        rec->camera.z = _ye_get_i32(r);
+        rec->camera.view_field = _ye_get_rectf(r);
+        rec->camera.lock_aspect_ratio = _ye_get_bool(r);
+    }
+
+    if(rec->signature & YE_SIG_TAG){
+        rec->tag.count = _ye_get_i32(r);
+        if(rec->tag.count < 0 || rec->tag.count > YE_TAG_MAX_NUMBER){
+            r->ok = false;
+            return false;
+        }
+        for(int t = 0; t < rec->tag.count; t++)
+            rec->tag.names[t] = _ye_get_str(r);
+    }
+
+    if(rec->signature & YE_SIG_BUTTON){
+        rec->button.active = _ye_get_bool(r);
+        rec->button.relative = _ye_get_bool(r);
+        rec->button.rect = _ye_get_rectf(r);
+    }
+
+    rec->custom.count = _ye_get_i32(r);
+    if(rec->custom.count < 0 || rec->custom.count > YE_MAX_COMPONENT_TYPES - YE_COMPONENT_COUNT){
+        r->ok = false;
+        return false;
+    }
+    for(int c = 0; c < rec->custom.count && r->ok; c++){
+        rec->custom.names[c] = _ye_get_str(r);
+        rec->custom.sizes[c] = _ye_get_u32(r);
+        if(r->ok && (rec->custom.names[c] == NULL || rec->custom.sizes[c] > r->size - r->pos))
+            r->ok = false;
+        if(r->ok){
+            rec->custom.data[c] = r->data + r->pos;
+            r->pos += rec->custom.sizes[c];
+        }
+    }
+
+    return r->ok;
+}
+
+/*
+    ==========================================
+                    RESTORE
+    ==========================================
+*/
+
+static bool _ye_str_eq(const char *a, const char *b){
+    if(a == NULL || b == NULL)
+        return a == b;
+    return strcmp(a, b) == 0;
+}
+
+// can the entity's current renderer be patched into the snapshot one without reloading anything?
+static bool _ye_renderer_matches(struct ye_component_renderer *rend, struct _ye_snapshot_entity *rec){
+    if(rend == NULL || rend->type != rec->renderer.type)
+        return false;
+
+    switch(rend->type){
+        case YE_RENDERER_TYPE_IMAGE:
+            // preloaded images have no handle to compare, keep whatever texture they have
+            return rec->renderer.handle == NULL || _ye_str_eq(rend->renderer_impl.image->src, rec->renderer.handle);
+        case YE_RENDERER_TYPE_TEXT: {
+            struct ye_component_renderer_text *text = rend->renderer_impl.text;
+            return _ye_str_eq(text->text, rec->renderer.handle) &&
+                _ye_str_eq(text->font_name, rec->renderer.font_name) &&
+                text->font_size == rec->renderer.font_size &&
+                _ye_str_eq(text->color_name, rec->renderer.color_name) &&
+                text->wrap_width == rec->renderer.wrap_width;
+        }
+        case YE_RENDERER_TYPE_TEXT_OUTLINED: {
+            struct ye_component_renderer_text_outlined *text = rend->renderer_impl.text_outlined;
+            return _ye_str_eq(text->text, rec->renderer.handle) &&
+                _ye_str_eq(text->font_name, rec->renderer.font_name) &&
+                text->font_size == rec->renderer.font_size &&
+                _ye_str_eq(text->color_name, rec->renderer.color_name) &&
+                text->wrap_width == rec->renderer.wrap_width &&
+                _ye_str_eq(text->outline_color_name, rec->renderer.outline_color_name) &&
+                text->outline_size == rec->renderer.outline_size;
+        }
+        case YE_RENDERER_TYPE_ANIMATION:
+            return _ye_str_eq(rend->renderer_impl.animation->meta_file, rec->renderer.handle);
+        case YE_RENDERER_TYPE_TILEMAP_TILE:
+            return _ye_str_eq(rend->renderer_impl.tile->handle, rec->renderer.handle);
+        case YE_RENDERER_TYPE_TILEMAP_LAYER: {
+            struct ye_component_renderer_tilemap_layer *layer = rend->renderer_impl.tilemap_layer;
+            return _ye_str_eq(layer->tileset, rec->renderer.handle) &&
+                layer->tile_w == rec->renderer.tile_src.w &&
+                layer->tile_h == rec->renderer.tile_src.h &&
+                layer->cols == rec->renderer.layer_cols &&
+                layer->rows == rec->renderer.layer_rows;
+        }
+        default:
+            return false;
+    }
+}
+
+// rebuild a renderer from its handles, returns false if it can't be
+static bool _ye_restore_renderer_create(struct ye_entity *e, struct _ye_snapshot_entity *rec){
+    int z = rec->renderer.z;
+
+    switch(rec->renderer.type){
+        case YE_RENDERER_TYPE_IMAGE:
+            if(rec->renderer.handle == NULL){
+                ye_logf(warning, "Snapshot: can't rebuild preloaded image renderer on \"%s\", it has no handle.\n", e->name);
+                return false;
+            }
+            ye_add_image_renderer_component(e, z, rec->renderer.handle);
+            break;
+        case YE_RENDERER_TYPE_TEXT:
+            ye_add_text_renderer_component(e, z, rec->renderer.handle, rec->renderer.font_name, rec->renderer.font_size, rec->renderer.color_name, rec->renderer.wrap_width);
+            break;
+        case YE_RENDERER_TYPE_TEXT_OUTLINED:
+            ye_add_text_outlined_renderer_component(e, z, rec->renderer.handle, rec->renderer.font_name, rec->renderer.font_size, rec->renderer.color_name, rec->renderer.outline_color_name, rec->renderer.outline_size, rec->renderer.wrap_width);
+            break;
+        case YE_RENDERER_TYPE_ANIMATION: {
+            /*
+                Share the cached clip (per frame delays live there) like any other
+                animation of this meta file. Everything else the meta file would
+                tell us is already in the snapshot, so if it can't be loaded
+                anymore we still rebuild from that, with uniform frame delays.
+            */
+            struct ye_component_renderer_animation *anim = ye_alloc_renderer_impl(YE_RENDERER_TYPE_ANIMATION);
+            anim->clip = ye_animation_clip_acquire(rec->renderer.handle);
+            anim->meta_file = ye_intern(rec->renderer.handle);
+            anim->animation_handle = ye_intern(rec->renderer.animation_handle);
+            anim->frame_count = rec->renderer.frame_count;
+            anim->frame_width = rec->renderer.frame_width;
+            anim->frame_height = rec->renderer.frame_height;
+            ye_add_renderer_component(e, YE_RENDERER_TYPE_ANIMATION, z, anim);
+            struct ye_image_region region = ye_image_atlased(anim->animation_handle);
+            e->renderer->texture = region.texture;
+            e->renderer->_uv = region.uv;
+            break;
+        }
+        case YE_RENDERER_TYPE_TILEMAP_TILE:
+            ye_add_tilemap_renderer_component(e, z, rec->renderer.handle, rec->renderer.tile_src);
+            break;
+        case YE_RENDERER_TYPE_TILEMAP_LAYER:
+            ye_add_tilemap_layer_renderer_component(e, z, rec->renderer.handle, rec->renderer.tile_src.w, rec->renderer.tile_src.h, rec->renderer.layer_cols, rec->renderer.layer_rows);
+            break;
+        default:
+            return false;
+    }
+
+    return e->renderer != NULL;
+}
+
+static void _ye_restore_renderer(struct ye_entity *e, struct _ye_snapshot_entity *rec){
+    if(!_ye_renderer_matches(e->renderer, rec)){
+        if(e->renderer)
+            ye_remove_renderer_component(e);
+        if(!_ye_restore_renderer_create(e, rec))
+            return;
+    }
+
+    struct ye_component_renderer *rend = e->renderer;
+
+    ye_set_renderer_z(e, rec->renderer.z);
+
+    rend->active = rec->renderer.active;
+    rend->alpha = rec->renderer.alpha;
+    rend->relative = rec->renderer.relative;
+    rend->rect = rec->renderer.rect;
+    rend->alignment = rec->renderer.alignment;
+    rend->preserve_original_size = rec->renderer.preserve_original_size;
+    rend->center = rec->renderer.center;
+    rend->rotation = rec->renderer.rotation;
+    rend->flipped_x = rec->renderer.flipped_x;
+    rend->flipped_y = rec->renderer.flipped_y;
+    rend->lock_aspect_ratio = rec->renderer.lock_aspect_ratio;
+    ye_renderer_bounds_changed(e);
+
+    if(rend->type == YE_RENDERER_TYPE_ANIMATION){
+        struct ye_component_renderer_animation *anim = rend->renderer_impl.animation;
+        anim->frame_delay = rec->renderer.frame_delay;
+        anim->loops = rec->renderer.loops;
+        anim->paused = rec->renderer.paused;
+        anim->current_frame_index = rec->renderer.current_frame_index;
+        if((size_t)anim->current_frame_index >= anim->frame_count)
+            anim->current_frame_index = 0;
+        anim->start_time = SDL_GetTicks() - rec->renderer.elapsed;
+    }
+    else if(rend->type == YE_RENDERER_TYPE_TILEMAP_TILE){
+        rend->renderer_impl.tile->src = rec->renderer.tile_src;
+    }
+    else if(rend->type == YE_RENDERER_TYPE_TILEMAP_LAYER){
+        // only tiles that differ mark their chunk for a re-bake
+        int cols = rec->renderer.layer_cols;
+        for(int i = 0; i < cols * rec->renderer.layer_rows; i++){
+            int32_t tile;
+            memcpy(&tile, rec->renderer.layer_tiles + (size_t)i * sizeof(int32_t), sizeof(int32_t));
+            ye_tilemap_layer_set_tile(e, i % cols, i / cols, tile);
+        }
+    }
+}
+
+static void _ye_restore_rigidbody(struct ye_entity *e, struct _ye_snapshot_entity *rec){
+    struct p2d_object *want = &rec->rigidbody.object;
+    struct ye_component_rigidbody *rb = e->rigidbody;
+
+    // the body shape and material has to match for us to patch it in place
+    bool matches = rb != NULL &&
+        rb->transform_offset_x == rec->rigidbody.transform_offset_x &&
+        rb->transform_offset_y == rec->rigidbody.transform_offset_y &&
+        rb->p2d_object.type == want->type &&
+        rb->p2d_object.is_static == want->is_static &&
+        rb->p2d_object.is_trigger == want->is_trigger &&
+        rb->p2d_object.mask == want->mask &&
+        rb->p2d_object.density == want->density &&
+        rb->p2d_object.restitution == want->restitution;
+    if(matches && want->type == P2D_OBJECT_RECTANGLE)
+        matches = rb->p2d_object.rectangle.width == want->rectangle.width && rb->p2d_object.rectangle.height == want->rectangle.height;
+    else if(matches)
+        matches = rb->p2d_object.circle.radius == want->circle.radius;
+
+    if(!matches){
+        if(rb)
+            ye_remove_rigidbody_component(e);
+
+        ye_add_rigidbody_component(e, rec->rigidbody.transform_offset_x, rec->rigidbody.transform_offset_y, *want);
+        rb = e->rigidbody;
+        if(rb == NULL)
+            return;
+    }
+
+    rb->active = rec->rigidbody.active;
+    rb->p2d_object.x = want->x;
+    rb->p2d_object.y = want->y;
+    rb->p2d_object.rotation = want->rotation;
+    rb->p2d_object.vx = want->vx;
+    rb->p2d_object.vy = want->vy;
+    rb->p2d_object.vr = want->vr;
+}
+
+static void _ye_restore_audiosource(struct ye_entity *e, struct _ye_snapshot_entity *rec){
+    if(e->audiosource == NULL || !_ye_str_eq(e->audiosource->handle, rec->audiosource.handle)){
+        if(e->audiosource)
+            ye_remove_audiosource_component(e);
+
+        ye_add_audiosource_component(e, rec->audiosource.handle, rec->audiosource.volume, rec->audiosource.play_on_awake, rec->audiosource.loops, rec->audiosource.simulated, rec->audiosource.range);
+        if(e->audiosource == NULL)
+            return;
+    }
+
+    struct ye_component_audiosource *as = e->audiosource;
+    as->active = rec->audiosource.active;
+    as->simulated = rec->audiosource.simulated;
+    as->volume = rec->audiosource.volume;
+    as->range = rec->audiosource.range;
+    as->relative = rec->audiosource.relative;
+    as->play_on_awake = rec->audiosource.play_on_awake;
+    as->loops = rec->audiosource.loops;
+}
+
+// drop components the snapshot doesn't have (dependents first)
+static void _ye_restore_remove_missing(struct ye_entity *e, uint64_t signature){
+    if(e->button && !(signature & YE_SIG_BUTTON))           ye_remove_button_component(e);
+    if(e->tag && !(signature & YE_SIG_TAG))                 ye_remove_tag_component(e);
+    if(e->camera && !(signature & YE_SIG_CAMERA))           ye_remove_camera_component(e);
+    if(e->audiosource && !(signature & YE_SIG_AUDIOSOURCE)) ye_remove_audiosource_component(e);
+    if(e->rigidbody && !(signature & YE_SIG_RIGIDBODY))     ye_remove_rigidbody_component(e);
+    if(e->renderer && !(signature & YE_SIG_RENDERER))       ye_remove_renderer_component(e);
+    if(e->transform && !(signature & YE_SIG_TRANSFORM))     ye_remove_transform_component(e);
+}
+
+/*
+    Custom components are plain bytes to us, so anything they point to is
+    restored as the pointer value (same as the component's owner left it).
+    Types are matched by name, the snapshot's type ids mean nothing here.
+*/
+static void _ye_restore_custom(struct ye_entity *e, struct _ye_snapshot_entity *rec){
+    int types[YE_MAX_COMPONENT_TYPES - YE_COMPONENT_COUNT];
+    uint64_t wanted = 0;
+
+    for(int c = 0; c < rec->custom.count; c++){
+        types[c] = ye_get_component_type(rec->custom.names[c]);
+        if(types[c] < 0){
+            ye_logf(warning, "Snapshot has a \"%s\" component on \"%s\" but that type is not registered, skipping it.\n", rec->custom.names[c], e->name);
+            continue;
+        }
+        if(ye_get_component_stride(types[c]) != rec->custom.sizes[c]){
+            ye_logf(warning, "Snapshot \"%s\" component on \"%s\" is %u bytes, the registered type is %zu, skipping it.\n", rec->custom.names[c], e->name, rec->custom.sizes[c], ye_get_component_stride(types[c]));
+            types[c] = -1;
+            continue;
+        }
+        wanted |= YE_COMPONENT_BIT(types[c]);
+    }
+
+    // drop what the snapshot doesn't have
+    for(int type = YE_COMPONENT_COUNT; type < YE_MAX_COMPONENT_TYPES; type++){
+        if((e->signature & YE_COMPONENT_BIT(type)) && !(wanted & YE_COMPONENT_BIT(type)))
+            ye_remove_component(e, type);
+    }
+
+    for(int c = 0; c < rec->custom.count; c++){
+        if(types[c] < 0)
+            continue;
+
+        void *component = ye_get_component(e, types[c]);
+        if(component == NULL)
+            component = ye_add_component(e, types[c]);
+        if(component != NULL)
+            memcpy(component, rec->custom.data[c], rec->custom.sizes[c]);
+    }
+}
+
+static void _ye_restore_entity(struct ye_entity *e, struct _ye_snapshot_entity *rec){
+    if(!_ye_str_eq(e->name, rec->name))
+        ye_rename_entity(e, rec->name ? rec->name : "entity");
+
+    e->active = rec->active;
+
+    _ye_restore_remove_missing(e, rec->signature);
+
+    if(rec->signature & YE_SIG_TRANSFORM){
+        if(e->transform == NULL)
+            ye_add_transform_component(e, 0, 0);
+        e->transform->x = rec->transform.x;
+        e->transform->y = rec->transform.y;
+        e->transform->rotation = rec->transform.rotation;
+    }
+
+    if(rec->signature & YE_SIG_RENDERER)
+        _ye_restore_renderer(e, rec);
+
+    // hierarchy is applied after every entity exists, rigidbodies need to be roots by then
+    if((rec->signature & YE_SIG_RIGIDBODY) && e->transform)
+        ye_set_transform_parent(e, NULL);
+
+    if(rec->signature & YE_SIG_RIGIDBODY)
+        _ye_restore_rigidbody(e, rec);
+
+    if(rec->signature & YE_SIG_AUDIOSOURCE)
+        _ye_restore_audiosource(e, rec);
+
+    if(rec->signature & YE_SIG_CAMERA){
+        if(e->camera == NULL)
+            ye_add_camera_component(e, rec->camera.z, rec->camera.view_field);
+        e->camera->active = rec->camera.active;
+        e->camera->relative = rec->camera.relative;
+        e->camera->z = rec->camera.z;
+        e->camera->view_field = rec->camera.view_field;
+        e->camera->lock_aspect_ratio = rec->camera.lock_aspect_ratio;
+    }
+
+    if(rec->signature & YE_SIG_TAG){
+        // tags are interned ints, cheaper to rebuild than to diff
+        if(e->tag)
+            ye_remove_tag_component(e);
+        ye_add_tag_component(e);
+        for(int t = 0; t < rec->tag.count; t++)
+            ye_add_tag(e, rec->tag.names[t]);
+    }
+
+    if(rec->signature & YE_SIG_BUTTON){
+        if(e->button == NULL)
+            ye_add_button_component(e, rec->button.rect);
+        e->button->active = rec->button.active;
+        e->button->relative = rec->button.relative;
+        e->button->rect = rec->button.rect;
+    }
+
+    _ye_restore_custom(e, rec);
+}
+
+static int _ye_compare_entity_ptr(const void *a, const void *b){
+    uintptr_t pa = (uintptr_t)*(struct ye_entity * const *)a;
+    uintptr_t pb = (uintptr_t)*(struct ye_entity * const *)b;
+    return (pa > pb) - (pa < pb);
+}
+
+bool ye_snapshot_restore(const struct ye_snapshot *snapshot){
+    if(snapshot == NULL || snapshot->data == NULL){
+        ye_logf(error, "Could not restore snapshot, snapshot is empty.\n");
+        return false;
+    }
+
+    struct _ye_snapshot_reader r = { .data = snapshot->data, .size = snapshot->size, .pos = 0, .ok = true };
+
+    uint32_t magic = _ye_get_u32(&r);
+    uint32_t version = _ye_get_u32(&r);
+    int32_t count = _ye_get_i32(&r);
+    int32_t target_camera = _ye_get_i32(&r);
+
+    if(!r.ok || magic != YE_SNAPSHOT_MAGIC || version != YE_SNAPSHOT_VERSION || count < 0 || target_camera < -1 || target_camera >= count){
+        ye_logf(error, "Could not restore snapshot, bad header (version %u, expected %u).\n", version, YE_SNAPSHOT_VERSION);
+        return false;
+    }
+
+    struct _ye_snapshot_entity *records = calloc(count > 0 ? count : 1, sizeof(struct _ye_snapshot_entity));
+    struct ye_entity **kept = malloc(sizeof(struct ye_entity *) * (count > 0 ? count : 1));
+    if(records == NULL || kept == NULL){
+        ye_logf(error, "Could not restore snapshot, failed to allocate %d records.\n", count);
+        free(records);
+        free(kept);
+        return false;
+    }
+
+    for(int i = 0; i < count; i++){
+        records[i].handle.id = _ye_get_i32(&r);
+        records[i].handle.generation = _ye_get_u32(&r);
+    }
+    for(int i = 0; i < count && r.ok; i++)
+        _ye_decode_entity(&r, &records[i], count);
+
+    if(!r.ok){
+        ye_logf(error, "Could not restore snapshot, data is truncated or corrupt.\n");
+        free(records);
+        free(kept);
+        return false;
+    }
+
+    /*
+        Figure out which captured entities are still alive, and destroy
+        everything else first, so nothing we restore gets caught up in it
+    */
+    int kept_count = 0;
+    for(int i = 0; i < count; i++){
+        records[i].entity = ye_get_entity_from_handle(records[i].handle);
+        if(records[i].entity)
+            kept[kept_count++] = records[i].entity;
+    }
+    qsort(kept, kept_count, sizeof(struct ye_entity *), _ye_compare_entity_ptr);
+
+    struct ye_entity_set *entities = ye_get_entity_set();
+    for(int i = entities->count - 1; i >= 0; i--){
+        struct ye_entity *e = entities->entities[i];
+        if(bsearch(&e, kept, kept_count, sizeof(struct ye_entity *), _ye_compare_entity_ptr) == NULL){
+            if(YE_STATE.engine.target_camera == e)
+                YE_STATE.engine.target_camera = NULL;
+            if(YE_STATE.editor.scene_default_camera == e)
+                YE_STATE.editor.scene_default_camera = NULL;
+
+            // swap-removes from the set, only ever pulls back something we already looked at
+            ye_destroy_entity(e);
+        }
+    }
+
+    // rebuild or patch every captured entity
+    for(int i = 0; i < count; i++){
+        if(records[i].entity == NULL)
+            records[i].entity = ye_create_entity_named(records[i].name ? records[i].name : "entity");
+        _ye_restore_entity(records[i].entity, &records[i]);
+    }
+
+    // hierarchy, unparent everything first so reparenting can't see a stale cycle
+    for(int i = 0; i < count; i++){
+        if(records[i].entity->transform)
+            ye_set_transform_parent(records[i].entity, NULL);
+    }
+    for(int i = 0; i < count; i++){
+        struct ye_entity *e = records[i].entity;
+        if(e->transform == NULL || records[i].transform.parent < 0)
+            continue;
+
+        ye_set_transform_parent(e, records[records[i].transform.parent].entity);
+
+        // removing a parent converts children to world space, put the captured locals back
+        e->transform->x = records[i].transform.x;
+        e->transform->y = records[i].transform.y;
+        e->transform->rotation = records[i].transform.rotation;
+    }
+
+    if(target_camera >= 0)
+        ye_set_camera(records[target_camera].entity);
+
+    free(records);
+    free(kept);
+    return true;
+}
+
+/*
+    ==========================================
+                    FILES
+    ==========================================
+*/
+
+void ye_snapshot_free(struct ye_snapshot *snapshot){
+    if(snapshot == NULL)
+        return;
+
+    free(snapshot->data);
+    snapshot->data = NULL;
+    snapshot->size = 0;
+    snapshot->capacity = 0;
+}
+
+bool ye_snapshot_write(const struct ye_snapshot *snapshot, const char *path){
+    if(snapshot == NULL || snapshot->data == NULL || path == NULL){
+        ye_logf(error, "Could not write snapshot, nothing to write.\n");
+        return false;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if(file == NULL){
+        ye_logf(error, "Could not open \"%s\" to write snapshot.\n", path);
+        return false;
+    }
+
+    bool ok = fwrite(snapshot->data, 1, snapshot->size, file) == snapshot->size;
+    fclose(file);
+
+    if(!ok)
+        ye_logf(error, "Failed to write snapshot to \"%s\".\n", path);
+    return ok;
+}
+
+bool ye_snapshot_read(struct ye_snapshot *snapshot, const char *path){
+    if(snapshot == NULL || path == NULL){
+        ye_logf(error, "Could not read snapshot, snapshot or path is NULL.\n");
+        return false;
+    }
+
+    FILE *file = fopen(path, "rb");
+    if(file == NULL){
+        ye_logf(error, "Could not open snapshot \"%s\".\n", path);
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if(length <= 0){
+        ye_logf(error, "Snapshot \"%s\" is empty.\n", path);
+        fclose(file);
+        return false;
+    }
+
+    if((size_t)length > snapshot->capacity){
+        unsigned char *data = realloc(snapshot->data, length);
+        if(data == NULL){
+            ye_logf(error, "Failed to allocate %ld bytes for snapshot \"%s\".\n", length, path);
+            fclose(file);
+            return false;
+        }
+        snapshot->data = data;
+        snapshot->capacity = length;
+    }
+
+    snapshot->size = fread(snapshot->data, 1, length, file);
+    fclose(file);
+
+    if(snapshot->size != (size_t)length){
+        ye_logf(error, "Failed to read snapshot \"%s\".\n", path);
+        snapshot->size = 0;
+        return false;
+    }
+    return true;
+}
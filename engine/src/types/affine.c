@@ -0,0 +1,123 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <yoyoengine/types/affine.h>
+
+/*
+    Pick a kernel based on what the compiler targets, both SSE (x86_64) and
+    NEON (arm64) are part of the baseline so no extra build flags are needed.
+*/
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define YE_AFFINE_SSE
+    #include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define YE_AFFINE_NEON
+    #include <arm_neon.h>
+#endif
+
+struct ye_affine ye_affine_identity(void){
+    return (struct ye_affine){1, 0, 0, 1, 0, 0};
+}
+
+struct ye_affine ye_affine_from_mat3(mat3_t m){
+    /*
+        Read the transform back by where it sends the origin and the two
+        unit axes, that way we don't depend on how Lilith lays out mat3_t.
+    */
+    vec2_t o = lla_mat3_mult_vec2(m, (vec2_t){.data = {0, 0}});
+    vec2_t x = lla_mat3_mult_vec2(m, (vec2_t){.data = {1, 0}});
+    vec2_t y = lla_mat3_mult_vec2(m, (vec2_t){.data = {0, 1}});
+
+    return (struct ye_affine){
+        x.data[0] - o.data[0], x.data[1] - o.data[1],
+        y.data[0] - o.data[0], y.data[1] - o.data[1],
+        o.data[0], o.data[1]
+    };
+}
+
+struct ye_affine ye_affine_mul(struct ye_affine l, struct ye_affine r){
+    return (struct ye_affine){
+        l.a * r.a + l.c * r.b,
+        l.b * r.a + l.d * r.b,
+        l.a * r.c + l.c * r.d,
+        l.b * r.c + l.d * r.d,
+        l.a * r.tx + l.c * r.ty + l.tx,
+        l.b * r.tx + l.d * r.ty + l.ty
+    };
+}
+
+void ye_affine_apply(const struct ye_affine *m, float *x, float *y){
+    float px = *x;
+    float py = *y;
+    *x = m->a * px + m->c * py + m->tx;
+    *y = m->b * px + m->d * py + m->ty;
+}
+
+void ye_affine_transform_verts(const struct ye_affine *m, SDL_Vertex *verts, int count){
+    int i = 0;
+
+    /*
+        Four verticies at a time: gather their x's and y's into lanes (SoA),
+        transform all four at once, scatter back. SDL_Vertex interleaves
+        position with color and uv, so the gather is unavoidable.
+    */
+#if defined(YE_AFFINE_SSE)
+    const __m128 a = _mm_set1_ps(m->a);
+    const __m128 b = _mm_set1_ps(m->b);
+    const __m128 c = _mm_set1_ps(m->c);
+    const __m128 d = _mm_set1_ps(m->d);
+    const __m128 tx = _mm_set1_ps(m->tx);
+    const __m128 ty = _mm_set1_ps(m->ty);
+
+    for(; i + 4 <= count; i += 4){
+        SDL_Vertex *v = &verts[i];
+        __m128 x = _mm_setr_ps(v[0].position.x, v[1].position.x, v[2].position.x, v[3].position.x);
+        __m128 y = _mm_setr_ps(v[0].position.y, v[1].position.y, v[2].position.y, v[3].position.y);
+
+        __m128 nx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(c, y)), tx);
+        __m128 ny = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b, x), _mm_mul_ps(d, y)), ty);
+
+        float out_x[4], out_y[4];
+        _mm_storeu_ps(out_x, nx);
+        _mm_storeu_ps(out_y, ny);
+        for(int k = 0; k < 4; k++){
+            v[k].position.x = out_x[k];
+            v[k].position.y = out_y[k];
+        }
+    }
+#elif defined(YE_AFFINE_NEON)
+    const float32x4_t tx = vdupq_n_f32(m->tx);
+    const float32x4_t ty = vdupq_n_f32(m->ty);
+
+    for(; i + 4 <= count; i += 4){
+        SDL_Vertex *v = &verts[i];
+        float in_x[4] = {v[0].position.x, v[1].position.x, v[2].position.x, v[3].position.x};
+        float in_y[4] = {v[0].position.y, v[1].position.y, v[2].position.y, v[3].position.y};
+        float32x4_t x = vld1q_f32(in_x);
+        float32x4_t y = vld1q_f32(in_y);
+
+        float32x4_t nx = vmlaq_n_f32(vmlaq_n_f32(tx, x, m->a), y, m->c);
+        float32x4_t ny = vmlaq_n_f32(vmlaq_n_f32(ty, x, m->b), y, m->d);
+
+        float out_x[4], out_y[4];
+        vst1q_f32(out_x, nx);
+        vst1q_f32(out_y, ny);
+        for(int k = 0; k < 4; k++){
+            v[k].position.x = out_x[k];
+            v[k].position.y = out_y[k];
+        }
+    }
+#endif
+
+    // scalar fallback, and whatever is left over
+    for(; i < count; i++){
+        float x = verts[i].position.x;
+        float y = verts[i].position.y;
+        verts[i].position.x = m->a * x + m->c * y + m->tx;
+        verts[i].position.y = m->b * x + m->d * y + m->ty;
+    }
+}
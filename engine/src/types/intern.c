@@ -0,0 +1,106 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+#include <uthash/uthash.h>
+
+#include <yoyoengine/logging.h>
+#include <yoyoengine/types/intern.h>
+
+/*
+    Each atom lives inline at the end of its node, so getting from an atom
+    back to its node (to release it) is just pointer math.
+*/
+struct ye_intern_node {
+    int refcount;
+    size_t length;
+    UT_hash_handle hh;
+    char str[];
+};
+
+static struct ye_intern_node *intern_table = NULL;
+static size_t intern_bytes = 0;
+
+static struct ye_intern_node * _ye_intern_node(const char *atom){
+    return (struct ye_intern_node *)(atom - offsetof(struct ye_intern_node, str));
+}
+
+const char * ye_intern(const char *str){
+    if(str == NULL)
+        return NULL;
+
+    size_t length = strlen(str);
+
+    struct ye_intern_node *node = NULL;
+    HASH_FIND(hh, intern_table, str, length, node);
+    if(node == NULL){
+        node = malloc(sizeof(struct ye_intern_node) + length + 1);
+        if(node == NULL){
+            ye_logf(error, "Failed to intern string \"%s\".\n", str);
+            return NULL;
+        }
+        node->refcount = 0;
+        node->length = length;
+        memcpy(node->str, str, length + 1);
+        HASH_ADD_KEYPTR(hh, intern_table, node->str, length, node);
+        intern_bytes += length + 1;
+    }
+
+    node->refcount++;
+    return node->str;
+}
+
+const char * ye_intern_retain(const char *atom){
+    if(atom != NULL)
+        _ye_intern_node(atom)->refcount++;
+    return atom;
+}
+
+void ye_intern_release(const char *atom){
+    if(atom == NULL)
+        return;
+
+    struct ye_intern_node *node = _ye_intern_node(atom);
+    if(--node->refcount > 0)
+        return;
+
+    HASH_DEL(intern_table, node);
+    intern_bytes -= node->length + 1;
+    free(node);
+}
+
+const char * ye_intern_find(const char *str){
+    if(str == NULL)
+        return NULL;
+
+    struct ye_intern_node *node = NULL;
+    HASH_FIND(hh, intern_table, str, strlen(str), node);
+    return node ? node->str : NULL;
+}
+
+size_t ye_intern_stats(size_t *bytes){
+    if(bytes)
+        *bytes = intern_bytes;
+    return HASH_COUNT(intern_table);
+}
+
+void ye_shutdown_intern(void){
+    unsigned int leaked = HASH_COUNT(intern_table);
+    if(leaked > 0)
+        ye_logf(debug, "Freeing %u interned strings that were still referenced.\n", leaked);
+
+    struct ye_intern_node *node, *tmp;
+    HASH_ITER(hh, intern_table, node, tmp){
+        HASH_DEL(intern_table, node);
+        free(node);
+    }
+    intern_table = NULL;
+    intern_bytes = 0;
+}
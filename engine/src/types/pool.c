@@ -0,0 +1,137 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/yoyoengine/yoyoengine)
+    Copyright (C) 2023-2026  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <string.h>
+#include <stdlib.h>
+
+#include <yoyoengine/logging.h>
+#include <yoyoengine/types/pool.h>
+
+/*
+    Every slab starts with this header, followed by slab_capacity objects.
+    Free objects reuse their own first bytes as the free-list link.
+*/
+struct ye_pool_slab {
+    struct ye_pool_slab *next;
+    // keep the objects that follow aligned for anything
+    union { void *p; double d; long long l; } _align[];
+};
+
+// pools that currently own memory (registered on their first slab)
+static struct ye_pool *pools_head = NULL;
+
+static bool _ye_pool_grow(struct ye_pool *pool) {
+    if(pool->element_size < sizeof(void *))
+        pool->element_size = sizeof(void *);
+
+    // round up so every object stays pointer aligned
+    size_t align = sizeof(void *) > sizeof(double) ? sizeof(void *) : sizeof(double);
+    pool->element_size = (pool->element_size + align - 1) & ~(align - 1);
+
+    if(pool->slab_capacity == 0)
+        pool->slab_capacity = 64;
+
+    struct ye_pool_slab *slab = malloc(sizeof(struct ye_pool_slab) + pool->element_size * pool->slab_capacity);
+    if(!slab) {
+        ye_logf(YE_LL_ERROR, "ye_pool \"%s\": failed to allocate slab of %zu objects!\n", pool->name, pool->slab_capacity);
+        return false;
+    }
+
+    slab->next = pool->_slabs;
+    pool->_slabs = slab;
+
+    // thread the new objects onto the free list (back to front so we hand them out in order)
+    char *base = (char *)slab->_align;
+    for(size_t i = pool->slab_capacity; i > 0; i--) {
+        void **obj = (void **)(base + (i - 1) * pool->element_size);
+        *obj = pool->_free_list;
+        pool->_free_list = obj;
+    }
+
+    pool->capacity += pool->slab_capacity;
+
+    if(!pool->_registered) {
+        pool->_next = pools_head;
+        pools_head = pool;
+        pool->_registered = true;
+    }
+
+    return true;
+}
+
+void * ye_pool_alloc(struct ye_pool *pool) {
+    if(!pool) {
+        ye_logf(YE_LL_ERROR, "ye_pool_alloc: recieved NULL pool!\n");
+        return NULL;
+    }
+
+    if(!pool->_free_list && !_ye_pool_grow(pool))
+        return NULL;
+
+    void **obj = pool->_free_list;
+    pool->_free_list = *obj;
+
+    pool->in_use++;
+    if(pool->in_use > pool->peak)
+        pool->peak = pool->in_use;
+
+    memset(obj, 0, pool->element_size);
+    return obj;
+}
+
+void ye_pool_free(struct ye_pool *pool, void *ptr) {
+    if(!pool || !ptr)
+        return;
+
+    void **obj = ptr;
+    *obj = pool->_free_list;
+    pool->_free_list = obj;
+
+    pool->in_use--;
+}
+
+void ye_pool_destroy(struct ye_pool *pool) {
+    if(!pool) {
+        ye_logf(YE_LL_WARNING, "ye_pool_destroy: recieved NULL pool!\n");
+        return;
+    }
+
+    if(pool->in_use > 0)
+        ye_logf(YE_LL_WARNING, "ye_pool \"%s\": destroyed with %zu objects still in use.\n", pool->name, pool->in_use);
+
+    struct ye_pool_slab *slab = pool->_slabs;
+    while(slab) {
+        struct ye_pool_slab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    pool->_slabs = NULL;
+    pool->_free_list = NULL;
+    pool->in_use = 0;
+    pool->capacity = 0;
+
+    // unlink from the global list
+    if(pool->_registered) {
+        struct ye_pool **itr = &pools_head;
+        while(*itr && *itr != pool)
+            itr = &(*itr)->_next;
+        if(*itr)
+            *itr = pool->_next;
+        pool->_next = NULL;
+        pool->_registered = false;
+    }
+}
+
+struct ye_pool * ye_get_pools(void) {
+    return pools_head;
+}
+
+void ye_shutdown_pools(void) {
+    while(pools_head)
+        ye_pool_destroy(pools_head);
+}
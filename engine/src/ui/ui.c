@@ -27,10 +27,13 @@
 #include <yoyoengine/yep.h>
 #include <yoyoengine/engine.h>
 #include <yoyoengine/logging.h>
+#include <yoyoengine/glyph_atlas.h>
 #include <yoyoengine/ecs/camera.h>
 #include <yoyoengine/ecs/transform.h>
+#include <yoyoengine/ecs/system.h>
 #include <yoyoengine/cache.h>
 #include <yoyoengine/audio.h>
+#include <yoyoengine/types/pool.h>
 
 #define MAX_UI_COMPONENTS 30
 #define MAX_KEY_LENGTH 100
@@ -146,6 +149,7 @@ void ui_paint_debug_overlay(struct nk_context *ctx){
     char fps_str[100];
     char render_call_count_str[100];
     char vertex_count_str[100];
+    char culling_str[100];
     char event_count_str[100];
     char input_time_str[100];
     char physics_time_str[100];
@@ -161,9 +165,11 @@ void ui_paint_debug_overlay(struct nk_context *ctx){
     char cache_colors_str[100];
     char audio_channels_str[100];
     char mixer_cache_str[100];
+    char pool_str[100];
     sprintf(fps_str, "fps: %d", YE_STATE.runtime.fps);
     sprintf(render_call_count_str, "render calls: %d", YE_STATE.runtime.render_v2.num_render_calls);
     sprintf(vertex_count_str, "vertex count: %d", YE_STATE.runtime.render_v2.num_verticies);
+    sprintf(culling_str, "culling: %d visited, %d culled", YE_STATE.runtime.render_v2.num_visited, YE_STATE.runtime.render_v2.num_culled);
     sprintf(event_count_str, "event count: %d", ye_get_num_events());
     sprintf(input_time_str, "input time: %dms", YE_STATE.runtime.input_time);
     sprintf(physics_time_str, "physics time: %dms", YE_STATE.runtime.physics_time);
@@ -174,12 +180,19 @@ void ui_paint_debug_overlay(struct nk_context *ctx){
     sprintf(entity_count_str, "entity count: %d", YE_STATE.runtime.entity_count);
     sprintf(audio_chunk_count_str, "audio chunk count: %d", YE_STATE.runtime.audio_chunk_count);
     sprintf(log_line_count_str, "log line count: %d", YE_STATE.runtime.log_line_count);
-    sprintf(cache_textures_str, "cached textures: %d", ye_get_cache_texture_count());
-    sprintf(cache_fonts_str, "cached fonts: %d", ye_get_cache_font_count());
-    sprintf(cache_colors_str, "cached colors: %d", ye_get_cache_color_count());
+    sprintf(cache_textures_str, "cached textures: %d (%d atlas pages)", ye_get_cache_texture_count(), ye_get_cache_atlas_page_count());
+    sprintf(cache_fonts_str, "cached fonts: %d (%d glyph pages)", ye_get_cache_font_count(), ye_get_glyph_atlas_page_count());
+    sprintf(cache_colors_str, "cached colors: %d, text: %d", ye_get_cache_color_count(), ye_get_cache_text_count());
     sprintf(audio_channels_str, "audio channels: %d/%d", ye_get_audio_busy_channels(), ye_get_audio_allocated_channels());
     sprintf(mixer_cache_str, "mixer cache: %d", ye_get_mixer_cache_count());
 
+    size_t pool_in_use = 0, pool_capacity = 0;
+    for(struct ye_pool *pool = ye_get_pools(); pool != NULL; pool = pool->_next){
+        pool_in_use += pool->in_use;
+        pool_capacity += pool->capacity;
+    }
+    sprintf(pool_str, "pooled objects: %zu/%zu", pool_in_use, pool_capacity);
+
     // update chart logs
 
     int ticks = SDL_GetTicks();
@@ -240,9 +253,23 @@ void ui_paint_debug_overlay(struct nk_context *ctx){
         nk_label(ctx, fps_str, NK_TEXT_LEFT);
         nk_label(ctx, render_call_count_str, NK_TEXT_LEFT);
         nk_label(ctx, vertex_count_str, NK_TEXT_LEFT);
+        nk_label(ctx, culling_str, NK_TEXT_LEFT);
         nk_label(ctx, event_count_str, NK_TEXT_LEFT);
         nk_label(ctx, input_time_str, NK_TEXT_LEFT);
         nk_label(ctx, physics_time_str, NK_TEXT_LEFT);
+
+        // per system timings from the scheduler (* = ran on a worker thread)
+        int system_count = 0;
+        struct ye_system **systems = ye_get_systems(&system_count);
+        for(int i = 0; i < system_count; i++){
+            if(!systems[i]->enabled)
+                continue;
+
+            char system_time_str[100];
+            snprintf(system_time_str, sizeof(system_time_str), "  %s%s: %.2fms", systems[i]->name, systems[i]->ran_on_worker ? "*" : "", systems[i]->time_ms);
+            nk_label(ctx, system_time_str, NK_TEXT_LEFT);
+        }
+
         nk_label(ctx, paint_time_str, NK_TEXT_LEFT);
         nk_label(ctx, frame_time_str, NK_TEXT_LEFT);
         nk_label(ctx, delta_time_str, NK_TEXT_LEFT);
@@ -255,6 +282,7 @@ void ui_paint_debug_overlay(struct nk_context *ctx){
         nk_label(ctx, cache_colors_str, NK_TEXT_LEFT);
         nk_label(ctx, audio_channels_str, NK_TEXT_LEFT);
         nk_label(ctx, mixer_cache_str, NK_TEXT_LEFT);
+        nk_label(ctx, pool_str, NK_TEXT_LEFT);
     }
     nk_end(ctx);
 }
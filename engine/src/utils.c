@@ -154,10 +154,18 @@ struct ye_rectf ye_get_position(struct ye_entity *entity, enum ye_component_type
 
     struct ye_rectf pos = {0,0,0,0};
 
+    // world space transform (accounts for parents)
+    struct ye_component_transform scratch;
+    const struct ye_component_transform *transform = ye_read_transform(entity, &scratch);
+
     switch(type){
         case YE_COMPONENT_TRANSFORM:
-            pos.x = entity->transform->x;
-            pos.y = entity->transform->y;
+            if(transform == NULL){
+                ye_logf(error,"Tried to get position of a null transform component on entity \"%s\". returning (0,0,0,0)\n",entity->name);
+                return pos;
+            }
+            pos.x = transform->world_x;
+            pos.y = transform->world_y;
             return pos;
         case YE_COMPONENT_RENDERER:
             if(entity->renderer != NULL){
@@ -167,9 +175,9 @@ struct ye_rectf ye_get_position(struct ye_entity *entity, enum ye_component_type
                 pos.h = entity->renderer->rect.h;
 
                 // if relative adjust its position
-                if(entity->renderer->relative && entity->transform != NULL){
-                    pos.x += entity->transform->x;
-                    pos.y += entity->transform->y;
+                if(entity->renderer->relative && transform != NULL){
+                    pos.x += transform->world_x;
+                    pos.y += transform->world_y;
                 }
 
                 return pos;
@@ -182,9 +190,9 @@ struct ye_rectf ye_get_position(struct ye_entity *entity, enum ye_component_type
                 pos = entity->camera->view_field;
 
                 // if relative adjust its position
-                if(entity->camera->relative && entity->transform != NULL){
-                    pos.x += entity->transform->x;
-                    pos.y += entity->transform->y;
+                if(entity->camera->relative && transform != NULL){
+                    pos.x += transform->world_x;
+                    pos.y += transform->world_y;
                 }
 
                 return pos;
@@ -199,9 +207,9 @@ struct ye_rectf ye_get_position(struct ye_entity *entity, enum ye_component_type
                 pos.h = entity->audiosource->range.h;
 
                 // if relative adjust its position
-                if(entity->audiosource->relative && entity->transform != NULL){
-                    pos.x += entity->transform->x;
-                    pos.y += entity->transform->y;
+                if(entity->audiosource->relative && transform != NULL){
+                    pos.x += transform->world_x;
+                    pos.y += transform->world_y;
                 }
 
                 return pos;
@@ -238,9 +246,9 @@ struct ye_rectf ye_get_position(struct ye_entity *entity, enum ye_component_type
                 pos.h = entity->button->rect.h;
 
                 // if relative adjust its position
-                if(entity->button->relative && entity->transform != NULL){
-                    pos.x += entity->transform->x;
-                    pos.y += entity->transform->y;
+                if(entity->button->relative && transform != NULL){
+                    pos.x += transform->world_x;
+                    pos.y += transform->world_y;
                 }
 
                 return pos;
@@ -262,36 +270,29 @@ mat3_t ye_get_offset_matrix(struct ye_entity *entity, enum ye_component_type typ
     mat3_t pos = lla_mat3_identity();
 
     /*
-        Rotation
-
-        note: i ended up factoring in the camera position here,
-        which might be completely fucked and overcompensating for something in renderer v2...
-
-        it works for now though. TODO: look into this
+        Start from the cached world matrix (rotation around the world position,
+        accounts for parents) and move onto that position, so the result maps
+        points relative to the entity into world space.
     */
-    if(entity->transform && entity->transform->rotation != 0){
-        vec2_t center = (vec2_t){.data={entity->transform->x, entity->transform->y}};
-        center.data[0] -= YE_STATE.engine.target_camera->transform->x;
-        center.data[1] -= YE_STATE.engine.target_camera->transform->y;
-        pos = lla_mat3_rotate_around(pos, center, entity->transform->rotation);
-    }
-    if(entity->renderer && entity->renderer->rotation != 0){
-        vec2_t center = (vec2_t){.data={(entity->renderer->rect.x+entity->renderer->rect.w)/2, (entity->renderer->rect.y+entity->renderer->rect.h)/2}};
-        center.data[0] -= YE_STATE.engine.target_camera->transform->x;
-        center.data[1] -= YE_STATE.engine.target_camera->transform->y;
-        pos = lla_mat3_rotate_around(pos, center, entity->renderer->rotation);
-    }   
-
-    // if there is a transform, offset the identity by the transform
-    if(entity->transform)
-        pos = lla_mat3_translate(pos, (vec2_t){.data={entity->transform->x, entity->transform->y}});
-    
+    struct ye_component_transform scratch;
+    const struct ye_component_transform *transform = ye_read_transform(entity, &scratch);
+    if(transform)
+        pos = lla_mat3_translate(transform->world_matrix, (vec2_t){.data={transform->world_x, transform->world_y}});
+
     // component specific transform offsets
     switch(type){
         case YE_COMPONENT_RENDERER:
             if(entity->renderer){
-                if(entity->renderer->relative)
-                    pos = lla_mat3_translate(pos, (vec2_t){.data={entity->renderer->rect.x, entity->renderer->rect.y}});
+                struct ye_rectf rect = entity->renderer->rect;
+                if(entity->renderer->relative){
+                    pos = lla_mat3_translate(pos, (vec2_t){.data={rect.x, rect.y}});
+                    rect.x = 0;
+                    rect.y = 0;
+                }
+
+                // the renderer's own rotation is around the middle of its rect
+                if(entity->renderer->rotation != 0)
+                    pos = lla_mat3_rotate_around(pos, (vec2_t){.data={rect.x + rect.w / 2, rect.y + rect.h / 2}}, entity->renderer->rotation);
             }
             break;
         case YE_COMPONENT_CAMERA:
@@ -599,9 +600,12 @@ struct ye_point_rectf ye_get_position2(struct ye_entity *entity, enum ye_compone
             return ret;
     }
 
+    // cached rotation around the world position of the transform
     mat3_t rot = lla_mat3_identity();
-    if(entity->transform) {
-        rot = lla_mat3_rotate_around(rot, (vec2_t){.data={entity->transform->x, entity->transform->y}}, entity->transform->rotation);
+    struct ye_component_transform scratch;
+    const struct ye_component_transform *transform = ye_read_transform(entity, &scratch);
+    if(transform) {
+        rot = transform->world_matrix;
     }
 
     for(int i = 0; i < 4; i++) {